@@ -0,0 +1,215 @@
+/*-------------------------------------------------------------------------
+ *
+ *   FILE
+ *	pqxx/arrow.hxx
+ *
+ *   DESCRIPTION
+ *      definition of the pqxx::arrow_batch class and related types.
+ *   Converts query results and COPY streams to Apache Arrow memory layout
+ *   DO NOT INCLUDE THIS FILE DIRECTLY; include pqxx/arrow instead.
+ *
+ * Copyright (c) 2016, Jeroen T. Vermeulen <jtv@xs4all.nl>
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this mistake,
+ * or contact the author.
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef PQXX_H_ARROW
+#define PQXX_H_ARROW
+
+#include "pqxx/compiler-public.hxx"
+#include "pqxx/compiler-internal-pre.hxx"
+
+#include <string>
+#include <vector>
+
+#include "pqxx/result"
+
+
+namespace pqxx
+{
+class tablereader;
+
+/// Apache Arrow types that PostgreSQL columns are exported as
+enum arrow_type
+{
+  arrow_boolean,	///< boolean
+  arrow_int16,		///< smallint
+  arrow_int32,		///< integer
+  arrow_int64,		///< bigint, oid
+  arrow_float32,	///< real
+  arrow_float64,	///< double precision
+  arrow_large_utf8	///< Anything else, in PostgreSQL's text format
+};
+
+/// Arrow type that a column of the given PostgreSQL type is exported as
+PQXX_LIBEXPORT arrow_type arrow_type_for(oid) PQXX_NOEXCEPT;
+
+/// Format string for an Arrow type, as used by the Arrow C data interface
+PQXX_LIBEXPORT const char *arrow_format(arrow_type) PQXX_NOEXCEPT;
+
+
+/// One column of an arrow_batch, in Apache Arrow memory layout
+/** The buffers are laid out as Arrow specifies for the column's type, so Arrow
+ * code can use them as they are:
+ *
+ * - validity() is a bitmap with a set bit for every non-null value.  Bit i%8
+ *   of byte i/8 stands for value i.
+ * - For booleans, data() is a bitmap of the values, in the same bit order.
+ * - For numbers, data() holds size() values of the column's type.
+ * - For strings, data() holds all characters back to back, and offsets()
+ *   holds size()+1 positions in data(): value i runs from offsets()[i] up to
+ *   offsets()[i+1].
+ */
+class PQXX_LIBEXPORT arrow_column
+{
+public:
+  typedef unsigned long size_type;
+
+  arrow_column(const std::string &Name, oid Type);
+
+  const std::string &name() const PQXX_NOEXCEPT { return m_name; }
+
+  /// PostgreSQL type of the column
+  oid pg_type() const PQXX_NOEXCEPT { return m_pg_type; }
+
+  /// Arrow type of the column
+  arrow_type type() const PQXX_NOEXCEPT { return m_type; }
+
+  /// Number of values in the column
+  size_type size() const PQXX_NOEXCEPT { return m_size; }
+
+  size_type null_count() const PQXX_NOEXCEPT { return m_nulls; }
+
+  const unsigned char *validity() const PQXX_NOEXCEPT
+	{ return m_valid.empty() ? 0 : &m_valid[0]; }
+
+  const unsigned char *data() const PQXX_NOEXCEPT
+	{ return m_data.empty() ? 0 : &m_data[0]; }
+
+  /// Size of data() in bytes
+  size_type data_size() const PQXX_NOEXCEPT { return m_data.size(); }
+
+  /// Offsets into data(), for string columns; null pointer otherwise
+  const long long *offsets() const PQXX_NOEXCEPT
+	{ return (m_type == arrow_large_utf8) ? &m_offsets[0] : 0; }
+
+  /// Append a value in PostgreSQL's text format
+  /** @param Text Zero-terminated text.
+   * @param Len Length of Text.
+   */
+  void append(const char Text[], size_type Len);
+
+  /// Append a null
+  void append_null();
+
+  /// Remove the last value
+  void pop_back();
+
+  /// Remove all values, but keep the memory for reuse
+  void clear() PQXX_NOEXCEPT;
+
+private:
+  PQXX_PRIVATE void push_bit(std::vector<unsigned char> &, bool);
+  PQXX_PRIVATE void pop_bit(std::vector<unsigned char> &, size_type)
+	PQXX_NOEXCEPT;
+  PQXX_PRIVATE void drop_value(size_type) PQXX_NOEXCEPT;
+  template<typename T> void put(const T &);
+  PQXX_PRIVATE size_type width() const PQXX_NOEXCEPT;
+
+  std::string m_name;
+  oid m_pg_type;
+  arrow_type m_type;
+  size_type m_size;
+  size_type m_nulls;
+  std::vector<unsigned char> m_valid;
+  std::vector<unsigned char> m_data;
+  std::vector<long long> m_offsets;
+};
+
+
+/// A batch of rows in Apache Arrow columnar layout
+/** Converting a result to Arrow format field by field, through strings, is
+ * slow.  An arrow_batch converts rows straight from a result, or from a COPY
+ * stream, into Arrow buffers.  Column types follow from the columns' PostgreSQL
+ * types; see arrow_type_for().
+ *
+ * To keep memory use bounded, convert a limited number of rows at a time,
+ * hand the batch off, clear() it, and go on with the next rows.  The batch
+ * keeps its memory for reuse.  To avoid holding the whole query result in
+ * memory as well, read it through a cursor:
+ *
+ * @code
+ * icursorstream cur(T, "SELECT * FROM sales", "sales", 10000);
+ * arrow_batch batch(T.exec("SELECT * FROM sales LIMIT 0"));
+ * result block;
+ * while (cur >> block)
+ * {
+ *   batch.clear();
+ *   batch.append(block);
+ *   process(batch);
+ * }
+ * @endcode
+ *
+ * Or read the data as a COPY stream:
+ *
+ * @code
+ * tablereader reader(T, "sales");
+ * while (batch.read(reader, 10000)) { process(batch); batch.clear(); }
+ * @endcode
+ */
+class PQXX_LIBEXPORT arrow_batch
+{
+public:
+  typedef arrow_column::size_type size_type;
+
+  /// Create a batch without columns; add them with add_column().
+  arrow_batch();
+
+  /// Create a batch with the same columns as Shape.  Takes none of its rows.
+  explicit arrow_batch(const result &Shape);
+
+  /// Add a column.  Only allowed while the batch is empty.
+  void add_column(const std::string &Name, oid Type);
+
+  size_type rows() const PQXX_NOEXCEPT { return m_rows; }
+  size_type columns() const PQXX_NOEXCEPT { return m_columns.size(); }
+
+  const arrow_column &operator[](size_type i) const { return m_columns[i]; }
+  const arrow_column &at(size_type i) const { return m_columns.at(i); }
+
+  /// Append rows from a result with the same columns
+  void append(const result &R)
+	{ append(R, 0, R.size()); }
+
+  /// Append rows Begin (inclusive) to End (exclusive) from a result
+  void append(const result &R, result::size_type Begin, result::size_type End);
+
+  /// Append one line of COPY data in PostgreSQL's text format
+  void append_copy_line(const std::string &Line);
+
+  /// Read up to MaxRows lines from a COPY stream.  Returns number of rows read.
+  size_type read(tablereader &Reader, size_type MaxRows);
+
+  /// Remove all rows, but keep the columns and memory
+  void clear() PQXX_NOEXCEPT;
+
+private:
+  /// Remove values beyond rows() from all columns
+  PQXX_PRIVATE void drop_partial_rows() PQXX_NOEXCEPT;
+
+  std::vector<arrow_column> m_columns;
+  size_type m_rows;
+
+  /// Buffers for COPY data, kept to avoid allocations
+  std::string m_line, m_field;
+};
+
+} // namespace pqxx
+
+
+#include "pqxx/compiler-internal-post.hxx"
+
+#endif
@@ -0,0 +1,121 @@
+/*-------------------------------------------------------------------------
+ *
+ *   FILE
+ *	pqxx/async_query.hxx
+ *
+ *   DESCRIPTION
+ *      definition of the pqxx::async_query class.
+ *   Executes a single query without blocking the calling thread
+ *   DO NOT INCLUDE THIS FILE DIRECTLY; include pqxx/async_query instead.
+ *
+ * Copyright (c) 2016, Jeroen T. Vermeulen <jtv@xs4all.nl>
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this mistake,
+ * or contact the author.
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef PQXX_H_ASYNC_QUERY
+#define PQXX_H_ASYNC_QUERY
+
+#include "pqxx/compiler-public.hxx"
+#include "pqxx/compiler-internal-pre.hxx"
+
+#include "pqxx/transaction_base"
+
+
+namespace pqxx
+{
+
+/// Single query executing "in the background," for use in event loops
+/** An async_query sends its query to the backend as soon as it is constructed,
+ * but does not wait for the result.  Instead, it lets your event loop (based on
+ * select(), poll(), epoll, or whatever you like) wait on the connection's
+ * socket, and pick up the result once it has arrived.
+ *
+ * Like a pipeline, an async_query occupies its transaction while it is
+ * running: you can't execute other queries in the transaction until the
+ * async_query has finished or has been destroyed.
+ *
+ * A typical event loop does something like this:
+ *
+ * @code
+ * pqxx::async_query q(txn, "SELECT count(*) FROM bigtable");
+ * while (!q.ready())
+ * {
+ *   // ...wait for q.sock() to become readable (or writable, if
+ *   // q.wants_write() is true), while also doing other work...
+ * }
+ * pqxx::result r = q.get();
+ * @endcode
+ *
+ * The coroutine support in pqxx/coroutine is built on top of this class.
+ */
+class PQXX_LIBEXPORT async_query : public internal::transactionfocus
+{
+public:
+  /// Start executing query.
+  /** If the transaction has not begun on the backend yet, this may block while
+   * it does.  Sending the query itself normally completes immediately.
+   */
+  async_query(transaction_base &, const std::string &query,
+      const std::string &Name=std::string());
+
+  /// Destroy async_query.  If the query is still running, it is canceled.
+  /** @warning Canceling a query aborts the transaction it runs in.  The error
+   * is registered with the transaction, which reports it when you next try to
+   * use it.  To keep the transaction alive, call get() first.
+   */
+  ~async_query() PQXX_NOEXCEPT;
+
+  /// Socket that the caller's event loop should wait on, or -1 if none.
+  /** @warning The socket may change or go away when you call into libpqxx.
+   * Query it again every time you're about to wait.
+   */
+  int sock() const PQXX_NOEXCEPT;
+
+  /// Is outgoing data still waiting to be sent to the backend?
+  /** Sends as much of any outgoing data as the socket will accept without
+   * blocking.  If this returns true, wait for the socket to become writable
+   * rather than readable before calling ready() again.
+   */
+  bool wants_write();
+
+  /// Process any input that has arrived; is the query's result complete?
+  /** Never blocks.  Once this returns true, get() can return the result
+   * without waiting.
+   */
+  bool ready();
+
+  /// Has the query finished?  Unlike ready(), does not look for input.
+  bool done() const PQXX_NOEXCEPT { return m_done; }
+
+  /// Obtain the query's result.  Waits for it if necessary.
+  /** If the query failed, throws the appropriate exception.
+   */
+  result get();
+
+  /// The query being executed.
+  const std::string &query() const PQXX_NOEXCEPT { return m_query; }
+
+private:
+  PQXX_PRIVATE void detach() PQXX_NOEXCEPT;
+  PQXX_PRIVATE void cancel() PQXX_NOEXCEPT;
+
+  std::string m_query;
+  result m_result;
+  bool m_done;
+
+  /// Not allowed
+  async_query(const async_query &);
+  /// Not allowed
+  async_query &operator=(const async_query &);
+};
+
+} // namespace pqxx
+
+
+#include "pqxx/compiler-internal-post.hxx"
+
+#endif
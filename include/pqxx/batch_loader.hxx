@@ -0,0 +1,187 @@
+/*-------------------------------------------------------------------------
+ *
+ *   FILE
+ *	pqxx/batch_loader.hxx
+ *
+ *   DESCRIPTION
+ *      definition of the pqxx::batch_loader class.
+ *   Bulk-loads rows, setting aside the ones that fail
+ *   DO NOT INCLUDE THIS FILE DIRECTLY; include pqxx/batch_loader instead.
+ *
+ * Copyright (c) 2016, Jeroen T. Vermeulen <jtv@xs4all.nl>
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this mistake,
+ * or contact the author.
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef PQXX_H_BATCH_LOADER
+#define PQXX_H_BATCH_LOADER
+
+#include "pqxx/compiler-public.hxx"
+#include "pqxx/compiler-internal-pre.hxx"
+
+#include <string>
+#include <vector>
+
+#include "pqxx/tablewriter"
+
+
+namespace pqxx
+{
+class dbtransaction;
+
+/// Load rows into a table, setting aside the rows that the table won't accept
+/** When a single row in a COPY violates a constraint, or holds a value the
+ * column can't take, the entire COPY fails.  Wrapping every row in its own
+ * subtransaction avoids that, but costs a round trip per row.
+ *
+ * A batch_loader collects rows, and on flush() loads them all in a single COPY
+ * inside a savepoint.  Only if that fails does it split the batch in halves and
+ * try each half separately, and so on, until it has narrowed the failures down
+ * to individual rows.  With k bad rows in a batch of n, that takes on the order
+ * of k log n attempts.  The good rows stay in the table; the bad ones show up
+ * in rejects().
+ *
+ * @code
+ * pqxx::work W(C);
+ * pqxx::batch_loader loader(W, "mytable");
+ * loader.load(rows.begin(), rows.end());
+ * loader.flush();
+ * for (size_t i = 0; i < loader.rejects().size(); ++i)
+ *   std::cerr << loader.rejects()[i].error;
+ * W.commit();
+ * @endcode
+ *
+ * Only data exceptions and integrity constraint violations count as bad rows.
+ * Any other error, such as a missing table or a broken connection, aborts the
+ * flush and propagates to the caller.  Rows that went in before that are still
+ * part of the transaction.
+ *
+ * The savepoints are subtransactions, so the transaction must not be in use
+ * for anything else during a flush().  With deferred BEGIN enabled on the
+ * connection, the savepoints cost no extra round trips.
+ */
+class PQXX_LIBEXPORT batch_loader
+{
+public:
+  typedef unsigned long size_type;
+
+  /// A row that the table would not accept
+  struct rejected_row
+  {
+    /// Position of the row, counting all rows given to the loader from zero
+    size_type index;
+    /// The row, in PostgreSQL's COPY text format
+    std::string line;
+    /// The error that loading the row on its own produced
+    std::string error;
+  };
+
+  batch_loader(dbtransaction &T,
+	const std::string &Table,
+	const std::string &Null=std::string());
+
+  /// Load only the given columns, in the given order.
+  template<typename ITER> batch_loader(dbtransaction &T,
+	const std::string &Table,
+	ITER begincolumns,
+	ITER endcolumns,
+	const std::string &Null=std::string());
+
+  /// Add one row, given as a container of fields.
+  template<typename TUPLE> void insert(const TUPLE &);
+
+  /// Add a range of rows, where each row is a container of fields.
+  template<typename ITER> void load(ITER begin, ITER end);
+
+  /// Add one row in PostgreSQL's COPY text format.
+  void write_raw_line(const std::string &);
+
+  /// Number of rows waiting for flush().
+  size_type pending() const PQXX_NOEXCEPT { return m_lines.size(); }
+
+  /// Load all pending rows.  Returns the number of rows that went in.
+  /** Rows that fail are added to rejects().  Rows that were never flushed are
+   * discarded when the loader is destroyed.
+   */
+  size_type flush();
+
+  /// Rows that failed to load, in the order they were given
+  const std::vector<rejected_row> &rejects() const PQXX_NOEXCEPT
+	{ return m_rejects; }
+
+  /// Forget about rejected rows.
+  void clear_rejects() PQXX_NOEXCEPT { m_rejects.clear(); }
+
+  /// Number of rows loaded so far.
+  size_type rows() const PQXX_NOEXCEPT { return m_rows; }
+
+  /// Number of COPY attempts made so far, successful or not.
+  size_type attempts() const PQXX_NOEXCEPT { return m_attempts; }
+
+private:
+  PQXX_PRIVATE size_type load_range(size_type Begin, size_type End);
+  PQXX_PRIVATE void copy(size_type Begin, size_type End);
+  PQXX_PRIVATE void reject(size_type, const std::exception &);
+
+  dbtransaction &m_trans;
+  std::string m_table;
+  std::vector<std::string> m_columns;
+  std::string m_null;
+
+  /// Rows waiting for flush()
+  std::vector<std::string> m_lines;
+
+  /// Index of the first pending row among all rows given to the loader
+  size_type m_offset;
+
+  std::vector<rejected_row> m_rejects;
+  size_type m_rows;
+  size_type m_attempts;
+
+  /// Not allowed
+  batch_loader(const batch_loader &);
+  /// Not allowed
+  batch_loader &operator=(const batch_loader &);
+};
+
+
+template<typename ITER> inline batch_loader::batch_loader(dbtransaction &T,
+	const std::string &Table,
+	ITER begincolumns,
+	ITER endcolumns,
+	const std::string &Null) :
+  m_trans(T),
+  m_table(Table),
+  m_columns(begincolumns, endcolumns),
+  m_null(Null),
+  m_lines(),
+  m_offset(0),
+  m_rejects(),
+  m_rows(0),
+  m_attempts(0)
+{
+}
+
+
+template<typename TUPLE> inline void batch_loader::insert(const TUPLE &T)
+{
+  typedef typename TUPLE::const_iterator iter;
+  write_raw_line(
+	separated_list("\t", T.begin(), T.end(), internal::Escaper<iter>(m_null)));
+}
+
+
+template<typename ITER> inline void batch_loader::load(ITER begin, ITER end)
+{
+  for (; begin != end; ++begin) insert(*begin);
+}
+
+} // namespace pqxx
+
+
+#include "pqxx/compiler-internal-post.hxx"
+
+#endif
@@ -73,6 +73,10 @@ public:
 
   /// Read and unescape bytea field
   /** The field will be zero-terminated, even if the original bytea field isn't.
+   *
+   * A field in binary format (see prepare::invocation::exec_binary()) needs no
+   * unescaping.  The binarystring then refers to the data inside the result,
+   * and keeps the result alive, instead of making a copy.
    * @param F the field to read; must be a bytea field
    */
   explicit binarystring(const field &);					//[t62]
@@ -104,7 +108,7 @@ public:
 	{ return const_reverse_iterator(begin()); }
 
   /// Unescaped field contents
-  const value_type *data() const PQXX_NOEXCEPT {return m_buf.get();}	//[t62]
+  const value_type *data() const PQXX_NOEXCEPT { return m_data; }	//[t62]
 
   const_reference operator[](size_type i) const PQXX_NOEXCEPT		//[t62]
 	{ return data()[i]; }
@@ -126,7 +130,7 @@ public:
    * a null character, you will not find one here.
    */
   const char *get() const PQXX_NOEXCEPT					//[t62]
-			{ return reinterpret_cast<const char *>(m_buf.get()); }
+			{ return reinterpret_cast<const char *>(m_data); }
 
   /// Read as regular C++ string (may include null characters)
   /** @warning libpqxx releases before 3.1 stored the string and returned a
@@ -151,7 +155,33 @@ private:
    */
   smart_pointer_type &m_buf;
   size_type m_size;
+
+  /// Start of the data: in m_buf, or in m_owner's memory
+  const value_type *m_data;
+
+  /// Result holding the data, if taken from a field in binary format
+  result m_owner;
 };
+
+
+/// Decode a bytea value in PostgreSQL's hex format
+/** The hex format is a backslash and an "x," followed by two hex digits for
+ * each byte.  Servers from PostgreSQL 9.0 onwards send bytea in this format,
+ * unless configured otherwise.
+ *
+ * Decodes into a caller-supplied buffer, so you can reuse memory for multiple
+ * values.  The buffer may be the same memory as the text, to decode in place.
+ *
+ * @param Text the escaped value, starting with the "\x" prefix
+ * @param Len length of Text, in bytes
+ * @param Buf buffer to receive the binary data; needs room for (Len-2)/2 bytes
+ * @return number of bytes written to Buf
+ * @throw argument_error if Text is not in hex format
+ */
+PQXX_LIBEXPORT size_t unescape_bytea_hex(
+	const char Text[],
+	size_t Len,
+	unsigned char Buf[]);
 }
 
 #include "pqxx/compiler-internal-post.hxx"
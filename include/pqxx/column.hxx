@@ -0,0 +1,136 @@
+/*-------------------------------------------------------------------------
+ *
+ *   FILE
+ *	pqxx/column.hxx
+ *
+ *   DESCRIPTION
+ *      definitions for the pqxx::column class.
+ *   pqxx::column holds one column of a result as a contiguous array.
+ *   DO NOT INCLUDE THIS FILE DIRECTLY; include pqxx/column instead.
+ *
+ * Copyright (c) 2016, Jeroen T. Vermeulen <jtv@xs4all.nl>
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this mistake,
+ * or contact the author.
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef PQXX_H_COLUMN
+#define PQXX_H_COLUMN
+
+#include "pqxx/compiler-public.hxx"
+#include "pqxx/compiler-internal-pre.hxx"
+
+#include <vector>
+
+
+namespace pqxx
+{
+
+/// One column of data, converted to values of type T and stored contiguously
+/** A result stores its data row by row, as text, and every field access goes
+ * through libpq.  That's fine for processing a row at a time, but wasteful for
+ * analytical code that scans a few columns across many rows.  For such code,
+ * convert the columns you need once, using result::to_column().
+ *
+ * The values sit in one contiguous array, so scans are cache-friendly and easy
+ * to vectorize.  Null fields hold a default-constructed T; a separate bitmap
+ * says which fields are null.  The bitmap follows the Apache Arrow layout: bit
+ * i%8 of byte i/8 is set if and only if value i is not null.  So you can hand
+ * the data to Arrow-based code without conversion.
+ *
+ * @warning For column<bool>, data() is not available: std::vector<bool> does
+ * not store its values as an array of bool.  Indexing still works, but
+ * yields a value rather than a reference into the column.
+ */
+template<typename T> class column
+{
+public:
+  typedef T value_type;
+  typedef unsigned long size_type;
+  typedef typename std::vector<T>::const_iterator const_iterator;
+  /// const T &, except for column<bool>, where it is a proxy object
+  typedef typename std::vector<T>::const_reference const_reference;
+
+  column() : m_values(), m_valid(), m_nulls(0) {}
+
+  size_type size() const PQXX_NOEXCEPT { return m_values.size(); }
+  bool empty() const PQXX_NOEXCEPT { return m_values.empty(); }
+
+  /// Reserve room for n values
+  void reserve(size_type n)
+	{ m_values.reserve(n); m_valid.reserve((n + 7) / 8); }
+
+  /// Append a value
+  void push_back(const T &v) { append(v); m_valid.back() |= bit(size()-1); }
+
+  /// Append a null
+  void push_null() { append(T()); ++m_nulls; }
+
+  /// Value i; a default-constructed T if the field is null
+  const_reference operator[](size_type i) const { return m_values[i]; }
+
+  /// Is value i null?
+  bool is_null(size_type i) const
+	{ return !(m_valid[i / 8] & bit(i)); }
+
+  /// Number of nulls in the column
+  size_type null_count() const PQXX_NOEXCEPT { return m_nulls; }
+
+  /// Pointer to the first of size() contiguous values
+  const T *data() const PQXX_NOEXCEPT
+	{ return m_values.empty() ? 0 : &m_values[0]; }
+
+  /// Arrow-style validity bitmap: (size()+7)/8 bytes, a set bit for non-null
+  const unsigned char *validity() const PQXX_NOEXCEPT
+	{ return m_valid.empty() ? 0 : &m_valid[0]; }
+
+  const_iterator begin() const { return m_values.begin(); }
+  const_iterator end() const { return m_values.end(); }
+
+  /// The values, as a vector
+  const std::vector<T> &values() const PQXX_NOEXCEPT { return m_values; }
+
+  void swap(column &rhs)
+  {
+    m_values.swap(rhs.m_values);
+    m_valid.swap(rhs.m_valid);
+    const size_type n = m_nulls;
+    m_nulls = rhs.m_nulls;
+    rhs.m_nulls = n;
+  }
+
+  void clear() PQXX_NOEXCEPT
+	{ m_values.clear(); m_valid.clear(); m_nulls = 0; }
+
+private:
+  static unsigned char bit(size_type i) PQXX_NOEXCEPT
+	{ return static_cast<unsigned char>(1u << (i % 8)); }
+
+  void append(const T &v)
+  {
+    m_values.push_back(v);
+    if (size() % 8 != 1) return;
+    try
+    {
+      m_valid.push_back(0);
+    }
+    catch (...)
+    {
+      m_values.pop_back();
+      throw;
+    }
+  }
+
+  std::vector<T> m_values;
+  std::vector<unsigned char> m_valid;
+  size_type m_nulls;
+};
+
+} // namespace pqxx
+
+
+#include "pqxx/compiler-internal-post.hxx"
+
+#endif
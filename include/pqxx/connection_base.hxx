@@ -26,6 +26,8 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "pqxx/errorhandler"
 #include "pqxx/except"
@@ -49,6 +51,7 @@ class binarystring;
 class connectionpolicy;
 class notification_receiver;
 class result;
+class retry_policy;
 class transaction_base;
 
 namespace internal
@@ -98,6 +101,7 @@ namespace internal
 {
 namespace gate
 {
+class connection_async_query;
 class connection_dbtransaction;
 class connection_errorhandler;
 class connection_largeobject;
@@ -107,6 +111,7 @@ class connection_pipeline;
 class connection_prepare_invocation;
 class connection_reactivation_avoidance_exemption;
 class connection_sql_cursor;
+class connection_tablestream;
 class connection_transaction;
 } // namespace pqxx::internal::gate
 } // namespace pqxx::internal
@@ -383,6 +388,10 @@ public:
      * @deprecated Always supported in libpqxx 5.0 or better.
      */
     cap_notify_payload,
+    /// Can we ask the server whether a transaction committed (txid_status)?
+    cap_txid_status,
+    /// Can large objects be accessed beyond 2 GB (lo_lseek64 and friends)?
+    cap_large_objects_64,
 
     /// Not a capability value; end-of-enumeration marker
     cap_end
@@ -663,6 +672,17 @@ public:
   template<typename TRANSACTOR>
   void perform(const TRANSACTOR &T) { perform(T, 3); }
 
+  /// Perform the transaction defined by a transactor-based object.
+  /** Retries only when and as Policy says: typically only after errors where
+   * a new attempt may succeed, and after a randomized, growing wait.
+   *
+   * @param T The transactor to be executed.
+   * @param Policy Rules for retrying; also counts the retries.
+   * @see retry_policy
+   */
+  template<typename TRANSACTOR>
+  void perform(const TRANSACTOR &T, retry_policy &Policy);
+
   /**
    * @}
    */
@@ -809,6 +829,33 @@ public:
    /// Retrieve current error verbosity
   error_verbosity get_verbosity() const PQXX_NOEXCEPT {return m_verbosity;}
 
+  /// Hold back each transaction's BEGIN until its first statement?
+  /** Normally a transaction starts its backend transaction as soon as it is
+   * created, which costs a round trip to the server.  With deferred BEGIN, a
+   * transaction instead sends its BEGIN in the same message as its first
+   * query.  A transaction that never executes anything costs no round trips
+   * at all.
+   *
+   * Errors are still reported against the statement that caused them: an
+   * error in the BEGIN as an error in the BEGIN, and one in the query as an
+   * error in that query.
+   *
+   * Prepared and parameterized statements, pipelines, asynchronous queries,
+   * and large object operations can not share their message with the BEGIN.
+   * They send it separately first.
+   *
+   * Subtransactions similarly send their savepoints along with their first
+   * statements.  They also hold back their release or rollback until the next
+   * statement after them.
+   *
+   * Transactions that manage their own start, such as robusttransaction, and
+   * nontransaction, which has none, are not affected.
+   */
+  void set_deferred_begin(bool Defer) PQXX_NOEXCEPT
+	{ m_deferred_begin = Defer; }
+  /// Are transactions' BEGINs being deferred?  See set_deferred_begin().
+  bool deferred_begin() const PQXX_NOEXCEPT { return m_deferred_begin; }
+
   /// Return pointers to the active errorhandlers.
   /** The entries are ordered from oldest to newest handler.
    *
@@ -847,6 +894,12 @@ private:
   void PQXX_PRIVATE Reset();
   void PQXX_PRIVATE RestoreVars();
   std::string PQXX_PRIVATE RawGetVar(const std::string &);
+  void PQXX_PRIVATE flush_deferred();
+  result PQXX_PRIVATE exec_parts(
+	const char Query[],
+	const std::string &Then,
+	result &ThenResult,
+	int Retries);
   void PQXX_PRIVATE process_notice_raw(const char msg[]) PQXX_NOEXCEPT;
 
   void read_capabilities();
@@ -860,7 +913,8 @@ private:
 	const char *const[],
 	const int[],
 	const int[],
-	int);
+	int,
+	int result_format=0);
   bool prepared_exists(const std::string &) const;
 
   /// Connection handle.
@@ -910,6 +964,12 @@ private:
   /// Current verbosity level
   error_verbosity m_verbosity;
 
+  /// Should transactions defer their BEGIN?
+  bool m_deferred_begin;
+
+  /// Statements to be sent along with the next query, such as a BEGIN
+  std::vector<std::string> m_deferred;
+
   friend class internal::gate::connection_errorhandler;
   void PQXX_PRIVATE register_errorhandler(errorhandler *);
   void PQXX_PRIVATE unregister_errorhandler(errorhandler *) PQXX_NOEXCEPT;
@@ -919,6 +979,7 @@ private:
   void PQXX_PRIVATE RegisterTransaction(transaction_base *);
   void PQXX_PRIVATE UnregisterTransaction(transaction_base *) PQXX_NOEXCEPT;
   bool PQXX_PRIVATE ReadCopyLine(std::string &);
+  int PQXX_PRIVATE TryReadCopyLine(std::string &);
   void PQXX_PRIVATE WriteCopyLine(const std::string &);
   void PQXX_PRIVATE EndCopyWrite();
   void PQXX_PRIVATE RawSetVar(const std::string &, const std::string &);
@@ -938,7 +999,21 @@ private:
   int PQXX_PRIVATE encoding_code();
   internal::pq::PGresult *get_result();
 
+  friend class internal::gate::connection_async_query;
+  /// Send queued output without blocking; return whether any remains queued.
+  bool PQXX_PRIVATE flush_output();
+
+  friend class internal::gate::connection_tablestream;
+  void PQXX_PRIVATE set_nonblocking(bool);
+
   friend class internal::gate::connection_dbtransaction;
+  void PQXX_PRIVATE defer(const std::string &);
+  bool PQXX_PRIVATE cancel_deferred(const std::string &) PQXX_NOEXCEPT;
+  void PQXX_PRIVATE drop_deferred() PQXX_NOEXCEPT;
+  result PQXX_PRIVATE exec_then(
+	const char Query[],
+	const std::string &Then,
+	bool &ThenDone);
 
   friend class internal::gate::connection_sql_cursor;
   void add_reactivation_avoidance_count(int);
@@ -981,6 +1056,12 @@ private:
 void wait_read(const internal::pq::PGconn *);
 void wait_read(const internal::pq::PGconn *, long seconds, long microseconds);
 void wait_write(const internal::pq::PGconn *);
+
+/// Wait until at least one of several sockets is ready.
+/** Each entry names a socket, and whether to wait for it to become writable
+ * rather than readable.  Negative sockets are ignored.
+ */
+void PQXX_LIBEXPORT wait_any(const std::vector<std::pair<int, bool> > &sockets);
 } // namespace pqxx::internal
 
 
@@ -0,0 +1,334 @@
+/*-------------------------------------------------------------------------
+ *
+ *   FILE
+ *	pqxx/coroutine.hxx
+ *
+ *   DESCRIPTION
+ *      C++20 coroutine support: awaitable queries, COPY, and notifications.
+ *   DO NOT INCLUDE THIS FILE DIRECTLY; include pqxx/coroutine instead.
+ *
+ * Copyright (c) 2016, Jeroen T. Vermeulen <jtv@xs4all.nl>
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this mistake,
+ * or contact the author.
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef PQXX_H_COROUTINE
+#define PQXX_H_COROUTINE
+
+#include "pqxx/compiler-public.hxx"
+#include "pqxx/compiler-internal-pre.hxx"
+
+#include "pqxx/async_query"
+#include "pqxx/connection_base"
+#include "pqxx/tablereader"
+#include "pqxx/tablewriter"
+
+/* This header is entirely optional, and is not included by pqxx/pqxx.  It
+ * defines nothing unless the compiler supports C++20 coroutines.  The library
+ * itself does not need to be compiled with coroutine support for this to work;
+ * everything in here is built on the nonblocking pqxx::async_query class.
+ */
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+
+#include <coroutine>
+#include <exception>
+#include <memory>
+
+
+namespace pqxx
+{
+/// Coroutine support.
+/** Coroutines can wait for libpqxx operations to complete without blocking the
+ * thread, e.g.:
+ *
+ * @code
+ * some_task list_customers(pqxx::work &w, pqxx::coro::executor &ex)
+ * {
+ *   pqxx::result r = co_await pqxx::coro::exec(w, "SELECT * FROM customer", ex);
+ *   // ...
+ * }
+ * @endcode
+ *
+ * libpqxx does not come with an event loop of its own.  Instead, you plug in
+ * your own (e.g. based on epoll or io_uring) by implementing the executor
+ * interface.
+ */
+namespace coro
+{
+/// Something waiting for a socket to become ready.  Used by executor.
+class PQXX_NOVTABLE waiter
+{
+public:
+  virtual ~waiter() {}
+
+  /// Called by the executor once the socket has become ready.
+  /** This may resume a suspended coroutine, so don't hold any locks while
+   * calling it.
+   */
+  virtual void io_ready() =0;
+};
+
+
+/// Executor hook: waits for sockets on behalf of suspended coroutines.
+/** Implement this on top of your event loop.  Its only job is to call
+ * io_ready() on a waiter once a given socket has become readable or writable.
+ * Each call to await_io() is a one-shot request: if the waiter needs to wait
+ * again, it will make another call.
+ */
+class PQXX_NOVTABLE executor
+{
+public:
+  virtual ~executor() {}
+
+  /// Call w.io_ready() once fd is readable (or, if write is set, writable).
+  /** The call to w.io_ready() may happen from inside await_io() if the socket
+   * is ready right away, or later from the event loop.
+   */
+  virtual void await_io(int fd, bool write, waiter &w) =0;
+};
+
+
+namespace internal
+{
+/// Common base for awaitables: suspend until executor says we're done.
+class PQXX_NOVTABLE awaitable_base : protected waiter
+{
+protected:
+  explicit awaitable_base(executor &ex) : m_ex(ex), m_handle(), m_error() {}
+
+  /// Try to make progress without blocking.  Return whether we're done.
+  virtual bool poll() =0;
+  /// Socket to wait on, and whether to wait for writability.
+  virtual int sock() const =0;
+  virtual bool wants_write() { return false; }
+
+  void suspend(std::coroutine_handle<> h)
+  {
+    m_handle = h;
+    wait();
+  }
+
+  void rethrow() const
+  {
+    if (m_error) std::rethrow_exception(m_error);
+  }
+
+private:
+  void wait()
+  {
+    try
+    {
+      const int fd = sock();
+      if (fd < 0) throw broken_connection();
+      m_ex.await_io(fd, wants_write(), *this);
+    }
+    catch (...)
+    {
+      m_error = std::current_exception();
+      m_handle.resume();
+    }
+  }
+
+  virtual void io_ready() PQXX_OVERRIDE
+  {
+    bool finished = true;
+    try
+    {
+      finished = poll();
+    }
+    catch (...)
+    {
+      m_error = std::current_exception();
+    }
+    if (finished) m_handle.resume();
+    else wait();
+  }
+
+  executor &m_ex;
+  std::coroutine_handle<> m_handle;
+  std::exception_ptr m_error;
+};
+} // namespace pqxx::coro::internal
+
+
+/// Awaitable query execution.  Use exec() to create one.
+class exec_awaitable : private internal::awaitable_base
+{
+public:
+  exec_awaitable(transaction_base &t, const std::string &query, executor &ex) :
+    awaitable_base(ex),
+    m_trans(t),
+    m_query(query),
+    m_async()
+  {
+  }
+
+  bool await_ready()
+  {
+    m_async.reset(new async_query(m_trans, m_query));
+    return m_async->ready();
+  }
+  void await_suspend(std::coroutine_handle<> h) { suspend(h); }
+  result await_resume()
+  {
+    rethrow();
+    const result r = m_async->get();
+    m_async.reset();
+    return r;
+  }
+
+private:
+  virtual bool poll() PQXX_OVERRIDE { return m_async->ready(); }
+  virtual int sock() const PQXX_OVERRIDE { return m_async->sock(); }
+  virtual bool wants_write() PQXX_OVERRIDE { return m_async->wants_write(); }
+
+  transaction_base &m_trans;
+  std::string m_query;
+  std::unique_ptr<async_query> m_async;
+};
+
+
+/// Awaitable wait for notifications.  Use next_notification() to create one.
+/** Once it completes, any pending notifications have been delivered to their
+ * receivers.  The co_await expression yields the number of notifications that
+ * were processed.
+ */
+class notification_awaitable : private internal::awaitable_base
+{
+public:
+  notification_awaitable(connection_base &c, executor &ex) :
+    awaitable_base(ex),
+    m_conn(c),
+    m_notifs(0)
+  {
+  }
+
+  bool await_ready()
+  {
+    m_conn.activate();
+    return poll();
+  }
+  void await_suspend(std::coroutine_handle<> h) { suspend(h); }
+  int await_resume() { rethrow(); return m_notifs; }
+
+private:
+  virtual bool poll() PQXX_OVERRIDE
+  {
+    m_notifs = m_conn.get_notifs();
+    return m_notifs > 0;
+  }
+  virtual int sock() const PQXX_OVERRIDE { return m_conn.sock(); }
+
+  connection_base &m_conn;
+  int m_notifs;
+};
+
+
+/// Awaitable read of one COPY line.  Use read_line() to create one.
+class read_line_awaitable : private internal::awaitable_base
+{
+public:
+  read_line_awaitable(tablereader &r, std::string &line, executor &ex) :
+    awaitable_base(ex),
+    m_reader(r),
+    m_line(line),
+    m_got(false)
+  {
+  }
+
+  bool await_ready() { return poll(); }
+  void await_suspend(std::coroutine_handle<> h) { suspend(h); }
+  bool await_resume() { rethrow(); return m_got; }
+
+private:
+  virtual bool poll() PQXX_OVERRIDE
+  {
+    m_got = m_reader.try_get_raw_line(m_line);
+    return m_got || !m_reader;
+  }
+  virtual int sock() const PQXX_OVERRIDE { return m_reader.sock(); }
+
+  tablereader &m_reader;
+  std::string &m_line;
+  bool m_got;
+};
+
+
+/// Awaitable write of one COPY line.  Use write_line() to create one.
+class write_line_awaitable : private internal::awaitable_base
+{
+public:
+  write_line_awaitable(tablewriter &w, const std::string &line, executor &ex) :
+    awaitable_base(ex),
+    m_writer(w),
+    m_line(line)
+  {
+  }
+
+  bool await_ready() { return poll(); }
+  void await_suspend(std::coroutine_handle<> h) { suspend(h); }
+  void await_resume() { rethrow(); }
+
+private:
+  virtual bool poll() PQXX_OVERRIDE
+	{ return m_writer.try_write_raw_line(m_line); }
+  virtual int sock() const PQXX_OVERRIDE { return m_writer.sock(); }
+  virtual bool wants_write() PQXX_OVERRIDE { return true; }
+
+  tablewriter &m_writer;
+  std::string m_line;
+};
+
+
+/// Execute query; co_await the returned object to obtain the result.
+inline exec_awaitable exec(
+	transaction_base &t,
+	const std::string &query,
+	executor &ex)
+{
+  return exec_awaitable(t, query, ex);
+}
+
+
+/// Wait for notifications on c; co_await yields the number processed.
+inline notification_awaitable next_notification(
+	connection_base &c,
+	executor &ex)
+{
+  return notification_awaitable(c, ex);
+}
+
+
+/// Read a line from r into line; co_await yields false once the COPY is done.
+inline read_line_awaitable read_line(
+	tablereader &r,
+	std::string &line,
+	executor &ex)
+{
+  return read_line_awaitable(r, line, ex);
+}
+
+
+/// Write line to w, waiting for the socket if too much output is queued up.
+/** Set w to nonblocking mode first, or the writes themselves may block.
+ */
+inline write_line_awaitable write_line(
+	tablewriter &w,
+	const std::string &line,
+	executor &ex)
+{
+  return write_line_awaitable(w, line, ex);
+}
+} // namespace pqxx::coro
+} // namespace pqxx
+
+#endif // __has_include(<coroutine>)
+#endif // __cpp_impl_coroutine && __has_include
+
+#include "pqxx/compiler-internal-post.hxx"
+
+#endif
@@ -23,6 +23,8 @@
 #include "pqxx/compiler-internal-pre.hxx"
 
 #include <limits>
+#include <list>
+#include <map>
 #include <stdexcept>
 
 #include "pqxx/result"
@@ -31,6 +33,7 @@
 
 namespace pqxx
 {
+class async_query;
 class dbtransaction;
 
 
@@ -225,9 +228,27 @@ public:
   /// Return zero-row result for this cursor
   const result &empty_result() const PQXX_NOEXCEPT { return m_empty_result; }
 
+  /// Start fetching rows in the background
+  /** The next fetch() returns these rows, and must ask for exactly this number
+   * of rows.  A forward move() skips them, but must skip at least as many rows
+   * as were prefetched.
+   *
+   * While the fetch is in progress, the transaction can't execute any other
+   * queries.  Closing the cursor waits for the fetch to complete.
+   */
+  void prefetch(transaction_base &, difference_type rows);
+
+  /// Is a prefetch in progress?
+  bool prefetching() const PQXX_NOEXCEPT { return m_prefetch != 0; }
+
+  /// Number of rows being prefetched, if prefetching() is true
+  difference_type prefetch_rows() const PQXX_NOEXCEPT
+	{ return m_prefetch_rows; }
+
   void close() PQXX_NOEXCEPT;
 
 private:
+  result collect_prefetch(difference_type &displacement);
   difference_type adjust(difference_type hoped, difference_type actual);
   static std::string stridestring(difference_type);
   /// Initialize cached empty result.  Call only at beginning or end!
@@ -255,6 +276,17 @@ private:
 
   /// End position, or -1 for unknown
   difference_type m_endpos;
+
+  /// FETCH running in the background, if any
+  async_query *m_prefetch;
+
+  /// Number of rows requested by m_prefetch
+  difference_type m_prefetch_rows;
+
+  /// Not allowed
+  sql_cursor(const sql_cursor &);
+  /// Not allowed
+  sql_cursor &operator=(const sql_cursor &);
 };
 
 
@@ -265,6 +297,64 @@ PQXX_LIBEXPORT result stateless_cursor_retrieve(
 	result::difference_type begin_pos,
 	result::difference_type end_pos);
 
+
+/// LRU cache of fixed-size blocks of rows, for stateless_cursor
+/** Block n holds rows n*block_rows up to (n+1)*block_rows.  A retrieval reads
+ * whichever of the blocks it needs are missing, and builds its result from the
+ * blocks.  When the blocks use up more than the memory budget, the least
+ * recently used ones are dropped.
+ */
+class PQXX_LIBEXPORT cursor_block_cache
+{
+public:
+  typedef result::size_type size_type;
+  typedef result::difference_type difference_type;
+
+  cursor_block_cache() PQXX_NOEXCEPT;
+
+  /// Set block size and memory budget.  Zero block size disables the cache.
+  void configure(size_type block_rows, size_type max_bytes);
+
+  bool enabled() const PQXX_NOEXCEPT { return m_block_rows != 0; }
+
+  /// Drop all cached blocks
+  void clear() PQXX_NOEXCEPT;
+
+  /// Approximate number of bytes of row data held in the cache
+  size_type memory() const PQXX_NOEXCEPT { return m_used; }
+
+  /// Number of cached blocks
+  size_type blocks() const PQXX_NOEXCEPT { return m_blocks.size(); }
+
+  /// Same as stateless_cursor_retrieve(), but through the cache
+  result retrieve(
+	sql_cursor &,
+	difference_type size,
+	difference_type begin_pos,
+	difference_type end_pos);
+
+private:
+  struct block
+  {
+    result data;
+    size_type bytes;
+    std::list<difference_type>::iterator recent;
+  };
+  typedef std::map<difference_type, block> block_map;
+
+  PQXX_PRIVATE result get_block(sql_cursor &, difference_type size,
+	difference_type number);
+  PQXX_PRIVATE void evict() PQXX_NOEXCEPT;
+
+  size_type m_block_rows;
+  size_type m_max_bytes;
+  size_type m_used;
+  block_map m_blocks;
+
+  /// Block numbers, most recently used first
+  std::list<difference_type> m_recent;
+};
+
 } // namespace internal
 
 
@@ -288,7 +378,8 @@ public:
 	const std::string &query,
 	const std::string &cname,
 	bool hold) :
-    m_cur(trans, query, cname, cursor_base::random_access, up, op, hold)
+    m_cur(trans, query, cname, cursor_base::random_access, up, op, hold),
+    m_cache()
   {
   }
 
@@ -296,17 +387,19 @@ public:
   stateless_cursor(
 	transaction_base &trans,
 	const std::string adopted_cursor) :
-    m_cur(trans, adopted_cursor, op)
+    m_cur(trans, adopted_cursor, op),
+    m_cache()
   {
     // Put cursor in known position
     m_cur.move(cursor_base::backward_all());
   }
 
-  void close() PQXX_NOEXCEPT { m_cur.close(); }
+  void close() PQXX_NOEXCEPT { m_cache.clear(); m_cur.close(); }
 
   /// Number of rows in cursor's result set
   /** @note This function is not const; it may need to scroll to find the size
-   * of the result set.
+   * of the result set.  Only the first call does that; the cursor remembers
+   * the size.
    */
   size_type size() { return internal::obtain_stateless_cursor_size(m_cur); }
 
@@ -324,6 +417,11 @@ public:
    */
   result retrieve(difference_type begin_pos, difference_type end_pos)
   {
+    if (m_cache.enabled()) return m_cache.retrieve(
+	m_cur,
+	result::difference_type(size()),
+	begin_pos,
+	end_pos);
     return internal::stateless_cursor_retrieve(
 	m_cur,
 	result::difference_type(size()),
@@ -331,10 +429,23 @@ public:
 	end_pos);
   }
 
+  /// Keep retrieved rows in memory, to serve later retrievals
+  /** Rows are fetched and cached in blocks of @c block_rows rows.  A retrieval
+   * reads only the blocks that are not in the cache yet, so overlapping or
+   * repeated retrievals, as when paging back and forth through a result set,
+   * need not go to the server.  Once the cached rows take up more than about
+   * @c max_bytes bytes, the least recently used blocks are dropped.
+   *
+   * A @c block_rows of zero disables the cache.
+   */
+  void set_cache(size_type block_rows, size_type max_bytes=1024*1024)
+	{ m_cache.configure(block_rows, max_bytes); }
+
   const std::string &name() const PQXX_NOEXCEPT { return m_cur.name(); }
 
 private:
   internal::sql_cursor m_cur;
+  internal::cursor_block_cache m_cache;
 };
 
 
@@ -447,14 +558,47 @@ public:
   icursorstream &ignore(std::streamsize n=1);				//[t81]
 
   /// Change stride, i.e. the number of rows to fetch per read operation
-  /**
+  /** Turns off adaptive stride, if it was on.
    * @param stride Must be a positive number
    */
   void set_stride(difference_type stride);				//[t81]
   difference_type stride() const PQXX_NOEXCEPT { return m_stride; }	//[t81]
 
+  /// Let the stream choose its own stride, block by block
+  /** A fixed stride is hard to get right: with narrow rows it costs a round
+   * trip for little data, and with wide rows a block may use a lot of memory.
+   * With adaptive stride, the stream aims for blocks of about @c bytes bytes of
+   * field data that take about @c msec milliseconds to arrive.  After each full
+   * block it works out a new stride from the block's size and fetch time.
+   *
+   * The current stride is the starting point.  The stride may shrink as far as
+   * needed, but grows no more than twofold per block, and never beyond
+   * @c max_stride.  A zero @c msec means no time target.
+   *
+   * Like set_stride(), adaptation changes the number of rows per block, so it
+   * does not combine well with icursor_iterator.
+   */
+  void set_adaptive_stride(size_type bytes,
+	unsigned msec=100,
+	difference_type max_stride=100000);
+  bool adaptive_stride() const PQXX_NOEXCEPT { return m_target_bytes != 0; }
+
+  /// Fetch the next block in the background while the caller processes this one
+  /** With prefetching enabled, every time the stream hands out a block of rows
+   * it immediately asks the backend for the next one, without waiting for the
+   * answer.  The next read then finds its data already on its way, or even
+   * complete, so the round trip overlaps with the caller's processing.
+   *
+   * While a block is being prefetched, the transaction can't execute other
+   * queries.  A stride change takes effect after the block that is already
+   * being prefetched, and ignore() must skip at least that whole block.
+   */
+  void set_prefetch(bool on=true) PQXX_NOEXCEPT { m_prefetch = on; }
+  bool prefetch() const PQXX_NOEXCEPT { return m_prefetch; }
+
 private:
   result fetchblock();
+  void adapt_stride(const result &, unsigned long msec);
 
   friend class internal::gate::icursorstream_icursor_iterator;
   size_type forward(size_type n=1);
@@ -463,6 +607,7 @@ private:
 
   void service_iterators(difference_type);
 
+  transaction_base &m_context;
   internal::sql_cursor m_cur;
 
   difference_type m_stride;
@@ -471,6 +616,12 @@ private:
   mutable icursor_iterator *m_iterators;
 
   bool m_done;
+  bool m_prefetch;
+
+  /// Adaptive stride targets; zero bytes for a fixed stride
+  size_type m_target_bytes;
+  unsigned m_target_msec;
+  difference_type m_max_stride;
 };
 
 
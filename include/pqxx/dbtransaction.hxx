@@ -87,6 +87,10 @@ protected:
 
   /// Sensible default implemented here: begin backend transaction
   virtual void do_begin();						//[t1]
+  /// Begin backend transaction, and execute Query in the same round trip
+  /** Returns the result of the last statement in Query.
+   */
+  result begin_with(const std::string &Query);
   /// Sensible default implemented here: perform query
   virtual result do_exec(const char Query[]);
   /// To be implemented by derived class: commit backend transaction
@@ -95,11 +99,38 @@ protected:
   /** Default implementation does two things:
    * <ol>
    * <li>Clears the "connection reactivation avoidance counter"</li>
-   * <li>Executes a ROLLBACK statement</li>
+   * <li>Executes a ROLLBACK statement, unless the BEGIN was never sent</li>
    * </ol>
    */
   virtual void do_abort() PQXX_OVERRIDE;				//[t13]
 
+  /// Forget a deferred BEGIN that was never sent
+  /** Returns whether there was one.  If so, the backend transaction never
+   * started, so there is nothing to commit or abort.
+   * @see connection_base::set_deferred_begin()
+   */
+  bool cancel_deferred_begin() PQXX_NOEXCEPT;
+
+  /// Have the connection send Statement along with the next query
+  void defer(const std::string &Statement);
+
+  /// Take back Statement, if it is the last one deferred and not yet sent
+  /** Returns whether it was.
+   */
+  bool cancel_deferred(const std::string &Statement) PQXX_NOEXCEPT;
+
+  /// Forget all deferred statements that have not been sent yet
+  void drop_deferred() PQXX_NOEXCEPT;
+
+  /// Execute Query and then Then, in a single round trip
+  /** Returns the result of Query.  Sets ThenDone once the server has answered
+   * Then, so that the caller can tell which of the two an error came from.
+   */
+  result exec_then(
+	const char Query[],
+	const std::string &Then,
+	bool &ThenDone);
+
   static std::string fullname(const std::string &ttype,
 	const std::string &isolation);
 
@@ -225,6 +225,35 @@ public:
 	sql_error(err,Q) {}
 };
 
+/// The backend rolled back the transaction; trying again may well succeed
+class PQXX_LIBEXPORT transaction_rollback : public sql_error
+{
+public:
+  explicit transaction_rollback(const std::string &err) : sql_error(err) {}
+  transaction_rollback(const std::string &err, const std::string &Q) :
+	sql_error(err, Q) {}
+};
+
+/// Transaction could not be serialized with concurrent ones
+class PQXX_LIBEXPORT serialization_failure : public transaction_rollback
+{
+public:
+  explicit serialization_failure(const std::string &err) :
+	transaction_rollback(err) {}
+  serialization_failure(const std::string &err, const std::string &Q) :
+	transaction_rollback(err, Q) {}
+};
+
+/// Transaction was aborted to break a deadlock
+class PQXX_LIBEXPORT deadlock_detected : public transaction_rollback
+{
+public:
+  explicit deadlock_detected(const std::string &err) :
+	transaction_rollback(err) {}
+  deadlock_detected(const std::string &err, const std::string &Q) :
+	transaction_rollback(err, Q) {}
+};
+
 /// Error in data provided to SQL statement
 class PQXX_LIBEXPORT data_exception : public sql_error
 {
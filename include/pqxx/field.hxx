@@ -22,6 +22,9 @@
 #include "pqxx/compiler-public.hxx"
 #include "pqxx/compiler-internal-pre.hxx"
 
+#include <cstring>
+#include <ostream>
+
 #include "pqxx/strconv"
 
 
@@ -36,6 +39,171 @@ class row;
 typedef unsigned int row_size_type;
 typedef signed int row_difference_type;
 
+namespace internal
+{
+struct result_data;
+
+namespace gate
+{
+class field_binarystring;
+} // namespace pqxx::internal::gate
+
+/// Link from a field_view to the result data it points into
+/** Only used if PQXX_DEBUG_VIEWS is defined.  A result keeps a list of the
+ * views registered with it, and marks them as dangling when it goes away.
+ */
+class PQXX_LIBEXPORT view_registration
+{
+public:
+  view_registration() PQXX_NOEXCEPT :
+    m_home(0), m_prev(0), m_next(0), m_dangling(false) {}
+  explicit view_registration(const result &);
+  view_registration(const view_registration &) PQXX_NOEXCEPT;
+  ~view_registration() PQXX_NOEXCEPT { unlink(); }
+  view_registration &operator=(const view_registration &) PQXX_NOEXCEPT;
+
+  /// Throw usage_error if the result has been destroyed
+  void check() const { if (m_dangling) throw_dangling(); }
+
+  /// Mark all views in a result's list as dangling
+  static void orphan_all(view_registration *Head) PQXX_NOEXCEPT;
+
+private:
+  void link(const result_data *Home) PQXX_NOEXCEPT;
+  void unlink() PQXX_NOEXCEPT;
+  PQXX_NORETURN static void throw_dangling();
+
+  /// The result data this view points into
+  const result_data *m_home;
+  view_registration *m_prev, *m_next;
+  bool m_dangling;
+};
+} // namespace pqxx::internal
+
+
+/// Non-owning view of a field's text, valid for as long as its result
+/** Reading a field as a std::string copies its contents.  Where you only need
+ * to compare, hash, or scan the text, a field_view saves you that allocation:
+ * it just points into the result.
+ *
+ * The view becomes invalid once the result (or rather, the last remaining
+ * result object referring to the same data) is destroyed.  To catch views
+ * that outlive their results, configure libpqxx with --enable-debug-views,
+ * which defines PQXX_DEBUG_VIEWS in its configuration headers.  Accessing the
+ * data of a dangling view then throws usage_error.  This makes views bigger
+ * and slower, so don't use it in production builds.  Never define
+ * PQXX_DEBUG_VIEWS yourself: the library and all code using it must agree on
+ * the layout of field_view.
+ *
+ * A null field's view is empty.  Use field::is_null() to tell the difference.
+ */
+class field_view
+{
+public:
+  typedef size_t size_type;
+  typedef const char *const_iterator;
+  typedef const_iterator iterator;
+
+  field_view() PQXX_NOEXCEPT :
+    m_data(""),
+    m_size(0)
+#ifdef PQXX_DEBUG_VIEWS
+    , m_reg()
+#endif
+  {}
+
+  /// View of Size bytes at Data
+  field_view(const char Data[], size_type Size) PQXX_NOEXCEPT :
+    m_data(Data),
+    m_size(Size)
+#ifdef PQXX_DEBUG_VIEWS
+    , m_reg()
+#endif
+  {}
+
+  /// View of Size bytes at Data, which belong to Home
+  field_view(const char Data[], size_type Size, const result &Home) :
+    m_data(Data),
+    m_size(Size)
+#ifdef PQXX_DEBUG_VIEWS
+    , m_reg(Home)
+#endif
+  {
+#ifndef PQXX_DEBUG_VIEWS
+    (void)Home;
+#endif
+  }
+
+  /// The text; not necessarily zero-terminated
+  const char *data() const { check(); return m_data; }
+  size_type size() const PQXX_NOEXCEPT { return m_size; }
+  bool empty() const PQXX_NOEXCEPT { return !m_size; }
+
+  const_iterator begin() const { return data(); }
+  const_iterator end() const { return data() + m_size; }
+
+  char operator[](size_type i) const { return data()[i]; }
+
+  /// Compare byte by byte, like std::string::compare()
+  int compare(const field_view &rhs) const
+  {
+    const size_type n = (m_size < rhs.m_size) ? m_size : rhs.m_size;
+    const int c = n ? std::memcmp(data(), rhs.data(), n) : 0;
+    if (c) return c;
+    return (m_size < rhs.m_size) ? -1 : (m_size > rhs.m_size);
+  }
+
+  /// Copy the text into a std::string
+  std::string str() const { return std::string(data(), m_size); }
+
+private:
+#ifdef PQXX_DEBUG_VIEWS
+  void check() const { m_reg.check(); }
+#else
+  void check() const PQXX_NOEXCEPT {}
+#endif
+
+  const char *m_data;
+  size_type m_size;
+#ifdef PQXX_DEBUG_VIEWS
+  internal::view_registration m_reg;
+#endif
+};
+
+inline bool operator==(const field_view &lhs, const field_view &rhs)
+	{ return lhs.size() == rhs.size() && lhs.compare(rhs) == 0; }
+inline bool operator!=(const field_view &lhs, const field_view &rhs)
+	{ return !(lhs == rhs); }
+inline bool operator<(const field_view &lhs, const field_view &rhs)
+	{ return lhs.compare(rhs) < 0; }
+
+inline bool operator==(const field_view &lhs, const char rhs[])
+	{ return lhs == field_view(rhs, std::strlen(rhs)); }
+inline bool operator!=(const field_view &lhs, const char rhs[])
+	{ return !(lhs == rhs); }
+
+inline bool operator==(const field_view &lhs, const std::string &rhs)
+	{ return lhs == field_view(rhs.data(), rhs.size()); }
+inline bool operator!=(const field_view &lhs, const std::string &rhs)
+	{ return !(lhs == rhs); }
+
+inline std::ostream &operator<<(std::ostream &S, const field_view &V)
+	{ return S.write(V.data(), std::streamsize(V.size())); }
+
+
+template<> struct PQXX_LIBEXPORT string_traits<field_view>
+{
+  static const char *name() { return "field_view"; }
+  static bool has_null() { return false; }
+  static bool is_null(const field_view &) { return false; }
+  static field_view null()
+	{ internal::throw_null_conversion(name()); return field_view(); }
+  static void from_string(const char Str[], field_view &Obj)
+	{ Obj = field_view(Str, std::strlen(Str)); }
+  static std::string to_string(const field_view &Obj) { return Obj.str(); }
+};
+
+
 /// Reference to a field in a result set.
 /** A field represents one entry in a row.  It represents an actual value
  * in the result set, and can be converted to various types.
@@ -113,6 +281,10 @@ public:
    */
   const char *c_str() const;						//[t2]
 
+  /// Read as a non-owning view; see field_view for the caveats
+  field_view view() const
+	{ return field_view(c_str(), size(), *home()); }
+
   /// Read value into Obj; or leave Obj untouched and return @c false if null
   template<typename T> bool to(T &Obj) const				//[t3]
   {
@@ -135,6 +307,9 @@ public:
    * use it after the result is destroyed.
    */
   template<> bool to<const char *>(const char *&Obj) const;
+
+  /// Specialization: <tt>to(field_view &)</tt>.
+  template<> bool to<field_view>(field_view &Obj) const;
 #endif
 
   /// Read value into Obj; or use Default & return @c false if null
@@ -171,6 +346,7 @@ public:
 
 
 protected:
+  friend class pqxx::internal::gate::field_binarystring;
   const result *home() const PQXX_NOEXCEPT { return m_home; }
   size_t idx() const PQXX_NOEXCEPT { return m_row; }
   row_size_type col() const PQXX_NOEXCEPT { return m_col; }
@@ -207,6 +383,18 @@ inline bool field::to<const char *>(const char *&Obj) const
   return true;
 }
 
+/// Specialization: <tt>to(field_view &)</tt>.
+/** Like the const char * version, the view is only valid for as long as the
+ * result data.
+ */
+template<>
+inline bool field::to<field_view>(field_view &Obj) const
+{
+  if (is_null()) return false;
+  Obj = view();
+  return true;
+}
+
 
 template<typename CHAR=char, typename TRAITS=std::char_traits<CHAR> >
   class field_streambuf :
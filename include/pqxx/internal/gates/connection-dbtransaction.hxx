@@ -16,6 +16,13 @@ class PQXX_PRIVATE connection_dbtransaction : callgate<connection_base>
 
   int get_reactivation_avoidance_count() const PQXX_NOEXCEPT
 	{ return home().m_reactivation_avoidance.get(); }
+
+  void defer(const std::string &Statement) { home().defer(Statement); }
+  bool cancel_deferred(const std::string &Statement) PQXX_NOEXCEPT
+	{ return home().cancel_deferred(Statement); }
+  void drop_deferred() PQXX_NOEXCEPT { home().drop_deferred(); }
+  result exec_then(const char Query[], const std::string &Then, bool &Done)
+	{ return home().exec_then(Query, Then, Done); }
 };
 } // namespace pqxx::internal::gate
 } // namespace pqxx::internal
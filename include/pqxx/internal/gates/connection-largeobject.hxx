@@ -16,6 +16,7 @@ class PQXX_PRIVATE connection_largeobject : callgate<connection_base>
   connection_largeobject(reference x) : super(x) {}
 
   pq::PGconn *RawConnection() const { return home().RawConnection(); }
+  void flush_deferred() { home().flush_deferred(); }
 };
 } // namespace pqxx::internal::gate
 } // namespace pqxx::internal
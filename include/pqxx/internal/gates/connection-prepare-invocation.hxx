@@ -22,14 +22,16 @@ class PQXX_PRIVATE connection_prepare_invocation : callgate<connection_base>
 	const char *const params[],
 	const int paramlengths[],
 	const int binary[],
-	int nparams)
+	int nparams,
+	int result_format)
   {
     return home().prepared_exec(
 	statement,
 	params,
 	paramlengths,
 	binary,
-	nparams);
+	nparams,
+	result_format);
   }
 
   bool prepared_exists(const std::string &statement) const
@@ -0,0 +1,26 @@
+#include <pqxx/internal/callgate.hxx>
+
+namespace pqxx
+{
+class tablestream;
+
+namespace internal
+{
+namespace gate
+{
+class PQXX_PRIVATE connection_tablestream : callgate<connection_base>
+{
+  friend class pqxx::tablestream;
+
+  connection_tablestream(reference x) : super(x) {}
+
+  void set_nonblocking(bool nonblocking)
+	{ home().set_nonblocking(nonblocking); }
+  bool flush_output() { return home().flush_output(); }
+
+  void wait_read() const { home().wait_read(); }
+  void wait_write() const { home().wait_write(); }
+};
+} // namespace pqxx::internal::gate
+} // namespace pqxx::internal
+} // namespace pqxx
@@ -23,6 +23,8 @@ class PQXX_PRIVATE connection_transaction : callgate<connection_base>
 
   bool ReadCopyLine(std::string &line)
 	{ return home().ReadCopyLine(line); }
+  int TryReadCopyLine(std::string &line)
+	{ return home().TryReadCopyLine(line); }
   void WriteCopyLine(const std::string &line)
 	{ home().WriteCopyLine(line); }
   void EndCopyWrite() { home().EndCopyWrite(); }
@@ -0,0 +1,22 @@
+#include <pqxx/internal/callgate.hxx>
+
+namespace pqxx
+{
+class binarystring;
+
+namespace internal
+{
+namespace gate
+{
+class PQXX_PRIVATE field_binarystring : callgate<const field>
+{
+  friend class pqxx::binarystring;
+
+  field_binarystring(reference x) : super(x) {}
+
+  const result &owner() const { return *home().home(); }
+  int format() const { return owner().column_format(home().num()); }
+};
+} // namespace pqxx::internal::gate
+} // namespace pqxx::internal
+} // namespace pqxx
@@ -2,6 +2,9 @@
 
 namespace pqxx
 {
+class async_query;
+class pipeline;
+
 namespace internal
 {
 namespace gate
@@ -9,6 +12,7 @@ namespace gate
 class PQXX_PRIVATE result_creation : callgate<const result>
 {
   friend class pqxx::connection_base;
+  friend class pqxx::async_query;
   friend class pqxx::pipeline;
 
   result_creation(reference x) : super(x) {}
@@ -0,0 +1,22 @@
+#include <pqxx/internal/callgate.hxx>
+
+namespace pqxx
+{
+namespace internal
+{
+class cursor_block_cache;
+
+namespace gate
+{
+class PQXX_PRIVATE result_cursor_block_cache : callgate<const result>
+{
+  friend class pqxx::internal::cursor_block_cache;
+
+  result_cursor_block_cache(reference x) : super(x) {}
+
+  result copy_rows(const std::vector<row> &rows) const
+	{ return home().copy_rows(rows); }
+};
+} // namespace pqxx::internal::gate
+} // namespace pqxx::internal
+} // namespace pqxx
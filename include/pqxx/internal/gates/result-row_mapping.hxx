@@ -0,0 +1,25 @@
+#include <pqxx/internal/callgate.hxx>
+
+namespace pqxx
+{
+template<typename Target, typename... Fields> class row_mapping;
+
+namespace internal
+{
+namespace gate
+{
+class PQXX_PRIVATE result_row_mapping : callgate<const result>
+{
+  template<typename Target, typename... Fields>
+	friend class pqxx::row_mapping;
+
+  result_row_mapping(reference x) : super(x) {}
+
+  const char *value(result::size_type row, row::size_type col) const
+	{ return home().GetValue(row, col); }
+  bool is_null(result::size_type row, row::size_type col) const
+	{ return home().GetIsNull(row, col); }
+};
+} // namespace pqxx::internal::gate
+} // namespace pqxx::internal
+} // namespace pqxx
@@ -0,0 +1,21 @@
+#include <pqxx/internal/callgate.hxx>
+
+namespace pqxx
+{
+class row_scanner;
+
+namespace internal
+{
+namespace gate
+{
+class PQXX_PRIVATE result_row_scanner : callgate<const result>
+{
+  friend class pqxx::row_scanner;
+
+  result_row_scanner(reference x) : super(x) {}
+
+  const internal::pq::PGresult *data() const { return home().m_data; }
+};
+} // namespace pqxx::internal::gate
+} // namespace pqxx::internal
+} // namespace pqxx
@@ -0,0 +1,21 @@
+#include <pqxx/internal/callgate.hxx>
+
+namespace pqxx
+{
+namespace internal
+{
+class view_registration;
+
+namespace gate
+{
+class PQXX_PRIVATE result_view_registration : callgate<const result>
+{
+  friend class pqxx::internal::view_registration;
+
+  result_view_registration(reference x) : super(x) {}
+
+  const result_data *data() const { return home().get(); }
+};
+} // namespace pqxx::internal::gate
+} // namespace pqxx::internal
+} // namespace pqxx
@@ -0,0 +1,22 @@
+#include <pqxx/internal/callgate.hxx>
+
+namespace pqxx
+{
+class async_query;
+
+namespace internal
+{
+namespace gate
+{
+class PQXX_PRIVATE transaction_async_query : callgate<transaction_base>
+{
+  friend class pqxx::async_query;
+
+  transaction_async_query(reference x) : super(x) {}
+
+  void CheckPendingError() { home().CheckPendingError(); }
+  void activate() { home().activate(); }
+};
+} // namespace pqxx::internal::gate
+} // namespace pqxx::internal
+} // namespace pqxx
@@ -16,6 +16,8 @@ class PQXX_PRIVATE transaction_tablereader : callgate<transaction_base>
 	{ home().BeginCopyRead(table, columns); }
 
   bool ReadCopyLine(std::string &line) { return home().ReadCopyLine(line); }
+  int TryReadCopyLine(std::string &line)
+	{ return home().TryReadCopyLine(line); }
 };
 } // namespace pqxx::internal::gate
 } // namespace pqxx::internal
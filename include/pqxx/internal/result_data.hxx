@@ -2,6 +2,7 @@
 #define PQXX_H_RESULT_DATA
 
 #include <string>
+#include <vector>
 
 #include "pqxx/internal/libpq-forward.hxx"
 
@@ -10,6 +11,7 @@ namespace pqxx
 {
 namespace internal
 {
+class view_registration;
 
 /// Information shared between all copies of a result set
 struct PQXX_PRIVATE result_data
@@ -28,6 +30,15 @@ struct PQXX_PRIVATE result_data
 
   int encoding_code;
 
+  /// Hash table of column names, built on the first lookup by name
+  /** Each slot holds a column number, or -1 if empty.  The number of slots is
+   * a power of two.
+   */
+  mutable std::vector<int> column_index;
+
+  /// Field views registered with this result, if PQXX_DEBUG_VIEWS is used
+  mutable view_registration *views;
+
   // TODO: Locking for result copy-construction etc. also goes here
 
   result_data();
@@ -36,6 +47,12 @@ struct PQXX_PRIVATE result_data
 		const std::string &,
 		int encoding_code);
   ~result_data();
+
+  /// Look up column by name, as PQfnumber() does.  Returns -1 if not found.
+  int column_number(const char name[]) const;
+
+private:
+  void build_column_index() const;
 };
 
 
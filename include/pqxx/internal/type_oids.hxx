@@ -0,0 +1,33 @@
+#ifndef PQXX_H_TYPE_OIDS
+#define PQXX_H_TYPE_OIDS
+
+#include "pqxx/internal/libpq-forward.hxx"
+
+
+namespace pqxx
+{
+namespace internal
+{
+/// Oids of PostgreSQL's built-in types, as in the server's pg_type.h
+const oid
+	oid_bool = 16,
+	oid_char = 18,
+	oid_name = 19,
+	oid_int8 = 20,
+	oid_int2 = 21,
+	oid_int4 = 23,
+	oid_text = 25,
+	oid_oid = 26,
+	oid_float4 = 700,
+	oid_float8 = 701,
+	oid_unknown = 705,
+	oid_bpchar = 1042,
+	oid_varchar = 1043,
+	oid_numeric = 1700;
+
+/// Types with lower oids are built in, and we know what they hold
+const oid first_normal_oid = 10000;
+} // namespace pqxx::internal
+} // namespace pqxx
+
+#endif
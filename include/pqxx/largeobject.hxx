@@ -22,6 +22,7 @@
 #include "pqxx/compiler-public.hxx"
 #include "pqxx/compiler-internal-pre.hxx"
 
+#include <algorithm>
 #include <streambuf>
 
 #include "pqxx/dbtransaction"
@@ -45,6 +46,12 @@ class PQXX_LIBEXPORT largeobject
 public:
   typedef long size_type;
 
+  /// Default buffer size for large object streams
+  /** Every time a stream's buffer fills up or runs dry, that's a round trip to
+   * the server.  A large buffer keeps those rare.
+   */
+  static const size_type default_buffer_size = 1024 * 1024;
+
   /// Refer to a nonexistent large object (similar to what a null pointer does)
   largeobject() PQXX_NOEXCEPT;						//[t48]
 
@@ -67,6 +74,30 @@ public:
    */
   largeobject(dbtransaction &T, const std::string &File);		//[t53]
 
+  /// Create a large object holding the given data
+  /** Sends the data to the server in large chunks, without going through a
+   * file.
+   * @param T Backend transaction in which the large object is to be created
+   * @param Data Contents for the new large object
+   * @param Len Number of bytes in Data
+   */
+  largeobject(dbtransaction &T, const char Data[], size_type Len);
+
+  /// Create a large object holding the contents of an iterator range
+  /** The elements are converted to char, and sent to the server in large
+   * chunks.
+   * @param T Backend transaction in which the large object is to be created
+   */
+  template<typename ITER> largeobject(dbtransaction &T, ITER begin, ITER end);
+
+  /// Create a large object holding everything read from a file descriptor
+  /** Reads until end of file, so this works for pipes and sockets as well as
+   * for files.  The descriptor stays open.
+   * @param T Backend transaction in which the large object is to be created
+   * @param fd File descriptor to read from
+   */
+  static largeobject from_fd(dbtransaction &T, int fd);
+
   /// Take identity of an opened large object
   /** Copy identity of already opened large object.  Note that this may be done
    * as an implicit conversion.
@@ -122,6 +153,28 @@ public:
    */
   void to_file(dbtransaction &T, const std::string &File) const;	//[t52]
 
+  /// Read large object's contents into memory
+  /** Replaces whatever Buf held before.
+   * @param T Transaction in which the object is to be accessed
+   * @param Buf String to receive the object's contents
+   */
+  void to_buffer(dbtransaction &T, std::string &Buf) const;
+
+  /// Copy large object's contents to an output iterator
+  /** @param T Transaction in which the object is to be accessed
+   * @param Out Iterator to write the object's bytes to, as chars
+   * @return The iterator, just past the last byte written
+   */
+  template<typename ITER> ITER to_iterator(dbtransaction &T, ITER Out) const;
+
+  /// Write large object's contents to a file descriptor
+  /** Works for pipes and sockets as well as for files.  The descriptor stays
+   * open.
+   * @param T Transaction in which the object is to be accessed
+   * @param fd File descriptor to write to
+   */
+  void to_fd(dbtransaction &T, int fd) const;
+
   /// Delete large object from database
   /** Unlike its low-level equivalent cunlink, this will throw an exception if
    * deletion fails.
@@ -132,9 +185,15 @@ public:
 protected:
   PQXX_PURE static internal::pq::PGconn *RawConnection(const dbtransaction &T);
 
+  /// Make sure T has begun on the backend, before we go around it.
+  static void ensure_begun(const dbtransaction &T);
+
   std::string Reason(int err) const;
 
 private:
+  /// Delete the object, if possible, after a failure to fill it.
+  void discard(dbtransaction &T) const PQXX_NOEXCEPT;
+
   oid m_ID;
 };
 
@@ -149,6 +208,11 @@ public:
   typedef long off_type;
   typedef size_type pos_type;
 
+  /// Offset in a large object, even one larger than 2 GB
+  typedef long long off64_type;
+  /// Position in a large object, even one larger than 2 GB
+  typedef long long pos64_type;
+
   /// Open mode: @c in, @c out (can be combined with the "or" operator)
   /** According to the C++ standard, these should be in @c std::ios_base.  We
    * take them from @c std::ios instead, which should be safe because it
@@ -257,6 +321,28 @@ public:
    * @return The current position in the large object
    */
   size_type tell() const;						//[t50]
+
+  /// Seek in large object's data stream, even beyond 2 GB
+  /** Throws an exception if an error occurs.  Positions beyond 2 GB require
+   * PostgreSQL 9.3 or newer, both on the server and in the libpq that libpqxx
+   * was built against.
+   * @return The new position in the large object
+   */
+  pos64_type seek64(off64_type dest, seekdir dir);
+
+  /// Report current position in large object's data stream, even beyond 2 GB
+  /** Throws an exception if an error occurs.  Positions beyond 2 GB require
+   * PostgreSQL 9.3 or newer, both on the server and in the libpq that libpqxx
+   * was built against.
+   */
+  pos64_type tell64() const;
+
+  /// Cut off the large object at the given length, or extend it with zeroes
+  /** Throws an exception if an error occurs.  Lengths beyond 2 GB require
+   * PostgreSQL 9.3 or newer, both on the server and in the libpq that libpqxx
+   * was built against.
+   */
+  void truncate(pos64_type Len);
   //@}
 
   /**
@@ -275,7 +361,8 @@ public:
    * @param dir Origin to which dest is relative: ios_base::beg (from beginning
    *        of the object), ios_base::cur (from current access position), or
    *        ios_base;:end (from end of object)
-   * @return New position in large object, or -1 if an error occurred.
+   * @return New position in large object, or -1 if an error occurred.  If the
+   * position does not fit in pos_type, errno is set to ERANGE.
    */
   pos_type cseek(off_type dest, seekdir dir) PQXX_NOEXCEPT;		//[t50]
 
@@ -300,9 +387,31 @@ public:
   /// Report current position in large object's data stream
   /** Does not throw exception in case of error; inspect return value and
    * @c errno instead.
-   * @return Current position in large object, of -1 if an error occurred.
+   * @return Current position in large object, of -1 if an error occurred.  If
+   * the position does not fit in pos_type, errno is set to ERANGE.
    */
   pos_type ctell() const PQXX_NOEXCEPT;					//[t50]
+
+  /// Seek in large object's data stream, even beyond 2 GB
+  /** Does not throw exception in case of error; inspect return value and
+   * @c errno instead.
+   * @return New position in large object, or -1 if an error occurred.
+   */
+  pos64_type cseek64(off64_type dest, seekdir dir) PQXX_NOEXCEPT;
+
+  /// Report current position in large object's data stream, even beyond 2 GB
+  /** Does not throw exception in case of error; inspect return value and
+   * @c errno instead.
+   * @return Current position in large object, of -1 if an error occurred.
+   */
+  pos64_type ctell64() const PQXX_NOEXCEPT;
+
+  /// Cut off the large object at the given length, or extend it with zeroes
+  /** Does not throw exception in case of error; inspect return value and
+   * @c errno instead.
+   * @return Zero on success, or -1 if an error occurred.
+   */
+  int ctruncate(pos64_type Len) PQXX_NOEXCEPT;
   //@}
 
   /**
@@ -324,6 +433,7 @@ public:
 
 private:
   PQXX_PRIVATE std::string Reason(int err) const;
+  PQXX_PRIVATE bool large_offsets() const PQXX_NOEXCEPT;
   internal::pq::PGconn *RawConnection() const
 	{ return largeobject::RawConnection(m_Trans); }
 
@@ -340,6 +450,45 @@ private:
 };
 
 
+template<typename ITER> inline
+largeobject::largeobject(dbtransaction &T, ITER begin, ITER end) :
+  m_ID(largeobject(T).id())
+{
+  try
+  {
+    largeobjectaccess A(T, *this, std::ios::out);
+    std::string Buf;
+    Buf.reserve(std::string::size_type(default_buffer_size));
+    for (; begin != end; ++begin)
+    {
+      Buf += static_cast<char>(*begin);
+      if (Buf.size() >= std::string::size_type(default_buffer_size))
+      {
+        A.write(Buf);
+        Buf.clear();
+      }
+    }
+    if (!Buf.empty()) A.write(Buf);
+  }
+  catch (const std::exception &)
+  {
+    discard(T);
+    throw;
+  }
+}
+
+
+template<typename ITER> inline
+ITER largeobject::to_iterator(dbtransaction &T, ITER Out) const
+{
+  largeobjectaccess A(T, *this, std::ios::in);
+  std::string Buf(std::string::size_type(default_buffer_size), '\0');
+  for (size_type n; (n = A.read(&Buf[0], default_buffer_size)) > 0; )
+    Out = std::copy(Buf.begin(), Buf.begin() + n, Out);
+  return Out;
+}
+
+
 /// Streambuf to use large objects in standard I/O streams
 /** The standard streambuf classes provide uniform access to data storage such
  * as files or string buffers, so they can be accessed using standard input or
@@ -366,7 +515,8 @@ public:
   largeobject_streambuf(dbtransaction &T,
 			largeobject O,
 			openmode mode=std::ios::in|std::ios::out,
-			size_type BufSize=512) :			//[t48]
+			size_type BufSize=
+				largeobject::default_buffer_size) :	//[t48]
     m_BufSize(BufSize),
     m_Obj(T, O, mode),
     m_G(0),
@@ -376,7 +526,8 @@ public:
   largeobject_streambuf(dbtransaction &T,
 			oid O,
 			openmode mode=std::ios::in|std::ios::out,
-			size_type BufSize=512) :			//[t48]
+			size_type BufSize=
+				largeobject::default_buffer_size) :	//[t48]
     m_BufSize(BufSize),
     m_Obj(T, O, mode),
     m_G(0),
@@ -393,9 +544,8 @@ public:
 protected:
   virtual int sync() PQXX_OVERRIDE
   {
-    // setg() sets eback, gptr, egptr
-    this->setg(this->eback(), this->eback(), this->egptr());
-    return overflow(EoF());
+    // Bring the object's position back in line with the stream's.
+    return (write_pending() && drop_read_ahead()) ? 0 : -1;
   }
 
 protected:
@@ -403,11 +553,25 @@ protected:
 			   seekdir dir,
 			   openmode) PQXX_OVERRIDE
   {
+    if (!write_pending()) return AdjustEOF(-1);
+
+    // The object's position is ahead of ours by whatever we read ahead.
+    const off_type ahead = this->egptr() - this->gptr();
+    if (dir == std::ios::cur && !offset)
+    {
+      // Just asking where we are.  Keep the read-ahead.
+      const largeobjectaccess::pos_type here = m_Obj.ctell();
+      return AdjustEOF((here == -1) ? here : here - ahead);
+    }
+    if (dir == std::ios::cur) offset -= ahead;
+    if (m_G) this->setg(m_G, m_G, m_G);
     return AdjustEOF(m_Obj.cseek(largeobjectaccess::off_type(offset), dir));
   }
 
   virtual pos_type seekpos(pos_type pos, openmode) PQXX_OVERRIDE
   {
+    if (!write_pending()) return AdjustEOF(-1);
+    if (m_G) this->setg(m_G, m_G, m_G);
     const largeobjectaccess::pos_type newpos = m_Obj.cseek(
 	largeobjectaccess::off_type(pos),
 	std::ios::beg);
@@ -418,6 +582,7 @@ protected:
   {
     char *const pp = this->pptr();
     if (!pp) return EoF();
+    if (!drop_read_ahead()) return EoF();
     char *const pb = this->pbase();
     int_type res = 0;
 
@@ -436,6 +601,7 @@ protected:
   virtual int_type underflow() PQXX_OVERRIDE
   {
     if (!this->gptr()) return EoF();
+    if (!write_pending()) return EoF();
     char *const eb = this->eback();
     const int_type res(static_cast<int_type>(
 	AdjustEOF(m_Obj.cread(this->eback(), m_BufSize))));
@@ -443,10 +609,97 @@ protected:
     return (!res || (res == EoF())) ? EoF() : *eb;
   }
 
+  virtual std::streamsize xsgetn(char_type *s, std::streamsize n)
+	PQXX_OVERRIDE
+  {
+    std::streamsize done = 0;
+    while (done < n)
+    {
+      const std::streamsize avail = this->egptr() - this->gptr();
+      if (avail > 0)
+      {
+        const std::streamsize chunk = std::min(avail, n - done);
+        traits_type::copy(s + done, this->gptr(), size_t(chunk));
+        this->gbump(int(chunk));
+        done += chunk;
+      }
+      else if (n - done >= m_BufSize)
+      {
+        // Large reads go straight into the caller's memory.
+        if (!this->gptr() || !write_pending()) break;
+        const largeobjectaccess::off_type got =
+		m_Obj.cread(s + done, direct_chunk(n - done));
+        if (got <= 0) break;
+        done += got;
+      }
+      else if (underflow() == EoF())
+      {
+        break;
+      }
+    }
+    return done;
+  }
+
+  virtual std::streamsize xsputn(const char_type *s, std::streamsize n)
+	PQXX_OVERRIDE
+  {
+    if (!this->pptr()) return 0;
+    std::streamsize done = 0;
+    while (done < n)
+    {
+      const std::streamsize left = n - done;
+      if (left <= this->epptr() - this->pptr())
+      {
+        traits_type::copy(this->pptr(), s + done, size_t(left));
+        this->pbump(int(left));
+        done = n;
+      }
+      else if (this->pptr() > this->pbase())
+      {
+        if (overflow(EoF()) == EoF()) break;
+      }
+      else
+      {
+        // Too big for the buffer.  Write it directly.
+        if (!drop_read_ahead()) break;
+        const largeobjectaccess::off_type written =
+		m_Obj.cwrite(s + done, direct_chunk(left));
+        if (written <= 0) break;
+        done += written;
+      }
+    }
+    return done;
+  }
+
 private:
   /// Shortcut for traits_type::eof()
   static int_type EoF() { return traits_type::eof(); }
 
+  /// Largest transfer to make in one go, bypassing the buffer
+  /** The server allocates memory for the full size of a read, even if the
+   * object turns out to be smaller.
+   */
+  static largeobjectaccess::size_type direct_chunk(std::streamsize n)
+  {
+    const std::streamsize max_chunk = 64 * 1024 * 1024;
+    return largeobjectaccess::size_type(std::min(n, max_chunk));
+  }
+
+  /// Write out output we've been holding back.  Returns false on failure.
+  bool write_pending()
+  {
+    return (this->pptr() <= this->pbase()) || (overflow(EoF()) != EoF());
+  }
+
+  /// Forget input we read ahead, and move the object back to where we are.
+  bool drop_read_ahead()
+  {
+    const off_type ahead = this->egptr() - this->gptr();
+    if (m_G) this->setg(m_G, m_G, m_G);
+    return !ahead ||
+	(m_Obj.cseek(largeobjectaccess::off_type(-ahead), std::ios::cur) != -1);
+  }
+
   /// Helper: change error position of -1 to EOF (probably a no-op)
   template<typename INTYPE>
   static std::streampos AdjustEOF(INTYPE pos)
@@ -504,7 +757,8 @@ public:
    */
   basic_ilostream(dbtransaction &T,
                   largeobject O,
-		  largeobject::size_type BufSize=512) :			//[t57]
+		  largeobject::size_type BufSize=
+				largeobject::default_buffer_size) :	//[t57]
     super(0),
     m_Buf(T, O, std::ios::in, BufSize)
 	{ super::init(&m_Buf); }
@@ -517,7 +771,8 @@ public:
    */
   basic_ilostream(dbtransaction &T,
                   oid O,
-		  largeobject::size_type BufSize=512) :			//[t48]
+		  largeobject::size_type BufSize=
+				largeobject::default_buffer_size) :	//[t48]
     super(0),
     m_Buf(T, O, std::ios::in, BufSize)
 	{ super::init(&m_Buf); }
@@ -558,7 +813,8 @@ public:
    */
   basic_olostream(dbtransaction &T,
                   largeobject O,
-		  largeobject::size_type BufSize=512) :			//[t48]
+		  largeobject::size_type BufSize=
+				largeobject::default_buffer_size) :	//[t48]
     super(0),
     m_Buf(T, O, std::ios::out, BufSize)
 	{ super::init(&m_Buf); }
@@ -571,7 +827,8 @@ public:
    */
   basic_olostream(dbtransaction &T,
 		  oid O,
-		  largeobject::size_type BufSize=512) :			//[t57]
+		  largeobject::size_type BufSize=
+				largeobject::default_buffer_size) :	//[t57]
     super(0),
     m_Buf(T, O, std::ios::out, BufSize)
 	{ super::init(&m_Buf); }
@@ -625,7 +882,8 @@ public:
    */
   basic_lostream(dbtransaction &T,
 		 largeobject O,
-		 largeobject::size_type BufSize=512) :			//[t59]
+		 largeobject::size_type BufSize=
+				largeobject::default_buffer_size) :	//[t59]
     super(0),
     m_Buf(T, O, std::ios::in | std::ios::out, BufSize)
 	{ super::init(&m_Buf); }
@@ -638,7 +896,8 @@ public:
    */
   basic_lostream(dbtransaction &T,
 		 oid O,
-		 largeobject::size_type BufSize=512) :			//[t59]
+		 largeobject::size_type BufSize=
+				largeobject::default_buffer_size) :	//[t59]
     super(0),
     m_Buf(T, O, std::ios::in | std::ios::out, BufSize)
 	{ super::init(&m_Buf); }
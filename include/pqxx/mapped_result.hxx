@@ -0,0 +1,459 @@
+/*-------------------------------------------------------------------------
+ *
+ *   FILE
+ *	pqxx/mapped_result.hxx
+ *
+ *   DESCRIPTION
+ *      definitions for the pqxx::mapped_result and related classes.
+ *   Spill query results to disk, and read them back through a memory map.
+ *   DO NOT INCLUDE THIS FILE DIRECTLY; include pqxx/mapped_result instead.
+ *
+ * Copyright (c) 2016, Jeroen T. Vermeulen <jtv@xs4all.nl>
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this mistake,
+ * or contact the author.
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef PQXX_H_MAPPED_RESULT
+#define PQXX_H_MAPPED_RESULT
+
+#include "pqxx/compiler-public.hxx"
+#include "pqxx/compiler-internal-pre.hxx"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "pqxx/result"
+
+
+namespace pqxx
+{
+class icursorstream;
+class mapped_result;
+class mapped_row;
+class const_mapped_result_iterator;
+class const_mapped_row_iterator;
+
+
+/// Writes query results to a file that a mapped_result can read
+/** For exports too big to keep in memory as a result, fetch the data in
+ * blocks, e.g. through a cursor, and spill each block to disk:
+ *
+ * @code
+ * result_spiller spill("/tmp/export.pqxx");
+ * icursorstream cur(T, "SELECT * FROM huge_table", "export", 10000);
+ * spill.read(cur);
+ * spill.finish();
+ *
+ * mapped_result data("/tmp/export.pqxx");
+ * for (mapped_result::size_type i = 0; i < data.size(); ++i) ...
+ * @endcode
+ *
+ * The first result you append defines the columns; all others must have the
+ * same number of columns.  To fix the columns of a query that may return no
+ * rows, start by appending an empty result of the same query, or the result of
+ * a LIMIT 0 version of it.
+ *
+ * The file only becomes valid once you call finish().  If the spiller is
+ * destroyed before that, it deletes the file.
+ *
+ * The file format is meant for temporary storage on the same machine.  It uses
+ * the machine's native byte order, and mapped_result rejects files written
+ * with a different one.
+ */
+class PQXX_LIBEXPORT result_spiller
+{
+public:
+  typedef result::size_type size_type;
+
+  /// Create or overwrite the file at Path
+  explicit result_spiller(const std::string &Path);
+  ~result_spiller() PQXX_NOEXCEPT;
+
+  /// Write all rows of R
+  void append(const result &R);
+
+  /// Read all remaining rows from Stream, and write them.  Returns row count.
+  size_type read(icursorstream &Stream);
+
+  /// Complete and close the file
+  void finish();
+
+  /// Number of rows written so far
+  size_type rows() const PQXX_NOEXCEPT { return m_rows; }
+
+private:
+  PQXX_PRIVATE void write(const void *Data, size_t Len);
+  PQXX_PRIVATE void pad(size_t Alignment);
+  PQXX_PRIVATE void check_open() const;
+  PQXX_PRIVATE void close() PQXX_NOEXCEPT;
+
+  std::string m_path;
+  std::FILE *m_file;
+
+  /// Row offsets, kept in a temporary file until finish()
+  std::FILE *m_index;
+
+  unsigned long long m_pos;
+  size_type m_rows;
+  bool m_have_columns;
+  std::vector<std::string> m_names;
+  std::vector<oid> m_types;
+
+  /// Buffer for composing a row
+  std::vector<char> m_row;
+
+  /// Not allowed
+  result_spiller(const result_spiller &);
+  /// Not allowed
+  result_spiller &operator=(const result_spiller &);
+};
+
+
+/// Field in a mapped_result.  Works like field.
+class PQXX_LIBEXPORT mapped_field
+{
+public:
+  typedef size_t size_type;
+
+  /// Read as zero-terminated C string.  Lives as long as the mapped_result.
+  const char *c_str() const PQXX_NOEXCEPT { return m_text + start(); }
+
+  bool is_null() const PQXX_NOEXCEPT { return (m_ends[m_col] & null_bit) != 0; }
+
+  size_type size() const PQXX_NOEXCEPT
+	{ return is_null() ? 0 : (m_ends[m_col] & ~null_bit) - start() - 1; }
+
+  /// Read as a non-owning view.  Lives as long as the mapped_result.
+  field_view view() const PQXX_NOEXCEPT { return field_view(c_str(), size()); }
+
+  row::size_type num() const PQXX_NOEXCEPT { return m_col; }
+  const char *name() const;
+
+  /// Read value into Obj; or leave Obj untouched and return @c false if null
+  template<typename T> bool to(T &Obj) const
+  {
+    if (is_null()) return false;
+    from_string(c_str(), Obj);
+    return true;
+  }
+
+  /// Read value into Obj; or use Default & return @c false if null
+  template<typename T> bool to(T &Obj, const T &Default) const
+  {
+    const bool NotNull = to(Obj);
+    if (!NotNull) Obj = Default;
+    return NotNull;
+  }
+
+  /// Return value as object of given type, or Default if null
+  template<typename T> T as(const T &Default) const
+  {
+    T Obj;
+    to(Obj, Default);
+    return Obj;
+  }
+
+  /// Return value as object of given type, or throw exception if null
+  template<typename T> T as() const
+  {
+    T Obj;
+    if (!to(Obj)) Obj = string_traits<T>::null();
+    return Obj;
+  }
+
+protected:
+  friend class mapped_row;
+  static const unsigned int null_bit = 0x80000000u;
+
+  mapped_field(
+	const mapped_result &Home,
+	const unsigned int Ends[],
+	const char Text[],
+	row::size_type Col) PQXX_NOEXCEPT :
+    m_home(&Home), m_ends(Ends), m_text(Text), m_col(Col) {}
+
+  size_type start() const PQXX_NOEXCEPT
+	{ return m_col ? (m_ends[m_col - 1] & ~null_bit) : 0; }
+
+  const mapped_result *m_home;
+  const unsigned int *m_ends;
+  const char *m_text;
+  row::size_type m_col;
+};
+
+
+/// Row in a mapped_result.  Works like row.
+class PQXX_LIBEXPORT mapped_row
+{
+public:
+  typedef row::size_type size_type;
+  typedef row::difference_type difference_type;
+  typedef const_mapped_row_iterator const_iterator;
+  typedef const_iterator iterator;
+
+  inline const_iterator begin() const PQXX_NOEXCEPT;
+  inline const_iterator end() const PQXX_NOEXCEPT;
+
+  size_type size() const PQXX_NOEXCEPT { return m_columns; }
+  result::size_type rownumber() const PQXX_NOEXCEPT { return m_index; }
+
+  mapped_field operator[](size_type Col) const PQXX_NOEXCEPT
+	{ return mapped_field(*m_home, m_ends, m_text, Col); }
+  mapped_field operator[](int Col) const PQXX_NOEXCEPT
+	{ return operator[](size_type(Col)); }
+  mapped_field operator[](const char ColName[]) const;
+  mapped_field operator[](const std::string &ColName) const
+	{ return operator[](ColName.c_str()); }
+
+  mapped_field at(size_type Col) const;
+  mapped_field at(int Col) const;
+  mapped_field at(const char ColName[]) const { return operator[](ColName); }
+  mapped_field at(const std::string &ColName) const
+	{ return operator[](ColName.c_str()); }
+
+protected:
+  friend class mapped_result;
+
+  mapped_row(
+	const mapped_result &Home,
+	result::size_type Index,
+	const unsigned char Data[],
+	size_type Columns) PQXX_NOEXCEPT :
+    m_home(&Home),
+    m_index(Index),
+    m_ends(reinterpret_cast<const unsigned int *>(Data)),
+    m_text(reinterpret_cast<const char *>(Data) + Columns * sizeof(int)),
+    m_columns(Columns)
+  {}
+
+  const mapped_result *m_home;
+  result::size_type m_index;
+  const unsigned int *m_ends;
+  const char *m_text;
+  size_type m_columns;
+};
+
+
+/// Iterator for fields in a mapped_row.  Use as mapped_row::const_iterator.
+/** Like const_row_iterator, this is also the field it points to.
+ */
+class PQXX_LIBEXPORT const_mapped_row_iterator :
+  public std::iterator<
+	std::random_access_iterator_tag,
+	const mapped_field,
+	mapped_row::difference_type,
+	const_mapped_row_iterator,
+	mapped_field>,
+  public mapped_field
+{
+public:
+  typedef const mapped_field *pointer;
+  typedef mapped_field reference;
+  typedef mapped_row::size_type size_type;
+  typedef mapped_row::difference_type difference_type;
+
+  pointer operator->() const PQXX_NOEXCEPT { return this; }
+  reference operator*() const PQXX_NOEXCEPT { return mapped_field(*this); }
+
+  const_mapped_row_iterator operator++(int) PQXX_NOEXCEPT
+	{ const_mapped_row_iterator old(*this); ++m_col; return old; }
+  const_mapped_row_iterator &operator++() PQXX_NOEXCEPT
+	{ ++m_col; return *this; }
+  const_mapped_row_iterator operator--(int) PQXX_NOEXCEPT
+	{ const_mapped_row_iterator old(*this); --m_col; return old; }
+  const_mapped_row_iterator &operator--() PQXX_NOEXCEPT
+	{ --m_col; return *this; }
+
+  const_mapped_row_iterator &operator+=(difference_type i) PQXX_NOEXCEPT
+	{ m_col = size_type(difference_type(m_col) + i); return *this; }
+  const_mapped_row_iterator &operator-=(difference_type i) PQXX_NOEXCEPT
+	{ m_col = size_type(difference_type(m_col) - i); return *this; }
+
+  const_mapped_row_iterator operator+(difference_type i) const PQXX_NOEXCEPT
+	{ const_mapped_row_iterator r(*this); return r += i; }
+  const_mapped_row_iterator operator-(difference_type i) const PQXX_NOEXCEPT
+	{ const_mapped_row_iterator r(*this); return r -= i; }
+  difference_type operator-(const const_mapped_row_iterator &i) const
+	PQXX_NOEXCEPT
+	{ return difference_type(m_col) - difference_type(i.m_col); }
+
+  bool operator==(const const_mapped_row_iterator &i) const PQXX_NOEXCEPT
+	{ return m_col == i.m_col; }
+  bool operator!=(const const_mapped_row_iterator &i) const PQXX_NOEXCEPT
+	{ return m_col != i.m_col; }
+  bool operator<(const const_mapped_row_iterator &i) const PQXX_NOEXCEPT
+	{ return m_col < i.m_col; }
+  bool operator<=(const const_mapped_row_iterator &i) const PQXX_NOEXCEPT
+	{ return m_col <= i.m_col; }
+  bool operator>(const const_mapped_row_iterator &i) const PQXX_NOEXCEPT
+	{ return m_col > i.m_col; }
+  bool operator>=(const const_mapped_row_iterator &i) const PQXX_NOEXCEPT
+	{ return m_col >= i.m_col; }
+
+private:
+  friend class mapped_row;
+  explicit const_mapped_row_iterator(const mapped_field &F) PQXX_NOEXCEPT :
+    mapped_field(F) {}
+};
+
+
+/// Iterator for rows in a mapped_result.  Use as mapped_result::const_iterator.
+/** Like const_result_iterator, this is also the row it points to.
+ */
+class PQXX_LIBEXPORT const_mapped_result_iterator :
+  public std::iterator<
+	std::random_access_iterator_tag,
+	const mapped_row,
+	result::difference_type,
+	const_mapped_result_iterator,
+	mapped_row>,
+  public mapped_row
+{
+public:
+  typedef const mapped_row *pointer;
+  typedef mapped_row reference;
+  typedef result::size_type size_type;
+  typedef result::difference_type difference_type;
+
+  pointer operator->() const PQXX_NOEXCEPT { return this; }
+  reference operator*() const PQXX_NOEXCEPT { return mapped_row(*this); }
+
+  const_mapped_result_iterator operator++(int) PQXX_NOEXCEPT
+	{ const_mapped_result_iterator old(*this); ++*this; return old; }
+  const_mapped_result_iterator &operator++() PQXX_NOEXCEPT
+	{ seek(m_index + 1); return *this; }
+  const_mapped_result_iterator operator--(int) PQXX_NOEXCEPT
+	{ const_mapped_result_iterator old(*this); --*this; return old; }
+  const_mapped_result_iterator &operator--() PQXX_NOEXCEPT
+	{ seek(m_index - 1); return *this; }
+
+  const_mapped_result_iterator &operator+=(difference_type i) PQXX_NOEXCEPT
+	{ seek(size_type(difference_type(m_index) + i)); return *this; }
+  const_mapped_result_iterator &operator-=(difference_type i) PQXX_NOEXCEPT
+	{ seek(size_type(difference_type(m_index) - i)); return *this; }
+
+  const_mapped_result_iterator operator+(difference_type i) const
+	PQXX_NOEXCEPT
+	{ const_mapped_result_iterator r(*this); return r += i; }
+  const_mapped_result_iterator operator-(difference_type i) const
+	PQXX_NOEXCEPT
+	{ const_mapped_result_iterator r(*this); return r -= i; }
+  difference_type operator-(const const_mapped_result_iterator &i) const
+	PQXX_NOEXCEPT
+	{ return difference_type(m_index) - difference_type(i.m_index); }
+
+  bool operator==(const const_mapped_result_iterator &i) const PQXX_NOEXCEPT
+	{ return m_index == i.m_index; }
+  bool operator!=(const const_mapped_result_iterator &i) const PQXX_NOEXCEPT
+	{ return m_index != i.m_index; }
+  bool operator<(const const_mapped_result_iterator &i) const PQXX_NOEXCEPT
+	{ return m_index < i.m_index; }
+  bool operator<=(const const_mapped_result_iterator &i) const PQXX_NOEXCEPT
+	{ return m_index <= i.m_index; }
+  bool operator>(const const_mapped_result_iterator &i) const PQXX_NOEXCEPT
+	{ return m_index > i.m_index; }
+  bool operator>=(const const_mapped_result_iterator &i) const PQXX_NOEXCEPT
+	{ return m_index >= i.m_index; }
+
+private:
+  friend class mapped_result;
+  const_mapped_result_iterator(const mapped_result &Home, size_type Index)
+	PQXX_NOEXCEPT :
+    mapped_row(Home, Index, 0, 0)
+	{ seek(Index); }
+
+  /// Move to row Index.  Past the end, only the row number is valid.
+  inline void seek(size_type Index) PQXX_NOEXCEPT;
+};
+
+
+/// Query result stored on disk, read through a memory map
+/** Reads a file written by result_spiller.  Access to rows and fields works
+ * much like it does in result, but the data stays on disk: the operating
+ * system pages it in as needed, and can evict it again under memory pressure.
+ * So you can revisit result sets larger than the available memory, at random,
+ * at the speed of the page cache.
+ *
+ * Column names are matched literally, not case-folded as in result.
+ */
+class PQXX_LIBEXPORT mapped_result
+{
+public:
+  typedef result::size_type size_type;
+  typedef result::difference_type difference_type;
+  typedef const_mapped_result_iterator const_iterator;
+  typedef const_iterator iterator;
+
+  /// Open and map the file at Path
+  explicit mapped_result(const std::string &Path);
+  ~mapped_result() PQXX_NOEXCEPT;
+
+  size_type size() const PQXX_NOEXCEPT { return m_rows; }
+  bool empty() const PQXX_NOEXCEPT { return !m_rows; }
+  row::size_type columns() const PQXX_NOEXCEPT { return m_columns; }
+
+  const_iterator begin() const PQXX_NOEXCEPT
+	{ return const_iterator(*this, 0); }
+  const_iterator end() const PQXX_NOEXCEPT
+	{ return const_iterator(*this, m_rows); }
+
+  mapped_row operator[](size_type Row) const PQXX_NOEXCEPT
+	{ return mapped_row(*this, Row, m_base + m_index[Row], m_columns); }
+  mapped_row at(size_type Row) const;
+
+  const char *column_name(row::size_type Col) const;
+  oid column_type(row::size_type Col) const;
+
+  /// Number of given column (throws exception if it doesn't exist)
+  row::size_type column_number(const char ColName[]) const;
+  row::size_type column_number(const std::string &ColName) const
+	{ return column_number(ColName.c_str()); }
+
+private:
+  PQXX_PRIVATE void unmap() PQXX_NOEXCEPT;
+
+  const unsigned char *m_base;
+  unsigned long long m_length;
+  size_type m_rows;
+  row::size_type m_columns;
+  const unsigned long long *m_index;
+  std::vector<const char *> m_names;
+  std::vector<oid> m_types;
+#ifdef _WIN32
+  void *m_file;
+  void *m_mapping;
+#endif
+
+  /// Not allowed
+  mapped_result(const mapped_result &);
+  /// Not allowed
+  mapped_result &operator=(const mapped_result &);
+};
+
+
+inline const char *mapped_field::name() const
+	{ return m_home->column_name(m_col); }
+
+inline mapped_row::const_iterator mapped_row::begin() const PQXX_NOEXCEPT
+	{ return const_iterator(operator[](size_type(0))); }
+
+inline mapped_row::const_iterator mapped_row::end() const PQXX_NOEXCEPT
+	{ return const_iterator(operator[](m_columns)); }
+
+inline void const_mapped_result_iterator::seek(size_type Index) PQXX_NOEXCEPT
+{
+  const mapped_result &Home = *m_home;
+  if (Index < Home.size()) mapped_row::operator=(Home[Index]);
+  else m_index = Index;
+}
+
+} // namespace pqxx
+
+
+#include "pqxx/compiler-internal-post.hxx"
+
+#endif
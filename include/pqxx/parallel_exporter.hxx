@@ -0,0 +1,170 @@
+/*-------------------------------------------------------------------------
+ *
+ *   FILE
+ *	pqxx/parallel_exporter.hxx
+ *
+ *   DESCRIPTION
+ *      definition of the pqxx::parallel_exporter class.
+ *   Reads a table through several connections at once, from one snapshot
+ *   DO NOT INCLUDE THIS FILE DIRECTLY; include pqxx/parallel_exporter instead.
+ *
+ * Copyright (c) 2016, Jeroen T. Vermeulen <jtv@xs4all.nl>
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this mistake,
+ * or contact the author.
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef PQXX_H_PARALLEL_EXPORTER
+#define PQXX_H_PARALLEL_EXPORTER
+
+#include "pqxx/compiler-public.hxx"
+#include "pqxx/compiler-internal-pre.hxx"
+
+#include <string>
+#include <vector>
+
+#include "pqxx/tablereader"
+
+
+namespace pqxx
+{
+
+/// Read a table through several connections in parallel, consistently
+/** A single COPY runs on a single backend.  A parallel_exporter splits a table
+ * into partitions, and reads each partition through its own connection, so the
+ * backends can do the work in parallel.
+ *
+ * All connections see the same snapshot of the database: the first connection
+ * exports its snapshot (see pg_export_snapshot() in the PostgreSQL manual) and
+ * the others import it.  So the combined output is exactly what a single
+ * transaction would have seen, even while other sessions modify the table.
+ *
+ * By default the table is split into ranges of physical pages ("ctid ranges"),
+ * one per connection.  Alternatively, pass your own conditions to partition().
+ *
+ * @warning Only PostgreSQL 14 and up can scan a ctid range directly.  Older
+ * servers run each partition's query as a full sequential scan that filters on
+ * ctid, so with N connections the table gets read N times.  On those servers,
+ * pass conditions on an indexed key to partition() instead.
+ *
+ * Rows come out in no particular order.  You can read them as one merged
+ * stream through get_raw_line(), or have them delivered to a sink.  Either way,
+ * everything happens in the calling thread: the exporter reads from whichever
+ * connection has data, and only waits when none of them do.
+ *
+ * @code
+ * pqxx::connection c1, c2, c3, c4;
+ * pqxx::parallel_exporter exporter("mytable");
+ * exporter.add_connection(c1);
+ * exporter.add_connection(c2);
+ * exporter.add_connection(c3);
+ * exporter.add_connection(c4);
+ * std::string line;
+ * while (exporter.get_raw_line(line)) process(line);
+ * @endcode
+ *
+ * @warning Don't use the connections for anything else while the exporter is
+ * active.
+ */
+class PQXX_LIBEXPORT parallel_exporter
+{
+public:
+  typedef unsigned long size_type;
+
+  /// Receiver for exported rows.  See export_to().
+  class PQXX_LIBEXPORT PQXX_NOVTABLE sink
+  {
+  public:
+    virtual ~sink() =0;
+
+    /// Accept one row in COPY text format, read through the given connection.
+    /** Connections are numbered from zero, in the order they were added.
+     */
+    virtual void operator()(const std::string &line, size_type shard) =0;
+  };
+
+  explicit parallel_exporter(const std::string &Table);
+
+  /// Export only the given columns, in the given order.
+  template<typename ITER> parallel_exporter(const std::string &Table,
+	ITER begincolumns,
+	ITER endcolumns);
+
+  ~parallel_exporter() PQXX_NOEXCEPT;
+
+  /// Add a connection to read through.  The first one exports its snapshot.
+  void add_connection(connection_base &);
+
+  /// Number of connections in use.
+  size_type connections() const PQXX_NOEXCEPT { return m_conns.size(); }
+
+  /// Partition the table using one SQL condition per connection.
+  /** The conditions go into WHERE clauses, and should between them cover every
+   * row exactly once, e.g. "id % 4 = 0", "id % 4 = 1", and so on.  Call this
+   * after adding the connections, and before reading any data.
+   */
+  void partition(const std::vector<std::string> &conditions);
+
+  /// Read a row from any of the connections.  Returns false at the end.
+  bool get_raw_line(std::string &Line);
+
+  /// Read a row, and report which connection it came through.
+  bool get_raw_line(std::string &Line, size_type &Source);
+
+  /// Deliver all remaining rows to s.
+  void export_to(sink &s);
+
+  /// Finish the export, and close the transactions.
+  void complete();
+
+  /// Number of rows read so far.
+  size_type rows() const PQXX_NOEXCEPT { return m_rows; }
+
+private:
+  class shard;
+
+  PQXX_PRIVATE void start();
+  PQXX_PRIVATE std::vector<std::string> ctid_partitions(transaction_base &);
+  PQXX_PRIVATE void close() PQXX_NOEXCEPT;
+
+  std::string m_table;
+  std::string m_columns;
+  std::vector<connection_base *> m_conns;
+  std::vector<std::string> m_conditions;
+  std::vector<shard *> m_shards;
+  std::vector<shard *>::size_type m_next;
+  size_type m_live;
+  size_type m_rows;
+  bool m_started;
+
+  /// Not allowed
+  parallel_exporter(const parallel_exporter &);
+  /// Not allowed
+  parallel_exporter &operator=(const parallel_exporter &);
+};
+
+
+template<typename ITER> inline
+parallel_exporter::parallel_exporter(const std::string &Table,
+	ITER begincolumns,
+	ITER endcolumns) :
+  m_table(Table),
+  m_columns(separated_list(",", begincolumns, endcolumns)),
+  m_conns(),
+  m_conditions(),
+  m_shards(),
+  m_next(0),
+  m_live(0),
+  m_rows(0),
+  m_started(false)
+{
+}
+
+} // namespace pqxx
+
+
+#include "pqxx/compiler-internal-post.hxx"
+
+#endif
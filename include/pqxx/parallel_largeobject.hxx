@@ -0,0 +1,182 @@
+/*-------------------------------------------------------------------------
+ *
+ *   FILE
+ *	pqxx/parallel_largeobject.hxx
+ *
+ *   DESCRIPTION
+ *      definition of the pqxx::parallel_largeobject class.
+ *   Transfers a large object through several connections at once
+ *   DO NOT INCLUDE THIS FILE DIRECTLY; include pqxx/parallel_largeobject
+ *   instead.
+ *
+ * Copyright (c) 2016, Jeroen T. Vermeulen <jtv@xs4all.nl>
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this mistake,
+ * or contact the author.
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef PQXX_H_PARALLEL_LARGEOBJECT
+#define PQXX_H_PARALLEL_LARGEOBJECT
+
+#include "pqxx/compiler-public.hxx"
+#include "pqxx/compiler-internal-pre.hxx"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "pqxx/largeobject"
+
+
+namespace pqxx
+{
+
+/// A parallel_largeobject write that committed only some of its data
+/** The write's connections commit one after another.  If one of them fails
+ * after others have committed, the object holds part of the new data.  This
+ * exception says which part.
+ */
+class PQXX_LIBEXPORT partial_write_error : public failure
+{
+public:
+  /// Range of bytes in the object: from first up to, but not including, second
+  typedef std::pair<long long, long long> range;
+
+  /// Ranges are sorted and merged; the message lists them after whatarg
+  partial_write_error(
+	const std::string &whatarg,
+	const std::vector<range> &Committed,
+	const std::vector<range> &InDoubt);
+  virtual ~partial_write_error() PQXX_NOEXCEPT;
+
+  /// Byte ranges that were definitely committed
+  const std::vector<range> &committed() const PQXX_NOEXCEPT
+	{ return m_committed; }
+
+  /// Byte ranges whose commit was cut off by a lost connection
+  /** These may or may not have been committed.  All bytes that are in neither
+   * committed() nor in_doubt() were definitely not written.
+   */
+  const std::vector<range> &in_doubt() const PQXX_NOEXCEPT
+	{ return m_in_doubt; }
+
+private:
+  std::vector<range> m_committed, m_in_doubt;
+};
+
+
+/// Read or write a large object through several connections in parallel
+/** Through a single connection, a large object transfer goes one round trip
+ * at a time, and one backend does all the work.  A parallel_largeobject splits
+ * the object into chunks, and transfers them through as many connections as
+ * you give it, each running its own transaction.  The chunks go through the
+ * server-side lo_get() and lo_put() functions, so this needs PostgreSQL 9.4 or
+ * newer.
+ *
+ * All of this happens in the calling thread.  Each connection has one chunk in
+ * flight at a time, and the transfer only waits when all of them are busy.
+ *
+ * @code
+ * pqxx::connection c1, c2, c3, c4;
+ * pqxx::parallel_largeobject transfer(object_id);
+ * transfer.add_connection(c1);
+ * transfer.add_connection(c2);
+ * transfer.add_connection(c3);
+ * transfer.add_connection(c4);
+ * transfer.to_file("/tmp/object.bin");
+ * @endcode
+ *
+ * When reading, all connections see the same snapshot of the database: the
+ * first connection exports its snapshot, and the others import it.
+ *
+ * When writing, the object must already exist, and be committed, so that all
+ * connections can see it.  Each chunk covers whole large object pages, so no
+ * two connections ever modify the same page.
+ *
+ * A write is not atomic.  Each connection commits its own transaction, one
+ * after the other.  If the first commit fails, nothing was written, and you
+ * get that commit's error.  If a later one fails, the chunks written through
+ * the connections before it are committed, and the rest are not.  The write
+ * then throws partial_write_error, which tells you exactly which byte ranges
+ * made it.  If you need all-or-nothing, write through a single connection.
+ *
+ * Data travels in PostgreSQL's hex format for binary data, which doubles its
+ * size on the wire.
+ *
+ * @warning Don't use the connections for anything else while a transfer is in
+ * progress.
+ */
+class PQXX_LIBEXPORT parallel_largeobject
+{
+public:
+  typedef largeobjectaccess::pos64_type size_type;
+
+  /// Transfer the given large object in chunks of roughly ChunkSize bytes.
+  explicit parallel_largeobject(oid Object, size_type ChunkSize=1024*1024);
+
+  ~parallel_largeobject() PQXX_NOEXCEPT;
+
+  /// Add a connection to transfer data through.
+  void add_connection(connection_base &);
+
+  /// Number of connections in use.
+  std::vector<connection_base *>::size_type connections() const PQXX_NOEXCEPT
+	{ return m_conns.size(); }
+
+  /// Read the whole object into Buf, replacing what was there.
+  void read(std::string &Buf);
+
+  /// Read the whole object into a file on the client's filesystem.
+  void to_file(const std::string &File);
+
+  /// Write Len bytes into the object, starting at its beginning.
+  /** Any data in the object beyond the first Len bytes stays as it was.
+   */
+  void write(const char Buf[], size_type Len);
+
+  /// Write a string into the object, starting at its beginning.
+  void write(const std::string &Buf)
+	{ write(Buf.data(), size_type(Buf.size())); }
+
+  /// Write the contents of a file on the client's filesystem into the object.
+  void from_file(const std::string &File);
+
+  /// Number of bytes transferred so far.
+  size_type bytes() const PQXX_NOEXCEPT { return m_bytes; }
+
+private:
+  class shard;
+  class endpoint;
+  class memory_endpoint;
+  class file_endpoint;
+
+  PQXX_PRIVATE void start(bool Writing);
+  PQXX_PRIVATE size_type object_size();
+  PQXX_PRIVATE void transfer(endpoint &, size_type Size, bool Writing);
+  PQXX_PRIVATE void issue(shard &, endpoint &, size_type Size, bool Writing);
+  PQXX_PRIVATE void commit();
+  PQXX_PRIVATE void close() PQXX_NOEXCEPT;
+
+  oid m_object;
+  size_type m_chunk;
+  std::vector<connection_base *> m_conns;
+  std::vector<shard *> m_shards;
+
+  /// Offset of the first chunk that hasn't been sent yet
+  size_type m_next;
+  size_type m_bytes;
+
+  /// Not allowed
+  parallel_largeobject(const parallel_largeobject &);
+  /// Not allowed
+  parallel_largeobject &operator=(const parallel_largeobject &);
+};
+
+} // namespace pqxx
+
+
+#include "pqxx/compiler-internal-post.hxx"
+
+#endif
@@ -0,0 +1,170 @@
+/*-------------------------------------------------------------------------
+ *
+ *   FILE
+ *	pqxx/parallel_loader.hxx
+ *
+ *   DESCRIPTION
+ *      definition of the pqxx::parallel_loader class.
+ *   Bulk-loads a table through several connections at once
+ *   DO NOT INCLUDE THIS FILE DIRECTLY; include pqxx/parallel_loader instead.
+ *
+ * Copyright (c) 2016, Jeroen T. Vermeulen <jtv@xs4all.nl>
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this mistake,
+ * or contact the author.
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef PQXX_H_PARALLEL_LOADER
+#define PQXX_H_PARALLEL_LOADER
+
+#include "pqxx/compiler-public.hxx"
+#include "pqxx/compiler-internal-pre.hxx"
+
+#include <string>
+#include <vector>
+
+#include "pqxx/tablewriter"
+
+
+namespace pqxx
+{
+
+/// Load data into a table through several connections in parallel
+/** A single COPY runs on a single backend, so it can only keep one server CPU
+ * busy.  A parallel_loader spreads rows across as many connections as you give
+ * it, each running its own transaction and COPY, so the backends can process
+ * the data in parallel.
+ *
+ * All of this happens in the calling thread.  The loader puts each connection
+ * in nonblocking mode, and hands each row to the next connection that can take
+ * more data; it only waits when all of them are busy sending.
+ *
+ * @code
+ * pqxx::connection c1, c2, c3, c4;
+ * pqxx::parallel_loader loader("mytable");
+ * loader.add_connection(c1);
+ * loader.add_connection(c2);
+ * loader.add_connection(c3);
+ * loader.add_connection(c4);
+ * loader.load(rows.begin(), rows.end());
+ * loader.commit();
+ * @endcode
+ *
+ * The loader commits either all of its transactions or none of them, except
+ * in one case: if a connection fails while the transactions are being
+ * committed, some of them may already have committed while others can't.  In
+ * that case commit() throws in_doubt_error.  The order of rows in the table is
+ * unspecified.
+ *
+ * @warning Don't use the connections for anything else while the loader is
+ * active.
+ */
+class PQXX_LIBEXPORT parallel_loader
+{
+public:
+  typedef unsigned long size_type;
+
+  explicit parallel_loader(const std::string &Table,
+	const std::string &Null=std::string());
+
+  /// Load only the given columns, in the given order.
+  template<typename ITER> parallel_loader(const std::string &Table,
+	ITER begincolumns,
+	ITER endcolumns,
+	const std::string &Null=std::string());
+
+  /// Destructor.  Aborts all transactions, unless commit() was called.
+  ~parallel_loader() PQXX_NOEXCEPT;
+
+  /// Add a connection to load data through.
+  /** Starts a transaction and a COPY on the connection.  Add all your
+   * connections before you start writing data, or the first connections will
+   * get more data than the later ones.
+   */
+  void add_connection(connection_base &);
+
+  /// Number of connections in use.
+  size_type connections() const PQXX_NOEXCEPT { return m_shards.size(); }
+
+  /// Write one row, given as a container of fields.
+  template<typename TUPLE> void insert(const TUPLE &);
+
+  /// Write a range of rows, where each row is a container of fields.
+  template<typename ITER> void load(ITER begin, ITER end);
+
+  /// Write one row in PostgreSQL's COPY text format.
+  void write_raw_line(const std::string &);
+
+  /// Finish loading, and commit all transactions.
+  void commit();
+
+  /// Abort all transactions.
+  void abort() PQXX_NOEXCEPT;
+
+  /// Number of rows written so far.
+  size_type rows() const PQXX_NOEXCEPT { return m_rows; }
+
+  /// Number of bytes of COPY data written so far.
+  /** Divide by elapsed time to get the loader's throughput.
+   */
+  unsigned long long bytes() const PQXX_NOEXCEPT { return m_bytes; }
+
+private:
+  class shard;
+
+  PQXX_PRIVATE bool flush_shards();
+
+  std::string m_table;
+  std::vector<std::string> m_columns;
+  std::string m_null;
+  std::vector<shard *> m_shards;
+  std::vector<shard *>::size_type m_next;
+  size_type m_rows;
+  unsigned long long m_bytes;
+  bool m_finished;
+
+  /// Not allowed
+  parallel_loader(const parallel_loader &);
+  /// Not allowed
+  parallel_loader &operator=(const parallel_loader &);
+};
+
+
+template<typename ITER> inline
+parallel_loader::parallel_loader(const std::string &Table,
+	ITER begincolumns,
+	ITER endcolumns,
+	const std::string &Null) :
+  m_table(Table),
+  m_columns(begincolumns, endcolumns),
+  m_null(Null),
+  m_shards(),
+  m_next(0),
+  m_rows(0),
+  m_bytes(0),
+  m_finished(false)
+{
+}
+
+
+template<typename TUPLE> inline void parallel_loader::insert(const TUPLE &T)
+{
+  typedef typename TUPLE::const_iterator iter;
+  write_raw_line(
+	separated_list("\t", T.begin(), T.end(), internal::Escaper<iter>(m_null)));
+}
+
+
+template<typename ITER> inline void parallel_loader::load(ITER begin, ITER end)
+{
+  for (; begin != end; ++begin) insert(*begin);
+}
+
+} // namespace pqxx
+
+
+#include "pqxx/compiler-internal-post.hxx"
+
+#endif
@@ -129,6 +129,18 @@ public:
   /// Execute!
   result exec() const;
 
+  /// Execute, receiving the result in binary format
+  /** Fields then hold the server's internal representation of their values,
+   * not text.  For bytea this saves the server the work of encoding, the
+   * network half the traffic, and the client the work of decoding: a
+   * binarystring built from a binary field just points into the result.
+   *
+   * @warning Other types do not convert from binary format.  Only use this
+   * for statements that return just bytea columns, or where you read the
+   * other columns' raw binary data yourself.
+   */
+  result exec_binary() const;
+
   /// Has a statement of this name been defined?
   bool exists() const;
 
@@ -205,6 +217,8 @@ private:
   std::vector<bool> m_nonnull;
 
   invocation &setparam(const std::string &, bool nonnull);
+
+  PQXX_PRIVATE result execute(int result_format) const;
 };
 
 
@@ -24,9 +24,11 @@
 
 #include <ios>
 #include <stdexcept>
+#include <vector>
 
 #include "pqxx/internal/result_data.hxx"
 
+#include "pqxx/column"
 #include "pqxx/except"
 #include "pqxx/field"
 #include "pqxx/row"
@@ -45,7 +47,11 @@ namespace gate
 {
 class result_connection;
 class result_creation;
+class result_cursor_block_cache;
+class result_row_mapping;
+class result_row_scanner;
 class result_sql_cursor;
+class result_view_registration;
 } // namespace internal::gate
 } // namespace internal
 
@@ -159,6 +165,13 @@ public:
   oid column_type(const char ColName[]) const				//[t7]
 	{ return column_type(column_number(ColName)); }
 
+  /// Format of given column: 0 for text, 1 for binary
+  int column_format(row::size_type ColNum) const;
+
+  /// Format of given column: 0 for text, 1 for binary
+  int column_format(int ColNum) const
+	{ return column_format(row::size_type(ColNum)); }
+
   /// What table did this column come from?
   oid column_table(row::size_type ColNum) const;			//[t2]
 
@@ -182,6 +195,40 @@ public:
 	{ return table_column(column_number(ColName)); }
   //@}
 
+  /**
+   * @name Columnar access
+   */
+  //@{
+  /// Convert a whole column to values of type T, stored contiguously
+  /** Converts each field only once.  Use this when you'll be scanning the same
+   * columns repeatedly, or want to pass them to code that works on arrays.
+   */
+  template<typename T> void to_column(row::size_type ColNum, column<T> &Out)
+	const;
+
+  /// Convert a whole column to values of type T, stored contiguously
+  template<typename T> void to_column(const std::string &ColName,
+	column<T> &Out) const
+	{ to_column(column_number(ColName), Out); }
+  //@}
+
+  /**
+   * @name Serialization
+   */
+  //@{
+  /// Write columns and data to a compact binary blob, e.g. for caching
+  /** The blob uses the machine's native byte order.  Only the data and column
+   * descriptions go into it: the number of affected rows and the oid of an
+   * inserted row do not survive.
+   */
+  std::string serialize() const;
+
+  /// Reconstruct a result from the output of serialize()
+  /** Throws failure if the blob is not valid.
+   */
+  static result deserialize(const std::string &Blob);
+  //@}
+
   /// Query that produced this result, if available (empty string otherwise)
   PQXX_PURE const std::string &query() const PQXX_NOEXCEPT;		//[t70]
 
@@ -205,6 +252,7 @@ private:
   PQXX_PURE field::size_type GetLength(
 	size_type,
 	row::size_type) const PQXX_NOEXCEPT;
+  friend class pqxx::internal::gate::result_row_mapping;
 
   friend class pqxx::internal::gate::result_creation;
   result(internal::pq::PGresult *rhs,
@@ -226,6 +274,15 @@ private:
   friend class pqxx::internal::gate::result_sql_cursor;
   PQXX_PURE const char *CmdStatus() const PQXX_NOEXCEPT;
 
+  friend class pqxx::internal::gate::result_view_registration;
+
+  friend class pqxx::internal::gate::result_cursor_block_cache;
+  /// New result with this one's columns, holding copies of the given rows
+  /** The rows may come from other results, but their columns must match.
+   */
+  result copy_rows(const std::vector<row> &) const;
+
+  friend class pqxx::internal::gate::result_row_scanner;
   /// Shortcut: pointer to result data
   pqxx::internal::pq::PGresult *m_data;
 
@@ -484,6 +541,32 @@ inline result::difference_type
 const_result_iterator::operator-(const_result_iterator i) const
 	{ return result::difference_type(num() - i.num()); }
 
+template<typename T>
+inline void result::to_column(row::size_type ColNum, column<T> &Out) const
+{
+  if (ColNum >= columns())
+    throw range_error("Invalid column number: " + to_string(ColNum));
+
+  const size_type Rows = size();
+  column<T> Col;
+  Col.reserve(Rows);
+  T Value;
+  for (size_type i = 0; i < Rows; ++i)
+  {
+    if (GetIsNull(i, ColNum))
+    {
+      Col.push_null();
+    }
+    else
+    {
+      from_string(GetValue(i, ColNum), Value);
+      Col.push_back(Value);
+    }
+  }
+  Out.swap(Col);
+}
+
+
 inline const_result_iterator result::end() const PQXX_NOEXCEPT
 	{ return const_result_iterator(this, size()); }
 
@@ -0,0 +1,196 @@
+/*-------------------------------------------------------------------------
+ *
+ *   FILE
+ *	pqxx/result_cache.hxx
+ *
+ *   DESCRIPTION
+ *      definitions for the pqxx::result_cache class and its storage interface.
+ *   Client-side caching of query results, through a pluggable store.
+ *   DO NOT INCLUDE THIS FILE DIRECTLY; include pqxx/result_cache instead.
+ *
+ * Copyright (c) 2016, Jeroen T. Vermeulen <jtv@xs4all.nl>
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this mistake,
+ * or contact the author.
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef PQXX_H_RESULT_CACHE
+#define PQXX_H_RESULT_CACHE
+
+#include "pqxx/compiler-public.hxx"
+#include "pqxx/compiler-internal-pre.hxx"
+
+#include <ctime>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "pqxx/result"
+
+
+namespace pqxx
+{
+class transaction_base;
+
+
+/// Storage for a result_cache: maps keys to serialized results
+/** Implement this to share cached results between processes, e.g. through
+ * shared memory or a local cache daemon.  Keys and blobs are arbitrary byte
+ * strings; keys can get long, so a store may want to hash them.
+ */
+class PQXX_LIBEXPORT PQXX_NOVTABLE result_store
+{
+public:
+  virtual ~result_store() =0;
+
+  /// Look up Key.  If present and not expired, set Blob and return true.
+  virtual bool get(const std::string &Key, std::string &Blob) =0;
+
+  /// Store Blob under Key, to expire after TTL seconds
+  virtual void put(
+	const std::string &Key,
+	const std::string &Blob,
+	unsigned long TTL) =0;
+
+  /// Forget Key, if present
+  virtual void remove(const std::string &Key) =0;
+};
+
+
+/// result_store in the process's own memory
+/** Keeps at most a given number of bytes' worth of results.  When a new result
+ * does not fit, it drops expired entries first, then those closest to expiry.
+ *
+ * Like the rest of libpqxx, this is not thread-safe.
+ */
+class PQXX_LIBEXPORT memory_result_store : public result_store
+{
+public:
+  explicit memory_result_store(size_t MaxBytes=64*1024*1024);
+
+  virtual bool get(const std::string &Key, std::string &Blob) PQXX_OVERRIDE;
+  virtual void put(
+	const std::string &Key,
+	const std::string &Blob,
+	unsigned long TTL) PQXX_OVERRIDE;
+  virtual void remove(const std::string &Key) PQXX_OVERRIDE;
+
+  /// Forget all entries
+  void clear() PQXX_NOEXCEPT;
+
+  /// Number of bytes in keys and blobs currently stored
+  size_t bytes() const PQXX_NOEXCEPT { return m_bytes; }
+
+  size_t entries() const PQXX_NOEXCEPT { return m_entries.size(); }
+
+private:
+  typedef std::multimap<std::time_t, std::string> expiry_type;
+  struct entry
+  {
+    std::string blob;
+    std::time_t expires;
+    /// This entry's place in m_expiry
+    expiry_type::iterator by_expiry;
+  };
+  typedef std::map<std::string, entry> map_type;
+
+  PQXX_PRIVATE void erase(map_type::iterator) PQXX_NOEXCEPT;
+  PQXX_PRIVATE void make_room(size_t Bytes) PQXX_NOEXCEPT;
+
+  map_type m_entries;
+  /// Keys of m_entries, ordered by expiry time
+  expiry_type m_expiry;
+  size_t m_bytes;
+  size_t m_max_bytes;
+};
+
+
+/// Client-side cache of query results
+/** For queries that return the same data over and over, such as lookups of
+ * reference data, a result_cache saves the round trip to the server.  Results
+ * are stored in serialized form (see result::serialize()) in a result_store,
+ * keyed by the query and its parameters, and expire after a given time.
+ *
+ * @code
+ * memory_result_store store;
+ * result_cache cache(store, 300);
+ * const result countries = cache.exec(T, "SELECT * FROM country");
+ * @endcode
+ *
+ * The cache knows nothing about transactions or changes to the data.  A cached
+ * result may be up to its time-to-live out of date, and may reflect changes
+ * that your current transaction cannot see, or miss ones it can.  Only cache
+ * data that can live with that.
+ *
+ * A deserialized result holds no information on affected rows or inserted
+ * oids; don't cache modifying statements.
+ *
+ * A store may be shared by caches for different databases, e.g. when it lives
+ * in shared memory.  Give each such cache its own key namespace, such as the
+ * database name, so that one database's results never answer another's
+ * queries.
+ */
+class PQXX_LIBEXPORT result_cache
+{
+public:
+  /// Cache results in Store, to expire after TTL seconds
+  /** Keys are stored with Namespace as a prefix, so caches with different
+   * namespaces can share a store without seeing each other's entries.
+   */
+  result_cache(
+	result_store &Store,
+	unsigned long TTL,
+	const std::string &Namespace=std::string());
+
+  /// Execute Query, or take its result from the cache
+  result exec(transaction_base &T, const std::string &Query);
+
+  /// Execute parameterized Query, or take its result from the cache
+  result exec(
+	transaction_base &T,
+	const std::string &Query,
+	const std::vector<std::string> &Params);
+
+  /// Look up a result by key.  Returns false on a miss.
+  bool lookup(const std::string &Key, result &Out);
+
+  /// Store a result under the given key
+  void store(const std::string &Key, const result &R);
+
+  /// Drop the cached result for Query and Params, if any
+  void invalidate(
+	const std::string &Query,
+	const std::vector<std::string> &Params=std::vector<std::string>());
+
+  /// Cache key for a query and its parameters
+  static std::string make_key(
+	const std::string &Query,
+	const std::vector<std::string> &Params=std::vector<std::string>());
+
+  const std::string &key_namespace() const PQXX_NOEXCEPT
+	{ return m_namespace; }
+
+  unsigned long ttl() const PQXX_NOEXCEPT { return m_ttl; }
+  void set_ttl(unsigned long TTL) PQXX_NOEXCEPT { m_ttl = TTL; }
+
+  unsigned long hits() const PQXX_NOEXCEPT { return m_hits; }
+  unsigned long misses() const PQXX_NOEXCEPT { return m_misses; }
+
+private:
+  /// Key as it goes into the store: prefixed with the namespace, if any
+  PQXX_PRIVATE std::string stored_key(const std::string &Key) const;
+
+  result_store &m_store;
+  std::string m_namespace;
+  unsigned long m_ttl;
+  unsigned long m_hits, m_misses;
+};
+
+} // namespace pqxx
+
+
+#include "pqxx/compiler-internal-post.hxx"
+
+#endif
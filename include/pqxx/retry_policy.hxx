@@ -0,0 +1,136 @@
+/*-------------------------------------------------------------------------
+ *
+ *   FILE
+ *	pqxx/retry_policy.hxx
+ *
+ *   DESCRIPTION
+ *      definition of the pqxx::retry_policy class.
+ *   Decides whether and when connection_base::perform() retries a transactor
+ *   DO NOT INCLUDE THIS FILE DIRECTLY; include pqxx/retry_policy instead.
+ *
+ * Copyright (c) 2016, Jeroen T. Vermeulen <jtv@xs4all.nl>
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this mistake,
+ * or contact the author.
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef PQXX_H_RETRY_POLICY
+#define PQXX_H_RETRY_POLICY
+
+#include "pqxx/compiler-public.hxx"
+#include "pqxx/compiler-internal-pre.hxx"
+
+#include <map>
+#include <stdexcept>
+#include <string>
+
+
+namespace pqxx
+{
+
+/// Rules for retrying a failed transactor
+/** connection_base::perform(T, Attempts) retries a failed transactor right
+ * away, whatever went wrong.  When many clients contend for the same rows,
+ * that only makes the contention worse.  Passing a retry_policy to perform()
+ * instead makes it retry only errors where another attempt may succeed, and
+ * wait a little before each retry:
+ *
+ * - Only transaction_rollback errors (such as serialization_failure and
+ *   deadlock_detected) and broken_connection are retried.  Override
+ *   retryable() to change this.
+ * - Before retry number n (counting from zero), perform() waits for a random
+ *   time between zero and InitialDelay * 2^n milliseconds, but never more than
+ *   MaxDelay.  The randomness keeps clients that failed together from
+ *   retrying together.
+ * - If the wait would take perform() past its Deadline, counted from the
+ *   start of the first attempt, it gives up instead.
+ *
+ * The policy also counts retries, per transactor name, so you can monitor
+ * them.  Give each transactor type its own name to get a count per type.
+ *
+ * A retry_policy is not thread-safe.  Give each thread its own.
+ *
+ * @code
+ * retry_policy policy(10, 20, 2000, 10000);
+ * C.perform(transfer_funds(from, to, amount), policy);
+ * std::cout << policy.retries("transfer_funds") << std::endl;
+ * @endcode
+ */
+class PQXX_LIBEXPORT retry_policy
+{
+public:
+  typedef std::map<std::string, unsigned long> stats_type;
+
+  /**
+   * @param MaxAttempts Maximum number of attempts, including the first.
+   * @param InitialDelay Maximum wait before the first retry, in milliseconds.
+   * @param MaxDelay Upper limit to any wait, in milliseconds.
+   * @param Deadline Time limit for all attempts together, in milliseconds, or
+   * zero for no limit.
+   */
+  explicit retry_policy(
+	int MaxAttempts=5,
+	unsigned long InitialDelay=10,
+	unsigned long MaxDelay=1000,
+	unsigned long Deadline=0);
+
+  virtual ~retry_policy();
+
+  int max_attempts() const PQXX_NOEXCEPT { return m_max_attempts; }
+  unsigned long initial_delay() const PQXX_NOEXCEPT { return m_initial_delay; }
+  unsigned long max_delay() const PQXX_NOEXCEPT { return m_max_delay; }
+  unsigned long deadline() const PQXX_NOEXCEPT { return m_deadline; }
+
+  /// Is an attempt that failed with this error worth repeating?
+  virtual bool retryable(const std::exception &) const;
+
+  /// Pick a wait time before retry number Retry, counting from zero
+  unsigned long backoff(int Retry);
+
+  /// Number of retries so far of transactors called Name
+  unsigned long retries(const std::string &Name) const;
+
+  /// Number of retries so far, per transactor name
+  const stats_type &stats() const PQXX_NOEXCEPT { return m_retries; }
+
+  /// Reset retry counts to zero
+  void clear_stats() PQXX_NOEXCEPT { m_retries.clear(); }
+
+  /// Note the start of a perform() call.  For use by perform().
+  void start() PQXX_NOEXCEPT;
+
+  /// Decide whether to retry after a failed attempt.  For use by perform().
+  /** If the answer is yes, counts the retry and waits before returning.
+   * @param Error The error that the attempt failed with.
+   * @param Attempt Number of the attempt that failed, starting at 1.
+   * @param Name The transactor's name.
+   */
+  bool retry(const std::exception &Error, int Attempt, const std::string &Name);
+
+protected:
+  /// Wait for the given number of milliseconds
+  virtual void sleep(unsigned long Msec);
+
+private:
+  int m_max_attempts;
+  unsigned long m_initial_delay;
+  unsigned long m_max_delay;
+  unsigned long m_deadline;
+
+  /// Start time of the current perform() call, from internal::clock_msec()
+  unsigned long m_start;
+
+  /// State of the pseudorandom number generator for jitter
+  unsigned long m_seed;
+
+  stats_type m_retries;
+};
+
+} // namespace pqxx
+
+
+#include "pqxx/compiler-internal-post.hxx"
+
+#endif
@@ -70,6 +70,7 @@ private:
   PQXX_PRIVATE std::string sql_delete() const;
   PQXX_PRIVATE void DeleteTransactionRecord() PQXX_NOEXCEPT;
   PQXX_PRIVATE bool CheckTransactionRecord();
+  PQXX_PRIVATE bool CheckTransactionStatus();
 };
 
 
@@ -95,6 +96,13 @@ private:
  * due to the added work and complexity.  What robusttransaction tries to
  * achieve is to be more deterministic, not more successful per se.
  *
+ * On PostgreSQL 10 and better, the server itself can say whether a given
+ * transaction committed, through its txid_status() function.  There,
+ * robusttransaction only notes its transaction's id, which it obtains in the
+ * same round trip as the one that starts the transaction, and costs little
+ * more than a regular transaction.  The rest of this description applies to
+ * older servers, where robusttransaction falls back to a log table.
+ *
  * When a user first uses a robusttransaction in a database, the class will
  * attempt to create a log table there to keep vital transaction-related state
  * information in.  This table, located in that same database, will be called
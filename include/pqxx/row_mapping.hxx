@@ -0,0 +1,270 @@
+/*-------------------------------------------------------------------------
+ *
+ *   FILE
+ *	pqxx/row_mapping.hxx
+ *
+ *   DESCRIPTION
+ *      definitions for the pqxx::row_mapping class template.
+ *   Converts whole results to tuples or structs, checking column types once.
+ *   DO NOT INCLUDE THIS FILE DIRECTLY; include pqxx/row_mapping instead.
+ *
+ * Copyright (c) 2016, Jeroen T. Vermeulen <jtv@xs4all.nl>
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this mistake,
+ * or contact the author.
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef PQXX_H_ROW_MAPPING
+#define PQXX_H_ROW_MAPPING
+
+#include "pqxx/compiler-public.hxx"
+#include "pqxx/compiler-internal-pre.hxx"
+
+#include "pqxx/result"
+
+
+namespace pqxx
+{
+namespace internal
+{
+/// Kinds of values that a C++ type can be read from
+enum column_kind
+{
+  column_any,		///< Anything; conversion is checked per field
+  column_bool,		///< boolean
+  column_integer,	///< Integral numbers
+  column_floating	///< Any number
+};
+
+/// Throw usage_error if column Col can't hold values of the given kind
+/** Only rejects PostgreSQL's built-in types whose values can never convert,
+ * such as a timestamp read as an integer.  Text types, numbers read as
+ * integers, and other types such as domains may or may not hold suitable
+ * values; those are checked as they are converted.
+ */
+PQXX_LIBEXPORT void check_column_kind(
+	const result &R,
+	row::size_type Col,
+	column_kind Kind,
+	const char TypeName[]);
+} // namespace pqxx::internal
+} // namespace pqxx
+
+
+/* The row_mapping template itself needs variadic templates.  Without them,
+ * this header defines nothing else.  It is not included by pqxx/pqxx.
+ */
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1800)
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "pqxx/internal/gates/result-row_mapping.hxx"
+
+
+namespace pqxx
+{
+namespace internal
+{
+template<typename T> struct column_kind_of :
+  std::integral_constant<column_kind,
+	std::is_same<T, bool>::value ? column_bool :
+	std::is_integral<T>::value ? column_integer :
+	std::is_floating_point<T>::value ? column_floating :
+	column_any>
+{
+};
+
+template<std::size_t... I> struct index_list {};
+
+template<std::size_t N, std::size_t... I> struct make_index_list :
+  make_index_list<N-1, N-1, I...>
+{
+};
+
+template<std::size_t... I> struct make_index_list<0, I...>
+{
+  typedef index_list<I...> type;
+};
+} // namespace pqxx::internal
+
+
+/// Field of a row_mapping: data member M of struct S, of type T
+/** Use the PQXX_MEMBER macro to name one without repeating its type.
+ */
+template<typename S, typename T, T S::*M> struct member
+{
+  typedef T type;
+  static T &get(S &Obj) PQXX_NOEXCEPT { return Obj.*M; }
+};
+
+/// Field of a row_mapping for a struct: PQXX_MEMBER(employee, salary)
+#define PQXX_MEMBER(S, m) pqxx::member<S, decltype(S::m), &S::m>
+
+/// Field of a row_mapping: element I of a std::tuple
+template<typename Tuple, std::size_t I> struct tuple_field
+{
+  typedef typename std::tuple_element<I, Tuple>::type type;
+  static type &get(Tuple &Obj) PQXX_NOEXCEPT { return std::get<I>(Obj); }
+};
+
+
+/// Compile-time mapping of result columns onto the fields of a C++ type
+/** Reading a row field by field, through field::as(), looks up each field and
+ * checks its type separately.  A row_mapping reads whole results at once.  It
+ * checks the number of columns, and their types as far as it can, once per
+ * result.  Then it decodes each row through a loop that the compiler can
+ * specialise and inline for your type.
+ *
+ * Column i goes into the i-th of Fields.  Each field descriptor names a type,
+ * and gets a reference to its place in a Target object.  Use PQXX_MEMBER for
+ * struct members, or the tuple_mapping shorthand for tuples:
+ *
+ * @code
+ * struct employee { int id; std::string name; double salary; };
+ *
+ * typedef pqxx::row_mapping<employee,
+ *	PQXX_MEMBER(employee, id),
+ *	PQXX_MEMBER(employee, name),
+ *	PQXX_MEMBER(employee, salary)> employee_mapping;
+ *
+ * std::vector<employee> staff;
+ * employee_mapping::to_vector(T.exec("SELECT id, name, salary FROM e"), staff);
+ *
+ * const pqxx::result R = T.exec("SELECT id, name FROM emp");
+ * for (auto &t : pqxx::as_tuples<int, std::string>(R)) ...
+ * @endcode
+ *
+ * Null fields are handled as in field::as(): reading one into a type that has
+ * no null value throws an exception.
+ *
+ * This needs a compiler with variadic templates (C++11 or better).  It is not
+ * included by pqxx/pqxx, so include pqxx/row_mapping yourself.
+ */
+template<typename Target, typename... Fields> class row_mapping
+{
+public:
+  typedef Target value_type;
+
+  /// Check that R's columns match the mapping.  Throws usage_error if not.
+  static void check(const result &R)
+  {
+    if (R.columns() != sizeof...(Fields))
+      throw usage_error(
+	"Mapping result with " + to_string(R.columns()) + " columns "
+	"onto " + to_string(sizeof...(Fields)) + " fields");
+    check_fields<0, Fields...>(R);
+  }
+
+  /// Read row Row of R into Out.  Does not check(); do that first.
+  static void read(const result &R, result::size_type Row, Target &Out)
+  {
+    read_fields<0, Fields...>(internal::gate::result_row_mapping(R), Row, Out);
+  }
+
+  /// Read all rows of R into Out, reusing its memory where possible
+  /** Out ends up with exactly one element per row.  If a conversion fails, an
+   * exception is thrown and Out is left in an unspecified but valid state.
+   */
+  static void to_vector(const result &R, std::vector<Target> &Out)
+  {
+    check(R);
+    const result::size_type Rows = R.size();
+    Out.resize(Rows);
+    const internal::gate::result_row_mapping G(R);
+    for (result::size_type r = 0; r < Rows; ++r)
+      read_fields<0, Fields...>(G, r, Out[r]);
+  }
+
+  /// Read all rows of R
+  static std::vector<Target> to_vector(const result &R)
+  {
+    std::vector<Target> Out;
+    to_vector(R, Out);
+    return Out;
+  }
+
+private:
+  template<row::size_type Col> static void check_fields(const result &) {}
+
+  template<row::size_type Col, typename F, typename... Rest>
+  static void check_fields(const result &R)
+  {
+    typedef typename F::type T;
+    internal::check_column_kind(
+	R,
+	Col,
+	internal::column_kind_of<T>::value,
+	string_traits<T>::name());
+    check_fields<Col+1, Rest...>(R);
+  }
+
+  template<row::size_type Col> static void read_fields(
+	const internal::gate::result_row_mapping &,
+	result::size_type,
+	Target &)
+  {
+  }
+
+  template<row::size_type Col, typename F, typename... Rest>
+  static void read_fields(
+	const internal::gate::result_row_mapping &G,
+	result::size_type Row,
+	Target &Out)
+  {
+    typedef typename F::type T;
+    T &Obj = F::get(Out);
+    const char *const bytes = G.value(Row, Col);
+    if (!bytes[0] && G.is_null(Row, Col)) Obj = string_traits<T>::null();
+    else from_string(bytes, Obj);
+    read_fields<Col+1, Rest...>(G, Row, Out);
+  }
+};
+
+
+namespace internal
+{
+template<typename Tuple, typename Indexes> struct tuple_mapping_for;
+
+template<typename Tuple, std::size_t... I>
+struct tuple_mapping_for<Tuple, index_list<I...> >
+{
+  typedef row_mapping<Tuple, tuple_field<Tuple, I>...> type;
+};
+} // namespace pqxx::internal
+
+
+/// row_mapping that reads rows as std::tuple<T...>
+template<typename... T> using tuple_mapping =
+  typename internal::tuple_mapping_for<
+	std::tuple<T...>,
+	typename internal::make_index_list<sizeof...(T)>::type>::type;
+
+
+/// Read all rows of R as tuples, reusing Out's memory where possible
+template<typename... T>
+inline void to_tuples(const result &R, std::vector<std::tuple<T...> > &Out)
+{
+  tuple_mapping<T...>::to_vector(R, Out);
+}
+
+
+/// Read all rows of R as tuples: as_tuples<int, std::string>(R)
+template<typename... T>
+inline std::vector<std::tuple<T...> > as_tuples(const result &R)
+{
+  return tuple_mapping<T...>::to_vector(R);
+}
+
+} // namespace pqxx
+
+#endif // variadic templates
+
+
+#include "pqxx/compiler-internal-post.hxx"
+
+#endif
@@ -0,0 +1,132 @@
+/*-------------------------------------------------------------------------
+ *
+ *   FILE
+ *	pqxx/row_scanner.hxx
+ *
+ *   DESCRIPTION
+ *      definitions for the pqxx::row_scanner class.
+ *   Fast sequential access to the fields of a result, row by row.
+ *   DO NOT INCLUDE THIS FILE DIRECTLY; include pqxx/row_scanner instead.
+ *
+ * Copyright (c) 2016, Jeroen T. Vermeulen <jtv@xs4all.nl>
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this mistake,
+ * or contact the author.
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef PQXX_H_ROW_SCANNER
+#define PQXX_H_ROW_SCANNER
+
+#include "pqxx/compiler-public.hxx"
+#include "pqxx/compiler-internal-pre.hxx"
+
+#include <vector>
+
+#include "pqxx/result"
+
+
+namespace pqxx
+{
+
+/// Fast sequential access to the fields of a result, row by row
+/** Iterating a result through its iterators is convenient, but every step
+ * constructs row and field objects, and every access to a field's contents
+ * goes back through the result into libpq.
+ *
+ * A row_scanner instead looks up the locations of all of a row's values at
+ * once, when you move to that row.  After that, reading fields is just a
+ * matter of indexing into arrays, or bumping pointers across them:
+ *
+ * @code
+ * row_scanner s(R);
+ * while (s.next())
+ * {
+ *   const char *const *v = s.values();
+ *   const int *len = s.lengths();
+ *   for (row::size_type c = 0; c < s.columns(); ++c)
+ *     if (len[c] >= 0) process(v[c], len[c]);
+ * }
+ * @endcode
+ *
+ * The scanner keeps a reference to the result's data, so the pointers it gives
+ * out stay valid for at least as long as the scanner itself.
+ */
+class PQXX_LIBEXPORT row_scanner
+{
+public:
+  typedef result::size_type size_type;
+
+  /// Create a scanner for R.  It starts before the first row.
+  explicit row_scanner(const result &R);
+
+  /// Move to the next row.  Returns false if there are no more rows.
+  bool next();
+
+  /// Move to the given row, or before the first row if given -1
+  void seek(result::difference_type Row);
+
+  /// Number of the current row
+  result::difference_type row_number() const PQXX_NOEXCEPT
+	{ return result::difference_type(m_next) - 1; }
+
+  row::size_type columns() const PQXX_NOEXCEPT { return m_columns; }
+
+  /**
+   * @name Current row
+   * Only valid after next() has returned true.
+   */
+  //@{
+  /// Pointers to the current row's values, one per column
+  /** Values are zero-terminated.  A null value points to an empty string.
+   */
+  const char *const *values() const PQXX_NOEXCEPT
+	{ return m_columns ? &m_values[0] : 0; }
+
+  /// Lengths of the current row's values, one per column; -1 for null
+  const int *lengths() const PQXX_NOEXCEPT
+	{ return m_columns ? &m_lengths[0] : 0; }
+
+  const char *c_str(row::size_type Col) const PQXX_NOEXCEPT
+	{ return m_values[Col]; }
+
+  bool is_null(row::size_type Col) const PQXX_NOEXCEPT
+	{ return m_lengths[Col] < 0; }
+
+  field::size_type size(row::size_type Col) const PQXX_NOEXCEPT
+	{ return is_null(Col) ? 0 : field::size_type(m_lengths[Col]); }
+
+  field_view view(row::size_type Col) const
+	{ return field_view(m_values[Col], size(Col), m_home); }
+
+  /// Read value into Obj; or leave Obj untouched and return false if null
+  template<typename T> bool to(row::size_type Col, T &Obj) const
+  {
+    if (is_null(Col)) return false;
+    from_string(m_values[Col], Obj);
+    return true;
+  }
+  //@}
+
+private:
+  PQXX_PRIVATE void load_row(size_type);
+
+  result m_home;
+  const internal::pq::PGresult *m_data;
+  row::size_type m_columns;
+  size_type m_rows;
+
+  /// Number of the row after the current one
+  size_type m_next;
+
+  std::vector<const char *> m_values;
+  std::vector<int> m_lengths;
+};
+
+} // namespace pqxx
+
+
+#include "pqxx/compiler-internal-post.hxx"
+
+#endif
@@ -82,6 +82,17 @@ namespace pqxx
  * There are no isolation levels inside a transaction.  They are not needed
  * because all actions within the same backend transaction are always performed
  * sequentially anyway.
+ *
+ * Each subtransaction normally costs up to two extra round trips to the
+ * server: one to create its savepoint, and one to release it or roll back to
+ * it.  When wrapping many small steps in subtransactions, e.g. one per row to
+ * keep a bad row from spoiling the whole batch, that adds up.  With deferred
+ * BEGIN (see connection_base::set_deferred_begin()), a subtransaction sends
+ * its savepoint along with its first statement, and the release or rollback
+ * along with the next statement after it, for no extra round trips at all.
+ * Subtransactions at the same nesting depth then also reuse the same savepoint
+ * name.  The catch is that a failure to release or roll back shows up as an
+ * error in that next statement.
  */
 class PQXX_LIBEXPORT subtransaction :
   public internal::transactionfocus,
@@ -103,7 +114,18 @@ private:
   virtual void do_commit() PQXX_OVERRIDE;				//[t88]
   virtual void do_abort() PQXX_OVERRIDE;				//[t88]
 
+  PQXX_PRIVATE void set_up_savepoint();
+
   dbtransaction &m_parent;
+
+  /// Nesting depth: 1 for a subtransaction of a regular transaction
+  int m_depth;
+
+  /// Are the savepoint commands sent along with other statements?
+  bool m_deferred;
+
+  /// Precomputed SQL commands to create, release, and roll back savepoint
+  std::string m_savepoint, m_release, m_rollback;
 };
 
 }
@@ -24,6 +24,20 @@
 #include "pqxx/tablestream"
 namespace pqxx
 {
+namespace internal
+{
+/// Decode one field of a line in COPY's text format, starting at position i
+/** Leaves i just past the tab that ends the field, or past the end of the
+ * line if it was the line's last field.
+ * @return Whether the field is non-null.  A null field leaves Field empty.
+ */
+PQXX_LIBEXPORT bool extract_copy_field(
+	const std::string &Line,
+	std::string::size_type &i,
+	std::string &Field);
+} // namespace pqxx::internal
+
+
 /// @deprecated Efficiently pull data directly out of a table.
 /** @warning This class does not work reliably with multibyte encodings.  Using
  * it with some multi-byte encodings may pose a security risk.
@@ -49,6 +63,13 @@ public:
   operator bool() const PQXX_NOEXCEPT { return !m_Done; }
   bool operator!() const PQXX_NOEXCEPT { return m_Done; }
   bool get_raw_line(std::string &Line);
+  /// Read a line if one has arrived, without waiting.
+  /** Returns true if it read a line.  Returns false if no complete line is
+   * available yet, or if the stream has ended: check operator bool to tell
+   * which.  If the stream is still running, wait for sock() to become readable
+   * before trying again.
+   */
+  bool try_get_raw_line(std::string &Line);
   template<typename TUPLE>
   void tokenize(std::string, TUPLE &) const;
   virtual void complete() PQXX_OVERRIDE;
@@ -33,15 +33,35 @@ public:
 	      const std::string &Null=std::string());
   virtual ~tablestream() PQXX_NOEXCEPT =0;
   virtual void complete() =0;
+
+  /// Don't let libpq block on the socket while this stream is open.
+  /** In nonblocking mode, an event loop can drive several streams (on separate
+   * connections) from a single thread: wait on each stream's sock(), and use
+   * the try_ functions in tablereader and tablewriter.  The connection goes
+   * back to blocking mode when the stream closes.
+   */
+  void set_nonblocking(bool);
+  bool is_nonblocking() const PQXX_NOEXCEPT { return m_Nonblocking; }
+
+  /// Socket that an event loop should wait on, or -1 if none.
+  int sock() const PQXX_NOEXCEPT;
+
+  /// Send whatever queued output the socket will take; is any left over?
+  /** If so, wait for sock() to become writable before trying again.
+   */
+  bool wants_write();
 protected:
   const std::string &NullStr() const { return m_Null; }
   bool is_finished() const PQXX_NOEXCEPT { return m_Finished; }
   void base_close();
+  void wait_read() const;
+  void wait_write() const;
   template<typename ITER>
   static std::string columnlist(ITER colbegin, ITER colend);
 private:
   std::string m_Null;
   bool m_Finished;
+  bool m_Nonblocking;
   tablestream();
   tablestream(const tablestream &);
   tablestream &operator=(const tablestream &);
@@ -60,11 +60,19 @@ public:
   template<typename TUPLE> std::string generate(const TUPLE &) const;
   virtual void complete() PQXX_OVERRIDE;
   void write_raw_line(const std::string &);
+  /// Write a line unless too much earlier output is still waiting to be sent.
+  /** Meant for nonblocking mode.  If this returns false, nothing was written;
+   * wait for sock() to become writable, and try again.
+   */
+  bool try_write_raw_line(const std::string &);
 private:
   void setup(transaction_base &,
       const std::string &WName,
       const std::string &Columns = std::string());
   PQXX_PRIVATE void writer_close();
+
+  /// Bytes written since output buffer was last found to be empty
+  std::string::size_type m_Unflushed;
 };
 } // namespace pqxx
 namespace std
@@ -102,7 +110,8 @@ template<typename ITER> inline tablewriter::tablewriter(transaction_base &T,
     ITER begincolumns,
     ITER endcolumns) :
   namedclass("tablewriter", WName),
-  tablestream(T, std::string())
+  tablestream(T, std::string()),
+  m_Unflushed(0)
 {
   setup(T, WName, columnlist(begincolumns, endcolumns));
 }
@@ -112,7 +121,8 @@ template<typename ITER> inline tablewriter::tablewriter(transaction_base &T,
     ITER endcolumns,
     const std::string &Null) :
   namedclass("tablewriter", WName),
-  tablestream(T, Null)
+  tablestream(T, Null),
+  m_Unflushed(0)
 {
   setup(T, WName, columnlist(begincolumns, endcolumns));
 }
@@ -47,6 +47,8 @@ protected:
 
 private:
   virtual void do_commit() PQXX_OVERRIDE;				//[t1]
+  virtual result do_exec_and_commit(const char Query[]) PQXX_OVERRIDE;
+  PQXX_NORETURN PQXX_PRIVATE void lost_connection(const std::exception &);
 };
 
 
@@ -111,6 +111,7 @@ namespace internal
 {
 namespace gate
 {
+class transaction_async_query;
 class transaction_subtransaction;
 class transaction_tablereader;
 class transaction_tablewriter;
@@ -242,6 +243,27 @@ public:
 	      const std::string &Desc=std::string())
 	{ return exec(Query.str(), Desc); }
 
+  /// Execute a final query, and commit
+  /** Does the same as exec() followed by commit(), but where the transaction
+   * type allows, the query and the commit go to the server in a single round
+   * trip.  If the BEGIN is also still pending (see
+   * connection_base::set_deferred_begin()), a transaction consisting of just
+   * this query takes only one round trip in all.
+   *
+   * Query should be a single SQL statement.
+   *
+   * If the query fails, the transaction is aborted and the query's error
+   * thrown, as with exec().  If the commit fails, the error is thrown as with
+   * commit().  If the connection is lost while the commit may have been under
+   * way, in_doubt_error is thrown, also as with commit().
+   *
+   * @param Query Query or command to execute
+   * @param Desc Optional identifier for query, to help pinpoint SQL errors
+   * @return A result set describing the query's or command's result
+   */
+  result exec_and_commit(const std::string &Query,
+	const std::string &Desc=std::string());
+
   /// Parameterize a statement.
   /* Use this to build up a parameterized statement invocation, then invoke it
    * using @c exec()
@@ -367,6 +389,8 @@ protected:
   virtual void do_commit() =0;
   /// To be implemented by derived implementation class: abort transaction
   virtual void do_abort() =0;
+  /// Perform final query and commit.  Default does do_exec(), then do_commit()
+  virtual result do_exec_and_commit(const char Query[]);
 
   // For use by implementing class:
 
@@ -438,6 +462,7 @@ private:
   friend class pqxx::internal::gate::transaction_tablereader;
   PQXX_PRIVATE void BeginCopyRead(const std::string &, const std::string &);
   bool ReadCopyLine(std::string &);
+  int TryReadCopyLine(std::string &);
 
   friend class pqxx::internal::gate::transaction_tablewriter;
   PQXX_PRIVATE void BeginCopyWrite(
@@ -448,6 +473,8 @@ private:
 
   friend class pqxx::internal::gate::transaction_subtransaction;
 
+  friend class pqxx::internal::gate::transaction_async_query;
+
   connection_base &m_Conn;
 
   internal::unique<internal::transactionfocus> m_Focus;
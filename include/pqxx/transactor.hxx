@@ -23,6 +23,7 @@
 #include "pqxx/compiler-internal-pre.hxx"
 
 #include "pqxx/connection_base"
+#include "pqxx/retry_policy"
 #include "pqxx/transaction"
 
 
@@ -183,6 +184,46 @@ inline void pqxx::connection_base::perform(const TRANSACTOR &T,
 }
 
 
+template<typename TRANSACTOR>
+inline void pqxx::connection_base::perform(const TRANSACTOR &T,
+                                           retry_policy &Policy)
+{
+  Policy.start();
+  for (int Attempt = 1; ; ++Attempt)
+  {
+    // Work on a copy of T2 so we can restore the starting situation if need be
+    TRANSACTOR T2(T);
+    try
+    {
+      typename TRANSACTOR::argument_type X(*this, T2.Name());
+      T2(X);
+      X.commit();
+    }
+    catch (const in_doubt_error &)
+    {
+      // Not sure whether transaction went through or not.  The last thing in
+      // the world that we should do now is retry.
+      T2.on_doubt();
+      throw;
+    }
+    catch (const std::exception &e)
+    {
+      T2.on_abort(e.what());
+      if (!Policy.retry(e, Attempt, T2.Name())) throw;
+      continue;
+    }
+    catch (...)
+    {
+      // Don't try to forge ahead if we don't even know what happened
+      T2.on_abort("Unknown exception");
+      throw;
+    }
+    T2.on_commit();
+    return;
+  }
+}
+
+
 #include "pqxx/compiler-internal-post.hxx"
 
 #endif
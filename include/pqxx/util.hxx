@@ -717,6 +717,18 @@ private:
  */
 PQXX_LIBEXPORT void sleep_seconds(int);
 
+/// Sleep for the given number of milliseconds
+/** May return early, e.g. when interrupted by a signal.
+ */
+PQXX_LIBEXPORT void sleep_msec(unsigned long);
+
+/// Milliseconds elapsed since some arbitrary point in time
+/** Only useful for measuring intervals.  The value wraps around, so compute
+ * differences as unsigned longs.  Where the system has a monotonic clock, the
+ * value does not jump when someone sets the system's wall clock.
+ */
+PQXX_LIBEXPORT unsigned long clock_msec() PQXX_NOEXCEPT;
+
 /// Work around problem with library export directives and pointers
 typedef const char *cstring;
 
@@ -0,0 +1,373 @@
+/*-------------------------------------------------------------------------
+ *
+ *   FILE
+ *	arrow.cxx
+ *
+ *   DESCRIPTION
+ *      implementation of the pqxx::arrow_batch class and related types.
+ *   Converts query results and COPY streams to Apache Arrow memory layout
+ *
+ * Copyright (c) 2016, Jeroen T. Vermeulen <jtv@xs4all.nl>
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this mistake,
+ * or contact the author.
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "pqxx/compiler-internal.hxx"
+
+#include <cstring>
+
+#include "pqxx/arrow"
+#include "pqxx/tablereader"
+
+#include "pqxx/internal/type_oids.hxx"
+
+using namespace pqxx::internal;
+
+
+namespace
+{
+// Arrow's integer types have fixed sizes.
+typedef char short_is_16_bits[(sizeof(short) == 2) ? 1 : -1];
+typedef char int_is_32_bits[(sizeof(int) == 4) ? 1 : -1];
+typedef char long_long_is_64_bits[(sizeof(long long) == 8) ? 1 : -1];
+} // namespace
+
+
+pqxx::arrow_type pqxx::arrow_type_for(oid Type) PQXX_NOEXCEPT
+{
+  switch (Type)
+  {
+  case oid_bool: return arrow_boolean;
+  case oid_int2: return arrow_int16;
+  case oid_int4: return arrow_int32;
+  case oid_int8:
+  case oid_oid: return arrow_int64;
+  case oid_float4: return arrow_float32;
+  case oid_float8: return arrow_float64;
+  default: return arrow_large_utf8;
+  }
+}
+
+
+const char *pqxx::arrow_format(arrow_type Type) PQXX_NOEXCEPT
+{
+  switch (Type)
+  {
+  case arrow_boolean: return "b";
+  case arrow_int16: return "s";
+  case arrow_int32: return "i";
+  case arrow_int64: return "l";
+  case arrow_float32: return "f";
+  case arrow_float64: return "g";
+  case arrow_large_utf8: return "U";
+  }
+  return "U";
+}
+
+
+pqxx::arrow_column::arrow_column(const std::string &Name, oid Type) :
+  m_name(Name),
+  m_pg_type(Type),
+  m_type(arrow_type_for(Type)),
+  m_size(0),
+  m_nulls(0),
+  m_valid(),
+  m_data(),
+  m_offsets()
+{
+  if (m_type == arrow_large_utf8) m_offsets.push_back(0);
+}
+
+
+void pqxx::arrow_column::append(const char Text[], size_type Len)
+{
+  // Convert first, so a conversion error leaves the column unchanged.
+  switch (m_type)
+  {
+  case arrow_boolean:
+    {
+      bool b;
+      from_string(Text, b);
+      push_bit(m_data, b);
+    }
+    break;
+  case arrow_int16:
+    {
+      short s;
+      from_string(Text, s);
+      put(s);
+    }
+    break;
+  case arrow_int32:
+    {
+      int i;
+      from_string(Text, i);
+      put(i);
+    }
+    break;
+  case arrow_int64:
+    {
+      long long l;
+      from_string(Text, l);
+      put(l);
+    }
+    break;
+  case arrow_float32:
+    {
+      float f;
+      from_string(Text, f);
+      put(f);
+    }
+    break;
+  case arrow_float64:
+    {
+      double d;
+      from_string(Text, d);
+      put(d);
+    }
+    break;
+  case arrow_large_utf8:
+    m_offsets.reserve(m_offsets.size() + 1);
+    m_data.insert(m_data.end(), Text, Text + Len);
+    m_offsets.push_back(static_cast<long long>(m_data.size()));
+    break;
+  }
+
+  try
+  {
+    push_bit(m_valid, true);
+  }
+  catch (const std::exception &)
+  {
+    drop_value(m_size);
+    throw;
+  }
+  ++m_size;
+}
+
+
+void pqxx::arrow_column::append_null()
+{
+  switch (m_type)
+  {
+  case arrow_boolean:
+    push_bit(m_data, false);
+    break;
+  case arrow_large_utf8:
+    m_offsets.push_back(m_offsets.back());
+    break;
+  default:
+    m_data.resize(m_data.size() + width());
+  }
+
+  try
+  {
+    push_bit(m_valid, false);
+  }
+  catch (const std::exception &)
+  {
+    drop_value(m_size);
+    throw;
+  }
+  ++m_size;
+  ++m_nulls;
+}
+
+
+void pqxx::arrow_column::pop_back()
+{
+  if (!m_size) throw usage_error("pop_back() on empty arrow_column");
+
+  const size_type last = m_size - 1;
+  if (!(m_valid[last / 8] & (1u << (last % 8)))) --m_nulls;
+  pop_bit(m_valid, last);
+  drop_value(last);
+  m_size = last;
+}
+
+
+void pqxx::arrow_column::clear() PQXX_NOEXCEPT
+{
+  m_size = 0;
+  m_nulls = 0;
+  m_valid.clear();
+  m_data.clear();
+  if (m_type == arrow_large_utf8) m_offsets.resize(1);
+}
+
+
+void pqxx::arrow_column::push_bit(std::vector<unsigned char> &Bits, bool Bit)
+{
+  // Bitmaps grow with the column; m_size is the index of the new bit.
+  if (m_size % 8 == 0) Bits.push_back(0);
+  if (Bit) Bits.back() |= static_cast<unsigned char>(1u << (m_size % 8));
+}
+
+
+void pqxx::arrow_column::pop_bit(std::vector<unsigned char> &Bits, size_type i)
+	PQXX_NOEXCEPT
+{
+  if (i % 8 == 0) Bits.pop_back();
+  else Bits.back() &= static_cast<unsigned char>(~(1u << (i % 8)));
+}
+
+
+void pqxx::arrow_column::drop_value(size_type i) PQXX_NOEXCEPT
+{
+  switch (m_type)
+  {
+  case arrow_boolean:
+    pop_bit(m_data, i);
+    break;
+  case arrow_large_utf8:
+    m_offsets.pop_back();
+    m_data.resize(std::vector<unsigned char>::size_type(m_offsets.back()));
+    break;
+  default:
+    m_data.resize(m_data.size() - width());
+  }
+}
+
+
+template<typename T> void pqxx::arrow_column::put(const T &Value)
+{
+  const std::vector<unsigned char>::size_type here = m_data.size();
+  m_data.resize(here + sizeof(Value));
+  std::memcpy(&m_data[here], &Value, sizeof(Value));
+}
+
+
+pqxx::arrow_column::size_type pqxx::arrow_column::width() const PQXX_NOEXCEPT
+{
+  switch (m_type)
+  {
+  case arrow_int16: return 2;
+  case arrow_int32:
+  case arrow_float32: return 4;
+  case arrow_int64:
+  case arrow_float64: return 8;
+  default: return 0;
+  }
+}
+
+
+pqxx::arrow_batch::arrow_batch() :
+  m_columns(),
+  m_rows(0),
+  m_line(),
+  m_field()
+{
+}
+
+
+pqxx::arrow_batch::arrow_batch(const result &Shape) :
+  m_columns(),
+  m_rows(0),
+  m_line(),
+  m_field()
+{
+  const row::size_type cols = Shape.columns();
+  m_columns.reserve(cols);
+  for (row::size_type c = 0; c < cols; ++c)
+    add_column(Shape.column_name(c), Shape.column_type(c));
+}
+
+
+void pqxx::arrow_batch::add_column(const std::string &Name, oid Type)
+{
+  if (m_rows) throw usage_error("Adding column to nonempty arrow_batch");
+  m_columns.push_back(arrow_column(Name, Type));
+}
+
+
+void pqxx::arrow_batch::append(
+	const result &R,
+	result::size_type Begin,
+	result::size_type End)
+{
+  if (R.columns() != m_columns.size())
+    throw usage_error(
+	"Appending result with " + to_string(R.columns()) + " columns "
+	"to arrow_batch with " + to_string(m_columns.size()));
+  if (End > R.size()) End = R.size();
+
+  // Fill one column at a time, for better locality.
+  try
+  {
+    for (std::vector<arrow_column>::size_type c = 0; c < m_columns.size(); ++c)
+    {
+      arrow_column &Col = m_columns[c];
+      for (result::size_type r = Begin; r < End; ++r)
+      {
+        const field F = R[r][row::size_type(c)];
+        if (F.is_null()) Col.append_null();
+        else Col.append(F.c_str(), F.size());
+      }
+    }
+  }
+  catch (const std::exception &)
+  {
+    drop_partial_rows();
+    throw;
+  }
+  if (End > Begin) m_rows += End - Begin;
+}
+
+
+void pqxx::arrow_batch::append_copy_line(const std::string &Line)
+{
+  std::string::size_type i = 0;
+  try
+  {
+    for (std::vector<arrow_column>::size_type c = 0; c < m_columns.size(); ++c)
+    {
+      // Each field leaves i just past its tab, or past the end of the line.
+      if (i > Line.size())
+        throw failure("COPY line has too few fields: " + Line);
+      if (extract_copy_field(Line, i, m_field))
+        m_columns[c].append(m_field.c_str(), m_field.size());
+      else
+        m_columns[c].append_null();
+    }
+    if (i <= Line.size())
+      throw failure("COPY line has too many fields: " + Line);
+  }
+  catch (const std::exception &)
+  {
+    drop_partial_rows();
+    throw;
+  }
+  ++m_rows;
+}
+
+
+pqxx::arrow_batch::size_type pqxx::arrow_batch::read(
+	tablereader &Reader,
+	size_type MaxRows)
+{
+  size_type n = 0;
+  while (n < MaxRows && Reader.get_raw_line(m_line))
+  {
+    append_copy_line(m_line);
+    ++n;
+  }
+  return n;
+}
+
+
+void pqxx::arrow_batch::clear() PQXX_NOEXCEPT
+{
+  for (std::vector<arrow_column>::size_type c = 0; c < m_columns.size(); ++c)
+    m_columns[c].clear();
+  m_rows = 0;
+}
+
+
+void pqxx::arrow_batch::drop_partial_rows() PQXX_NOEXCEPT
+{
+  for (std::vector<arrow_column>::size_type c = 0; c < m_columns.size(); ++c)
+    while (m_columns[c].size() > m_rows) m_columns[c].pop_back();
+}
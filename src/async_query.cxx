@@ -0,0 +1,173 @@
+/*-------------------------------------------------------------------------
+ *
+ *   FILE
+ *	async_query.cxx
+ *
+ *   DESCRIPTION
+ *      implementation of the pqxx::async_query class
+ *   Executes a single query without blocking the calling thread
+ *
+ * Copyright (c) 2016, Jeroen T. Vermeulen <jtv@xs4all.nl>
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this mistake,
+ * or contact the author.
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "pqxx/compiler-internal.hxx"
+
+#include "libpq-fe.h"
+
+#include "pqxx/async_query"
+
+#include "pqxx/internal/gates/connection-async_query.hxx"
+#include "pqxx/internal/gates/result-creation.hxx"
+#include "pqxx/internal/gates/transaction-async_query.hxx"
+
+
+using namespace pqxx;
+using namespace pqxx::internal;
+
+
+pqxx::async_query::async_query(
+	transaction_base &t,
+	const std::string &query,
+	const std::string &Name) :
+  namedclass("async_query", Name),
+  transactionfocus(t),
+  m_query(query),
+  m_result(),
+  m_done(false)
+{
+  gate::transaction_async_query tgate(t);
+  tgate.CheckPendingError();
+  tgate.activate();
+
+  register_me();
+  try
+  {
+    gate::connection_async_query(t.conn()).start_exec(m_query);
+  }
+  catch (const std::exception &)
+  {
+    detach();
+    throw;
+  }
+}
+
+
+pqxx::async_query::~async_query() PQXX_NOEXCEPT
+{
+  cancel();
+  detach();
+}
+
+
+int pqxx::async_query::sock() const PQXX_NOEXCEPT
+{
+  return m_Trans.conn().sock();
+}
+
+
+bool pqxx::async_query::wants_write()
+{
+  if (m_done) return false;
+  return gate::connection_async_query(m_Trans.conn()).flush_output();
+}
+
+
+bool pqxx::async_query::ready()
+{
+  if (m_done) return true;
+
+  gate::connection_async_query gate(m_Trans.conn());
+  if (gate.flush_output()) return false;
+  if (!gate.consume_input()) throw broken_connection();
+
+  // Haul in results for as long as we can do so without blocking.  The query
+  // is done once libpq tells us there are no more results.  As with PQexec(),
+  // if the query consisted of several statements, the last result counts.
+  while (!m_done && !gate.is_busy())
+  {
+    internal::pq::PGresult *const r = gate.get_result();
+    if (r)
+    {
+      m_result = gate::result_creation::create(
+	r,
+	m_Trans.conn().protocol_version(),
+	m_query,
+	gate.encoding_code());
+
+      // A COPY leaves the connection in a special state that the caller must
+      // deal with.  There will be no further results until it does.
+      switch (PQresultStatus(r))
+      {
+      case PGRES_COPY_IN:
+      case PGRES_COPY_OUT:
+        break;
+      default:
+        continue;
+      }
+    }
+    m_done = true;
+    detach();
+  }
+
+  return m_done;
+}
+
+
+pqxx::result pqxx::async_query::get()
+{
+  gate::connection_async_query gate(m_Trans.conn());
+  while (!ready())
+  {
+    if (wants_write()) gate.wait_write();
+    else gate.wait_read();
+  }
+
+  if (!m_Trans.conn().is_open()) throw broken_connection();
+  gate::result_creation(m_result).CheckStatus();
+  return m_result;
+}
+
+
+void pqxx::async_query::detach() PQXX_NOEXCEPT
+{
+  if (registered()) unregister_me();
+}
+
+
+void pqxx::async_query::cancel() PQXX_NOEXCEPT
+{
+  if (m_done) return;
+
+  // Ask the backend to stop executing our query, then wait for it to finish
+  // so the connection is usable again.  The cancellation, or whatever else
+  // went wrong, aborts the transaction; make sure the caller hears why.
+  try
+  {
+    gate::connection_async_query gate(m_Trans.conn());
+    gate.cancel_query();
+    std::string Err;
+    for (internal::pq::PGresult *r = gate.get_result(); r; r=gate.get_result())
+    {
+      result R = gate::result_creation::create(r, 0, m_query, 0);
+      try
+      {
+        gate::result_creation(R).CheckStatus();
+      }
+      catch (const std::exception &e)
+      {
+        if (Err.empty()) Err = e.what();
+      }
+    }
+    if (!Err.empty()) reg_pending_error(Err);
+  }
+  catch (const std::exception &e)
+  {
+    reg_pending_error(e.what());
+  }
+  m_done = true;
+}
@@ -0,0 +1,121 @@
+/*-------------------------------------------------------------------------
+ *
+ *   FILE
+ *	batch_loader.cxx
+ *
+ *   DESCRIPTION
+ *      implementation of the pqxx::batch_loader class.
+ *   Bulk-loads rows, setting aside the ones that fail
+ *
+ * Copyright (c) 2016, Jeroen T. Vermeulen <jtv@xs4all.nl>
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this mistake,
+ * or contact the author.
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "pqxx/compiler-internal.hxx"
+
+#include "pqxx/batch_loader"
+#include "pqxx/subtransaction"
+
+
+pqxx::batch_loader::batch_loader(dbtransaction &T,
+	const std::string &Table,
+	const std::string &Null) :
+  m_trans(T),
+  m_table(Table),
+  m_columns(),
+  m_null(Null),
+  m_lines(),
+  m_offset(0),
+  m_rejects(),
+  m_rows(0),
+  m_attempts(0)
+{
+}
+
+
+void pqxx::batch_loader::write_raw_line(const std::string &Line)
+{
+  m_lines.push_back(Line);
+}
+
+
+pqxx::batch_loader::size_type pqxx::batch_loader::flush()
+{
+  size_type loaded = 0;
+  try
+  {
+    loaded = load_range(0, m_lines.size());
+  }
+  catch (const std::exception &)
+  {
+    // Don't retry rows that may already have gone in.
+    m_offset += m_lines.size();
+    m_lines.clear();
+    throw;
+  }
+  m_offset += m_lines.size();
+  m_lines.clear();
+  return loaded;
+}
+
+
+pqxx::batch_loader::size_type
+pqxx::batch_loader::load_range(size_type Begin, size_type End)
+{
+  if (Begin >= End) return 0;
+
+  try
+  {
+    copy(Begin, End);
+    m_rows += End - Begin;
+    return End - Begin;
+  }
+  catch (const data_exception &e)
+  {
+    if (End - Begin == 1)
+    {
+      reject(Begin, e);
+      return 0;
+    }
+  }
+  catch (const integrity_constraint_violation &e)
+  {
+    if (End - Begin == 1)
+    {
+      reject(Begin, e);
+      return 0;
+    }
+  }
+
+  // Somewhere in this range is at least one bad row.  Narrow it down.
+  const size_type Middle = Begin + (End - Begin) / 2;
+  const size_type loaded = load_range(Begin, Middle);
+  return loaded + load_range(Middle, End);
+}
+
+
+void pqxx::batch_loader::copy(size_type Begin, size_type End)
+{
+  ++m_attempts;
+  subtransaction S(m_trans, "batch_loader");
+  {
+    tablewriter W(S, m_table, m_columns.begin(), m_columns.end(), m_null);
+    for (size_type i = Begin; i < End; ++i) W.write_raw_line(m_lines[i]);
+    W.complete();
+  }
+  S.commit();
+}
+
+
+void pqxx::batch_loader::reject(size_type Row, const std::exception &e)
+{
+  rejected_row R;
+  R.index = m_offset + Row;
+  R.line = m_lines[Row];
+  R.error = e.what();
+  m_rejects.push_back(R);
+}
@@ -16,6 +16,7 @@
  */
 #include "pqxx/compiler-internal.hxx"
 
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -26,6 +27,8 @@
 
 #include "pqxx/binarystring"
 
+#include "pqxx/internal/gates/field-binarystring.hxx"
+
 
 using namespace pqxx::internal;
 
@@ -52,6 +55,83 @@ buffer to_buffer(const std::string &source)
 
 
 
+/// Value of each hex digit; other characters map to a value with bit 4 set.
+class hex_table
+{
+public:
+  hex_table()
+  {
+    for (int c = 0; c < 256; ++c) m_value[c] = 0x10;
+    for (int d = 0; d < 10; ++d) m_value['0' + d] = unsigned_char(d);
+    for (int x = 0; x < 6; ++x)
+      m_value['a' + x] = m_value['A' + x] = unsigned_char(10 + x);
+  }
+
+  unsigned operator[](unsigned_char c) const PQXX_NOEXCEPT
+	{ return m_value[c]; }
+
+private:
+  unsigned_char m_value[256];
+};
+
+const hex_table hex_value;
+
+
+bool is_hex(const char text[], size_t len) PQXX_NOEXCEPT
+{
+  return len >= 2 && len % 2 == 0 && text[0] == '\\' && text[1] == 'x';
+}
+
+
+/// Decode hex digit pairs.  Returns false if any of them were not hex.
+/** Reads all of an iteration's input before writing its output, so out may
+ * be the same memory as in.
+ */
+bool decode_hex(const unsigned_char in[], size_t n, unsigned_char out[])
+	PQXX_NOEXCEPT
+{
+  // Check for bad digits only once, at the end.  Valid input is the norm.
+  unsigned bad = 0;
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4, in += 8)
+  {
+    const unsigned
+	h0 = hex_value[in[0]], l0 = hex_value[in[1]],
+	h1 = hex_value[in[2]], l1 = hex_value[in[3]],
+	h2 = hex_value[in[4]], l2 = hex_value[in[5]],
+	h3 = hex_value[in[6]], l3 = hex_value[in[7]];
+    bad |= h0 | l0 | h1 | l1 | h2 | l2 | h3 | l3;
+    out[i] = unsigned_char((h0 << 4) | l0);
+    out[i+1] = unsigned_char((h1 << 4) | l1);
+    out[i+2] = unsigned_char((h2 << 4) | l2);
+    out[i+3] = unsigned_char((h3 << 4) | l3);
+  }
+  for (; i < n; ++i, in += 2)
+  {
+    const unsigned h = hex_value[in[0]], l = hex_value[in[1]];
+    bad |= h | l;
+    out[i] = unsigned_char((h << 4) | l);
+  }
+  return !(bad & 0x10);
+}
+
+
+/// Decode hex-format bytea into a new buffer, or return null buffer if invalid
+buffer unhex(const char text[], size_t len)
+{
+  const size_t n = (len - 2) / 2;
+  unsigned char *const output = static_cast<unsigned char *>(malloc(n + 1));
+  if (!output) throw std::bad_alloc();
+  if (!decode_hex(reinterpret_cast<const unsigned char *>(text) + 2, n, output))
+  {
+    free(output);
+    return buffer(static_cast<unsigned char *>(0), 0);
+  }
+  output[n] = '\0';
+  return buffer(output, n);
+}
+
+
 buffer unescape(const unsigned char escaped[])
 {
 #ifdef _WIN32
@@ -82,34 +162,63 @@ buffer unescape(const unsigned char escaped[])
 
 pqxx::binarystring::binarystring(const binarystring &rhs) :
   m_buf(*new smart_pointer_type(rhs.m_buf)),
-  m_size(rhs.m_size)
+  m_size(rhs.m_size),
+  m_data(rhs.m_data),
+  m_owner(rhs.m_owner)
 {
 }
 
 
 pqxx::binarystring::binarystring(const field &F) :
   m_buf(*new smart_pointer_type),
-  m_size(0)
+  m_size(0),
+  m_data(0),
+  m_owner()
 {
-  buffer unescaped(unescape(reinterpret_cast<const_pointer>(F.c_str())));
+  const gate::field_binarystring G(F);
+  const char *const text = F.c_str();
+  const size_t len = F.size();
+
+  // Binary format needs no decoding at all.  Just hang on to the result.
+  if (G.format() == 1)
+  {
+    m_owner = G.owner();
+    m_size = len;
+    m_data = reinterpret_cast<const_pointer>(text);
+    return;
+  }
+
+  // Hex format is easy enough to decode ourselves, into a buffer of just the
+  // right size.  The older escape format is left to libpq.
+  buffer unescaped(static_cast<unsigned char *>(0), 0);
+  if (is_hex(text, len)) unescaped = unhex(text, len);
+  if (!unescaped.first)
+    unescaped = unescape(reinterpret_cast<const_pointer>(text));
   m_buf = smart_pointer_type(unescaped.first);
   m_size = unescaped.second;
+  m_data = m_buf.get();
 }
 
 
 pqxx::binarystring::binarystring(const std::string &s) :
   m_buf(*new smart_pointer_type),
-  m_size(s.size())
+  m_size(s.size()),
+  m_data(0),
+  m_owner()
 {
   m_buf = smart_pointer_type(to_buffer(s).first);
+  m_data = m_buf.get();
 }
 
 
 pqxx::binarystring::binarystring(const void *binary_data, size_t len) :
   m_buf(*new smart_pointer_type),
-  m_size(len)
+  m_size(len),
+  m_data(0),
+  m_owner()
 {
   m_buf = smart_pointer_type(to_buffer(binary_data, len).first);
+  m_data = m_buf.get();
 }
 
 
@@ -125,6 +234,8 @@ pqxx::binarystring &pqxx::binarystring::operator=(const binarystring &rhs)
 {
   m_buf = rhs.m_buf;
   m_size = rhs.m_size;
+  m_data = rhs.m_data;
+  m_owner = rhs.m_owner;
   return *this;
 }
 
@@ -144,8 +255,10 @@ pqxx::binarystring::const_reference pqxx::binarystring::at(size_type n) const
 
 void pqxx::binarystring::swap(binarystring &rhs)
 {
-  // PQAlloc<>::swap() does not throw.
+  // PQAlloc<>::swap() and result::swap() do not throw.
   m_buf.swap(rhs.m_buf);
+  m_owner.swap(rhs.m_owner);
+  std::swap(m_data, rhs.m_data);
 
   // This part very obviously can't go wrong, so do it last
   const size_type s(m_size);
@@ -158,3 +271,17 @@ std::string pqxx::binarystring::str() const
 {
   return std::string(get(), m_size);
 }
+
+
+size_t pqxx::unescape_bytea_hex(
+	const char Text[],
+	size_t Len,
+	unsigned char Buf[])
+{
+  if (!is_hex(Text, Len))
+    throw argument_error("Not a bytea value in hex format");
+  const size_t n = (Len - 2) / 2;
+  if (!decode_hex(reinterpret_cast<const unsigned char *>(Text) + 2, n, Buf))
+    throw argument_error("Invalid hex digit in bytea value");
+  return n;
+}
@@ -133,7 +133,9 @@ pqxx::connection_base::connection_base(connectionpolicy &pol) :
   m_Completed(false),
   m_inhibit_reactivation(false),
   m_caps(),
-  m_verbosity(normal)
+  m_verbosity(normal),
+  m_deferred_begin(false),
+  m_deferred()
 {
   clearcaps();
 }
@@ -491,6 +493,7 @@ void pqxx::connection_base::add_receiver(pqxx::notification_receiver *T)
 
     if (is_open()) try
     {
+      flush_deferred();
       check_result(make_result(PQexec(m_Conn, LQ.c_str()), LQ));
     }
     catch (const broken_connection &)
@@ -716,6 +719,11 @@ std::vector<errorhandler *> pqxx::connection_base::get_errorhandlers() const
 pqxx::result pqxx::connection_base::Exec(const char Query[], int Retries)
 {
   activate();
+  if (!m_deferred.empty())
+  {
+    result None;
+    return exec_parts(Query, std::string(), None, Retries);
+  }
 
   result R = make_result(PQexec(m_Conn, Query), Query);
 
@@ -733,6 +741,139 @@ pqxx::result pqxx::connection_base::Exec(const char Query[], int Retries)
 }
 
 
+namespace
+{
+/// Does a result mean the connection went into COPY mode?
+bool is_copy(const pqxx::internal::pq::PGresult *R) PQXX_NOEXCEPT
+{
+  switch (PQresultStatus(R))
+  {
+  case PGRES_COPY_IN:
+  case PGRES_COPY_OUT:
+  case PGRES_COPY_BOTH:
+    return true;
+  default:
+    return false;
+  }
+}
+} // namespace
+
+
+// Send deferred statements, Query, and Then as one multi-statement query.
+pqxx::result pqxx::connection_base::exec_parts(
+	const char Query[],
+	const std::string &Then,
+	result &ThenResult,
+	int Retries)
+{
+  std::vector<std::string> Deferred;
+  Deferred.swap(m_deferred);
+
+  // Each deferred entry is one statement, or a few separated by semicolons.
+  // Their results come first, in order, then Query's, then the one for Then.
+  std::vector<std::string::size_type> ends;
+  std::string Full;
+  for (std::vector<std::string>::size_type i = 0; i < Deferred.size(); ++i)
+  {
+    const std::string &D = Deferred[i];
+    ends.push_back(
+	(ends.empty() ? 0 : ends.back()) +
+	std::string::size_type(std::count(D.begin(), D.end(), ';')) + 1);
+    Full += D + "; ";
+  }
+  const std::string::size_type deferred_results =
+	ends.empty() ? 0 : ends.back();
+  Full += Query;
+  if (!Then.empty()) Full += "; " + Then;
+
+  result R;
+  for (++Retries; Retries > 0; --Retries)
+  {
+    std::string::size_type n = 0, d = 0;
+    if (PQsendQuery(m_Conn, Full.c_str()))
+    {
+      internal::pq::PGresult *r;
+      while ((r = PQgetResult(m_Conn)) != NULL)
+      {
+        const bool copy = is_copy(r);
+        if (n < deferred_results)
+        {
+          while (n >= ends[d]) ++d;
+          R = make_result(r, Deferred[d]);
+        }
+        else if (n == deferred_results || Then.empty())
+        {
+          R = make_result(r, Query);
+        }
+        else
+        {
+          ThenResult = make_result(r, Then);
+        }
+        ++n;
+        // In COPY mode, libpq keeps returning the COPY result.
+        if (copy) break;
+      }
+    }
+    if (gate::result_connection(R) || is_open() || Retries <= 1) break;
+
+    Reset();
+    if (!is_open()) break;
+  }
+
+  check_result(R);
+
+  get_notifs();
+  return R;
+}
+
+
+pqxx::result pqxx::connection_base::exec_then(
+	const char Query[],
+	const std::string &Then,
+	bool &ThenDone)
+{
+  activate();
+  ThenDone = false;
+  result T;
+  const result R = exec_parts(Query, Then, T, 0);
+  ThenDone = gate::result_connection(T);
+  check_result(T);
+  return R;
+}
+
+
+// Send deferred statements ahead of something that can't include them.
+void pqxx::connection_base::flush_deferred()
+{
+  if (m_deferred.empty()) return;
+  // Exec() sends the others along with the last one.
+  std::string Last = m_deferred.back();
+  m_deferred.pop_back();
+  Exec(Last.c_str(), 0);
+}
+
+
+void pqxx::connection_base::defer(const std::string &Statement)
+{
+  m_deferred.push_back(Statement);
+}
+
+
+bool pqxx::connection_base::cancel_deferred(const std::string &Statement)
+	PQXX_NOEXCEPT
+{
+  if (m_deferred.empty() || m_deferred.back() != Statement) return false;
+  m_deferred.pop_back();
+  return true;
+}
+
+
+void pqxx::connection_base::drop_deferred() PQXX_NOEXCEPT
+{
+  m_deferred.clear();
+}
+
+
 void pqxx::connection_base::prepare(
 	const std::string &name,
 	const std::string &definition)
@@ -824,10 +965,12 @@ pqxx::result pqxx::connection_base::prepared_exec(
 	const char *const params[],
 	const int paramlengths[],
 	const int binary[],
-	int nparams)
+	int nparams,
+	int result_format)
 {
   register_prepared(statement);
   activate();
+  flush_deferred();
   result r = make_result(
 	PQexecPrepared(
 		m_Conn,
@@ -836,7 +979,7 @@ pqxx::result pqxx::connection_base::prepared_exec(
 		params,
 		paramlengths,
 		binary,
-		0),
+		result_format),
     	statement);
   check_result(r);
   get_notifs();
@@ -880,6 +1023,7 @@ void pqxx::connection_base::Reset()
 void pqxx::connection_base::close() PQXX_NOEXCEPT
 {
   m_Completed = false;
+  m_deferred.clear();
   inhibit_reactivation(false);
   m_reactivation_avoidance.clear();
   try
@@ -969,16 +1113,31 @@ void pqxx::connection_base::UnregisterTransaction(transaction_base *T)
 
 
 bool pqxx::connection_base::ReadCopyLine(std::string &Line)
+{
+  int Res;
+  while ((Res = TryReadCopyLine(Line)) == 0) wait_read();
+  return Res > 0;
+}
+
+
+int pqxx::connection_base::TryReadCopyLine(std::string &Line)
 {
   if (!is_open())
     throw internal_error("ReadCopyLine() without connection");
 
   Line.erase();
-  bool Result;
 
   char *Buf = 0;
+  int Res = PQgetCopyData(m_Conn, &Buf, true);
+  if (!Res)
+  {
+    // No complete line buffered yet.  Take in whatever input has arrived.
+    if (!consume_input()) throw broken_connection(ErrMsg());
+    Res = PQgetCopyData(m_Conn, &Buf, true);
+  }
+
   const std::string query = "[END COPY]";
-  switch (PQgetCopyData(m_Conn, &Buf, false))
+  switch (Res)
   {
     case -2:
       throw failure("Reading of table data failed: " + std::string(ErrMsg()));
@@ -988,11 +1147,10 @@ bool pqxx::connection_base::ReadCopyLine(std::string &Line)
            gate::result_connection(R);
 	   R=make_result(PQgetResult(m_Conn), query))
 	check_result(R);
-      Result = false;
-      break;
+      return -1;
 
     case 0:
-      throw internal_error("table read inexplicably went asynchronous");
+      return 0;
 
     default:
       if (Buf)
@@ -1000,10 +1158,8 @@ bool pqxx::connection_base::ReadCopyLine(std::string &Line)
         PQAlloc<char> PQA(Buf);
         Line = Buf;
       }
-      Result = true;
+      return 1;
   }
-
-  return Result;
 }
 
 
@@ -1016,7 +1172,10 @@ void pqxx::connection_base::WriteCopyLine(const std::string &Line)
   const char *const LC = L.c_str();
   const std::string::size_type Len = L.size();
 
-  if (PQputCopyData(m_Conn, LC, int(Len)) <= 0)
+  // A nonblocking connection may not have room to queue the data right now.
+  int Res;
+  while ((Res = PQputCopyData(m_Conn, LC, int(Len))) == 0) wait_write();
+  if (Res < 0)
   {
     const std::string Msg = std::string("Error writing to table: ") + ErrMsg();
     PQendcopy(m_Conn);
@@ -1027,13 +1186,12 @@ void pqxx::connection_base::WriteCopyLine(const std::string &Line)
 
 void pqxx::connection_base::EndCopyWrite()
 {
-  int Res = PQputCopyEnd(m_Conn, NULL);
+  int Res;
+  while ((Res = PQputCopyEnd(m_Conn, NULL)) == 0) wait_write();
   switch (Res)
   {
   case -1:
     throw failure("Write to table failed: " + std::string(ErrMsg()));
-  case 0:
-    throw internal_error("table write is inexplicably asynchronous");
   case 1:
     // Normal termination.  Retrieve result object.
     break;
@@ -1043,6 +1201,9 @@ void pqxx::connection_base::EndCopyWrite()
 	"from PQputCopyEnd()");
   }
 
+  // In nonblocking mode, the end marker may still be sitting in our buffer.
+  while (flush_output()) wait_write();
+
   check_result(make_result(PQgetResult(m_Conn), "[END COPY]"));
 }
 
@@ -1050,10 +1211,37 @@ void pqxx::connection_base::EndCopyWrite()
 void pqxx::connection_base::start_exec(const std::string &Q)
 {
   activate();
+  flush_deferred();
   if (!PQsendQuery(m_Conn, Q.c_str())) throw failure(ErrMsg());
 }
 
 
+bool pqxx::connection_base::flush_output()
+{
+  if (!m_Conn) throw broken_connection();
+  switch (PQflush(m_Conn))
+  {
+  case 0:
+    return false;
+  case 1:
+    return true;
+  default:
+    throw broken_connection(ErrMsg());
+  }
+}
+
+
+void pqxx::connection_base::set_nonblocking(bool nonblocking)
+{
+  if (!m_Conn) throw broken_connection();
+  if (PQsetnonblocking(m_Conn, nonblocking) != 0)
+    throw failure(
+	std::string("Could not switch connection ") +
+	(nonblocking ? "to" : "out of") + " nonblocking mode: " +
+	ErrMsg());
+}
+
+
 pqxx::internal::pq::PGresult *pqxx::connection_base::get_result()
 {
   if (!m_Conn) throw broken_connection();
@@ -1223,6 +1411,40 @@ void pqxx::internal::wait_write(const pq::PGconn *c)
 }
 
 
+void pqxx::internal::wait_any(const std::vector<std::pair<int, bool> > &socks)
+{
+  typedef std::vector<std::pair<int, bool> >::const_iterator iter;
+#ifdef PQXX_HAVE_POLL
+  std::vector<pollfd> fds;
+  fds.reserve(socks.size());
+  for (iter i = socks.begin(); i != socks.end(); ++i) if (i->first >= 0)
+  {
+    const pollfd pfd = {
+	i->first,
+	short(POLLERR|POLLHUP|POLLNVAL | (i->second?POLLOUT:POLLIN)),
+	0 };
+    fds.push_back(pfd);
+  }
+  if (fds.empty()) throw broken_connection();
+  poll(&fds[0], fds.size(), -1);
+#else
+  fd_set r, w, e;
+  clear_fdmask(&r);
+  clear_fdmask(&w);
+  clear_fdmask(&e);
+  int top = -1;
+  for (iter i = socks.begin(); i != socks.end(); ++i) if (i->first >= 0)
+  {
+    set_fdbit(i->first, i->second ? &w : &r);
+    set_fdbit(i->first, &e);
+    top = std::max(top, i->first);
+  }
+  if (top < 0) throw broken_connection();
+  select(top+1, &r, &w, &e, 0);
+#endif
+}
+
+
 void pqxx::connection_base::wait_read() const
 {
   internal::wait_read(m_Conn);
@@ -1297,6 +1519,13 @@ void pqxx::connection_base::read_capabilities()
   m_caps[cap_notify_payload] = true;
   m_caps[cap_table_column] = true;
   m_caps[cap_parameterized_statements] = true;
+  m_caps[cap_txid_status] = (m_serverversion >= 100000);
+#ifdef PQXX_HAVE_LO_64
+  m_caps[cap_large_objects_64] = (m_serverversion >= 90300);
+#else
+  // Our libpq is too old to have the 64-bit large object functions.
+  m_caps[cap_large_objects_64] = false;
+#endif
 }
 
 
@@ -1321,6 +1550,7 @@ pqxx::result pqxx::connection_base::parameterized_exec(
 	const int binaries[],
 	int nparams)
 {
+  flush_deferred();
   result r = make_result(
   	PQexecParams(
 		m_Conn,
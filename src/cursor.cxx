@@ -17,9 +17,11 @@
  */
 #include "pqxx/compiler-internal.hxx"
 
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 
+#include "pqxx/async_query"
 #include "pqxx/cursor"
 #include "pqxx/result"
 #include "pqxx/strconv"
@@ -28,6 +30,7 @@
 #include "pqxx/internal/gates/connection-sql_cursor.hxx"
 #include "pqxx/internal/gates/icursor_iterator-icursorstream.hxx"
 #include "pqxx/internal/gates/icursorstream-icursor_iterator.hxx"
+#include "pqxx/internal/gates/result-cursor_block_cache.hxx"
 #include "pqxx/internal/gates/result-sql_cursor.hxx"
 
 using namespace pqxx;
@@ -45,6 +48,17 @@ inline bool useless_trail(char c)
   return isspace(c) || c==';';
 }
 
+
+/// Number of bytes of field data in a result
+result::size_type data_bytes(const result &r)
+{
+  result::size_type bytes = 0;
+  const row::size_type cols = r.columns();
+  for (result::size_type i = 0; i < r.size(); ++i)
+    for (row::size_type c = 0; c < cols; ++c) bytes += r[i][c].size();
+  return bytes;
+}
+
 }
 
 
@@ -61,7 +75,9 @@ pqxx::internal::sql_cursor::sql_cursor(transaction_base &t,
   m_adopted(false),
   m_at_end(-1),
   m_pos(0),
-  m_endpos(-1)
+  m_endpos(-1),
+  m_prefetch(0),
+  m_prefetch_rows(0)
 {
   if (&t.conn() != &m_home) throw internal_error("Cursor in wrong connection");
   std::stringstream cq, qn;
@@ -123,7 +139,9 @@ pqxx::internal::sql_cursor::sql_cursor(transaction_base &t,
   m_adopted(true),
   m_at_end(0),
   m_pos(-1),
-  m_endpos(-1)
+  m_endpos(-1),
+  m_prefetch(0),
+  m_prefetch_rows(0)
 {
   // If we take responsibility for destroying the cursor, that's one less reason
   // not to allow the connection to be deactivated and reactivated.
@@ -137,6 +155,21 @@ pqxx::internal::sql_cursor::sql_cursor(transaction_base &t,
 
 void pqxx::internal::sql_cursor::close() PQXX_NOEXCEPT
 {
+  // Let a prefetch run to completion.  Canceling it would abort the
+  // transaction.
+  if (m_prefetch)
+  {
+    try
+    {
+      m_prefetch->get();
+    }
+    catch (const std::exception &)
+    {
+    }
+    delete m_prefetch;
+    m_prefetch = 0;
+  }
+
   if (m_ownership==cursor_base::owned)
   {
     try
@@ -216,6 +249,41 @@ pqxx::internal::sql_cursor::adjust(difference_type hoped,
 }
 
 
+void pqxx::internal::sql_cursor::prefetch(transaction_base &t,
+	difference_type rows)
+{
+  if (m_prefetch) throw usage_error("Cursor is already prefetching");
+  if (rows <= 0) throw usage_error("Cursor can only prefetch forward");
+  if (&t.conn() != &m_home) throw usage_error("Cursor in wrong connection");
+
+  m_prefetch = new async_query(
+	t,
+	"FETCH " + stridestring(rows) + " IN \"" + name() + "\"");
+  m_prefetch_rows = rows;
+}
+
+
+result pqxx::internal::sql_cursor::collect_prefetch(
+	difference_type &displacement)
+{
+  result r;
+  try
+  {
+    r = m_prefetch->get();
+  }
+  catch (const std::exception &)
+  {
+    delete m_prefetch;
+    m_prefetch = 0;
+    throw;
+  }
+  delete m_prefetch;
+  m_prefetch = 0;
+  displacement = adjust(m_prefetch_rows, difference_type(r.size()));
+  return r;
+}
+
+
 result pqxx::internal::sql_cursor::fetch(difference_type rows,
 	difference_type &displacement)
 {
@@ -224,6 +292,14 @@ result pqxx::internal::sql_cursor::fetch(difference_type rows,
     displacement = 0;
     return m_empty_result;
   }
+  if (m_prefetch)
+  {
+    if (rows != m_prefetch_rows)
+      throw usage_error(
+	"Fetching " + to_string(rows) + " rows from cursor "
+	"while prefetching " + to_string(m_prefetch_rows));
+    return collect_prefetch(displacement);
+  }
   const std::string query =
       "FETCH " + stridestring(rows) + " IN \"" + name() + "\"";
   const result r(gate::connection_sql_cursor(m_home).Exec(query.c_str(), 0));
@@ -242,6 +318,23 @@ cursor_base::difference_type pqxx::internal::sql_cursor::move(
     return 0;
   }
 
+  if (m_prefetch)
+  {
+    // We can't un-fetch rows, so the move must cover all prefetched rows.
+    if (rows < m_prefetch_rows)
+      throw usage_error(
+	"Moving cursor by " + to_string(rows) + " rows "
+	"while prefetching " + to_string(m_prefetch_rows));
+    const difference_type prefetched = m_prefetch_rows;
+    const difference_type d =
+	difference_type(collect_prefetch(displacement).size());
+    if (d < prefetched || rows == prefetched) return d;
+    difference_type more = 0;
+    const difference_type d2 = move(rows - prefetched, more);
+    displacement += more;
+    return d + d2;
+  }
+
   const std::string query =
       "MOVE " + stridestring(rows) + " IN \"" + name() + "\"";
   const result r(gate::connection_sql_cursor(m_home).Exec(query.c_str(), 0));
@@ -302,11 +395,128 @@ result pqxx::internal::stateless_cursor_retrieve(
 }
 
 
+pqxx::internal::cursor_block_cache::cursor_block_cache() PQXX_NOEXCEPT :
+  m_block_rows(0),
+  m_max_bytes(0),
+  m_used(0),
+  m_blocks(),
+  m_recent()
+{
+}
+
+
+void pqxx::internal::cursor_block_cache::configure(
+	size_type block_rows,
+	size_type max_bytes)
+{
+  if (block_rows != m_block_rows) clear();
+  m_block_rows = block_rows;
+  m_max_bytes = max_bytes;
+  evict();
+}
+
+
+void pqxx::internal::cursor_block_cache::clear() PQXX_NOEXCEPT
+{
+  m_blocks.clear();
+  m_recent.clear();
+  m_used = 0;
+}
+
+
+result pqxx::internal::cursor_block_cache::retrieve(
+	sql_cursor &cur,
+	difference_type size,
+	difference_type begin_pos,
+	difference_type end_pos)
+{
+  if (begin_pos < 0 || begin_pos > size)
+    throw range_error("Starting position out of range");
+
+  if (end_pos < -1) end_pos = -1;
+  else if (end_pos > size) end_pos = size;
+
+  // Rows to return, in ascending order: lo (inclusive) to hi (exclusive).
+  const bool ascending = (begin_pos < end_pos);
+  const difference_type
+	lo = (ascending ? begin_pos : end_pos + 1),
+	hi = (ascending ? end_pos : std::min(begin_pos + 1, size));
+  if (lo >= hi) return cur.empty_result();
+
+  const difference_type rows_per_block = difference_type(m_block_rows);
+  const difference_type first = lo / rows_per_block;
+  std::vector<result> blocks;
+  for (difference_type n = first; n <= (hi - 1) / rows_per_block; ++n)
+    blocks.push_back(get_block(cur, size, n));
+
+  // If we want exactly one whole block, that's our result.
+  if (ascending &&
+      blocks.size() == 1 &&
+      lo % rows_per_block == 0 &&
+      hi - lo == difference_type(blocks[0].size()))
+    return blocks[0];
+
+  std::vector<row> rows;
+  rows.reserve(std::vector<row>::size_type(hi - lo));
+  for (difference_type i = lo; i < hi; ++i)
+    rows.push_back(blocks[std::vector<result>::size_type(
+	i / rows_per_block - first)][result::size_type(i % rows_per_block)]);
+  if (!ascending) std::reverse(rows.begin(), rows.end());
+
+  return gate::result_cursor_block_cache(blocks[0]).copy_rows(rows);
+}
+
+
+result pqxx::internal::cursor_block_cache::get_block(
+	sql_cursor &cur,
+	difference_type size,
+	difference_type number)
+{
+  const block_map::iterator i = m_blocks.find(number);
+  if (i != m_blocks.end())
+  {
+    m_recent.splice(m_recent.begin(), m_recent, i->second.recent);
+    return i->second.data;
+  }
+
+  const difference_type begin_pos = number * difference_type(m_block_rows);
+  const difference_type end_pos =
+	std::min(begin_pos + difference_type(m_block_rows), size);
+
+  block b;
+  b.data = stateless_cursor_retrieve(cur, size, begin_pos, end_pos);
+  // Count a terminating zero for each field as well.
+  b.bytes = data_bytes(b.data) + b.data.size() * b.data.columns();
+  m_recent.push_front(number);
+  b.recent = m_recent.begin();
+  m_blocks.insert(block_map::value_type(number, b));
+  m_used += b.bytes;
+
+  const result data = b.data;
+  evict();
+  return data;
+}
+
+
+void pqxx::internal::cursor_block_cache::evict() PQXX_NOEXCEPT
+{
+  // Keep at least the most recent block, or the cache is no use at all.
+  while (m_used > m_max_bytes && m_blocks.size() > 1)
+  {
+    const block_map::iterator i = m_blocks.find(m_recent.back());
+    m_used -= i->second.bytes;
+    m_blocks.erase(i);
+    m_recent.pop_back();
+  }
+}
+
+
 pqxx::icursorstream::icursorstream(
     transaction_base &context,
     const std::string &query,
     const std::string &basename,
     difference_type sstride) :
+  m_context(context),
   m_cur(context,
 	query,
 	basename,
@@ -318,7 +528,11 @@ pqxx::icursorstream::icursorstream(
   m_realpos(0),
   m_reqpos(0),
   m_iterators(0),
-  m_done(false)
+  m_done(false),
+  m_prefetch(false),
+  m_target_bytes(0),
+  m_target_msec(0),
+  m_max_stride(0)
 {
   set_stride(sstride);
 }
@@ -329,12 +543,17 @@ pqxx::icursorstream::icursorstream(
     const field &cname,
     difference_type sstride,
     cursor_base::ownershippolicy op) :
+  m_context(context),
   m_cur(context, cname.c_str(), op),
   m_stride(sstride),
   m_realpos(0),
   m_reqpos(0),
   m_iterators(0),
-  m_done(false)
+  m_done(false),
+  m_prefetch(false),
+  m_target_bytes(0),
+  m_target_msec(0),
+  m_max_stride(0)
 {
   set_stride(sstride);
 }
@@ -345,17 +564,69 @@ void pqxx::icursorstream::set_stride(difference_type n)
   if (n < 1)
     throw argument_error("Attempt to set cursor stride to " + to_string(n));
   m_stride = n;
+  m_target_bytes = 0;
+}
+
+
+void pqxx::icursorstream::set_adaptive_stride(size_type bytes,
+	unsigned msec,
+	difference_type max_stride)
+{
+  if (!bytes)
+    throw argument_error("Adaptive cursor stride needs a nonzero byte target");
+  if (max_stride < 1)
+    throw argument_error(
+	"Attempt to set maximum cursor stride to " + to_string(max_stride));
+  m_target_bytes = bytes;
+  m_target_msec = msec;
+  m_max_stride = max_stride;
+  if (m_stride > m_max_stride) m_stride = m_max_stride;
 }
 
+
 result pqxx::icursorstream::fetchblock()
 {
-  const result r(m_cur.fetch(m_stride));
+  const unsigned long start = internal::clock_msec();
+  // A block that is already being prefetched keeps its old size.
+  const result r(m_cur.fetch(
+	m_cur.prefetching() ? m_cur.prefetch_rows() : m_stride));
+  const unsigned long msec = internal::clock_msec() - start;
   m_realpos += r.size();
-  if (r.empty()) m_done = true;
+  if (r.empty())
+  {
+    m_done = true;
+  }
+  else if (m_cur.endpos() == -1)
+  {
+    if (m_target_bytes) adapt_stride(r, msec);
+    if (m_prefetch) m_cur.prefetch(m_context, m_stride);
+  }
   return r;
 }
 
 
+void pqxx::icursorstream::adapt_stride(const result &r, unsigned long msec)
+{
+  const double rows = double(r.size());
+  const double bytes = double(data_bytes(r));
+
+  // Count at least a byte per row, so empty rows don't look free.
+  double ideal = double(m_target_bytes) * rows / (bytes > rows ? bytes : rows);
+
+  // A block that came in within a millisecond says little about timing.
+  if (m_target_msec && msec > 0)
+  {
+    const double by_time = double(m_target_msec) * rows / double(msec);
+    if (by_time < ideal) ideal = by_time;
+  }
+
+  const double most = 2 * rows;
+  if (ideal > most) ideal = most;
+  if (ideal > double(m_max_stride)) ideal = double(m_max_stride);
+  m_stride = (ideal < 1) ? 1 : difference_type(ideal);
+}
+
+
 icursorstream &pqxx::icursorstream::ignore(std::streamsize n)
 {
   difference_type offset = m_cur.move(difference_type(n));
@@ -77,12 +77,28 @@ pqxx::dbtransaction::~dbtransaction()
 
 void pqxx::dbtransaction::do_begin()
 {
-  const gate::connection_dbtransaction gate(conn());
+  gate::connection_dbtransaction gate(conn());
+  if (conn().deferred_begin())
+  {
+    // The connection sends this along with our first statement.
+    gate.defer(m_StartCmd);
+    return;
+  }
   const int avoidance_counter = gate.get_reactivation_avoidance_count();
   DirectExec(m_StartCmd.c_str(), avoidance_counter ? 0 : 2);
 }
 
 
+pqxx::result pqxx::dbtransaction::begin_with(const std::string &Query)
+{
+  const gate::connection_dbtransaction gate(conn());
+  const int avoidance_counter = gate.get_reactivation_avoidance_count();
+  return DirectExec(
+	(m_StartCmd + "; " + Query).c_str(),
+	avoidance_counter ? 0 : 2);
+}
+
+
 pqxx::result pqxx::dbtransaction::do_exec(const char Query[])
 {
   try
@@ -100,10 +116,49 @@ pqxx::result pqxx::dbtransaction::do_exec(const char Query[])
 void pqxx::dbtransaction::do_abort()
 {
   reactivation_avoidance_clear();
+  if (cancel_deferred_begin()) return;
+
+  // Anything still waiting to be sent is moot now.
+  drop_deferred();
   DirectExec(internal::sql_rollback_work);
 }
 
 
+bool pqxx::dbtransaction::cancel_deferred_begin() PQXX_NOEXCEPT
+{
+  return cancel_deferred(m_StartCmd);
+}
+
+
+void pqxx::dbtransaction::defer(const std::string &Statement)
+{
+  gate::connection_dbtransaction(conn()).defer(Statement);
+}
+
+
+bool pqxx::dbtransaction::cancel_deferred(const std::string &Statement)
+	PQXX_NOEXCEPT
+{
+  return gate::connection_dbtransaction(conn()).cancel_deferred(Statement);
+}
+
+
+void pqxx::dbtransaction::drop_deferred() PQXX_NOEXCEPT
+{
+  gate::connection_dbtransaction(conn()).drop_deferred();
+}
+
+
+pqxx::result pqxx::dbtransaction::exec_then(
+	const char Query[],
+	const std::string &Then,
+	bool &ThenDone)
+{
+  gate::connection_dbtransaction gate(conn());
+  return gate.exec_then(Query, Then, ThenDone);
+}
+
+
 std::string pqxx::dbtransaction::fullname(const std::string &ttype,
 	const std::string &isolation)
 {
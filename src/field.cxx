@@ -23,6 +23,9 @@
 #include "pqxx/result"
 #include "pqxx/row"
 
+#include "pqxx/internal/gates/result-view_registration.hxx"
+#include "pqxx/internal/result_data.hxx"
+
 
 pqxx::field::field(const pqxx::row &R, pqxx::row::size_type C)
 	PQXX_NOEXCEPT :
@@ -85,3 +88,82 @@ pqxx::field::size_type pqxx::field::size() const PQXX_NOEXCEPT
 {
   return home()->GetLength(idx(), col());
 }
+
+
+pqxx::internal::view_registration::view_registration(const result &Home) :
+  m_home(0),
+  m_prev(0),
+  m_next(0),
+  m_dangling(false)
+{
+  link(gate::result_view_registration(Home).data());
+}
+
+
+pqxx::internal::view_registration::view_registration(
+	const view_registration &rhs) PQXX_NOEXCEPT :
+  m_home(0),
+  m_prev(0),
+  m_next(0),
+  m_dangling(rhs.m_dangling)
+{
+  link(rhs.m_home);
+}
+
+
+pqxx::internal::view_registration &
+pqxx::internal::view_registration::operator=(const view_registration &rhs)
+	PQXX_NOEXCEPT
+{
+  if (&rhs != this)
+  {
+    unlink();
+    m_dangling = rhs.m_dangling;
+    link(rhs.m_home);
+  }
+  return *this;
+}
+
+
+void pqxx::internal::view_registration::orphan_all(view_registration *Head)
+	PQXX_NOEXCEPT
+{
+  while (Head)
+  {
+    view_registration *const next = Head->m_next;
+    Head->m_home = 0;
+    Head->m_prev = Head->m_next = 0;
+    Head->m_dangling = true;
+    Head = next;
+  }
+}
+
+
+void pqxx::internal::view_registration::link(const result_data *Home)
+	PQXX_NOEXCEPT
+{
+  // A default-constructed result has no data, and no views can dangle there.
+  if (!Home) return;
+  m_home = Home;
+  m_prev = 0;
+  m_next = Home->views;
+  if (m_next) m_next->m_prev = this;
+  Home->views = this;
+}
+
+
+void pqxx::internal::view_registration::unlink() PQXX_NOEXCEPT
+{
+  if (!m_home) return;
+  if (m_prev) m_prev->m_next = m_next;
+  else m_home->views = m_next;
+  if (m_next) m_next->m_prev = m_prev;
+  m_home = 0;
+  m_prev = m_next = 0;
+}
+
+
+void pqxx::internal::view_registration::throw_dangling()
+{
+  throw usage_error("Using field_view after its result was destroyed");
+}
@@ -19,8 +19,15 @@
 
 #include <algorithm>
 #include <cerrno>
+#include <climits>
 #include <stdexcept>
 
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
 #include "libpq-fe.h"
 
 //#include "libpq/libpq-fs.h"
@@ -46,6 +53,24 @@ inline int StdModeToPQMode(std::ios::openmode mode)
 }
 
 
+/// read() on a file descriptor, retrying if interrupted by a signal
+long read_fd(int fd, char Buf[], long Len)
+{
+  long n;
+  do n = long(::read(fd, Buf, Len)); while (n == -1 && errno == EINTR);
+  return n;
+}
+
+
+/// write() on a file descriptor, retrying if interrupted by a signal
+long write_fd(int fd, const char Buf[], long Len)
+{
+  long n;
+  do n = long(::write(fd, Buf, Len)); while (n == -1 && errno == EINTR);
+  return n;
+}
+
+
 inline int StdDirToPQDir(std::ios::seekdir dir) PQXX_NOEXCEPT
 {
   // TODO: Figure out whether seekdir values match C counterparts!
@@ -70,9 +95,25 @@ inline int StdDirToPQDir(std::ios::seekdir dir) PQXX_NOEXCEPT
 }
 
 
+/// Narrow a 64-bit position to a pos_type, or report that it won't fit.
+pqxx::largeobjectaccess::pos_type
+narrow(pqxx::largeobjectaccess::pos64_type pos) PQXX_NOEXCEPT
+{
+  if (pos > LONG_MAX)
+  {
+    errno = ERANGE;
+    return -1;
+  }
+  return pqxx::largeobjectaccess::pos_type(pos);
+}
+
+
 } // namespace
 
 
+const pqxx::largeobject::size_type pqxx::largeobject::default_buffer_size;
+
+
 pqxx::largeobject::largeobject() PQXX_NOEXCEPT :
   m_ID(oid_none)
 {
@@ -82,6 +123,7 @@ pqxx::largeobject::largeobject() PQXX_NOEXCEPT :
 pqxx::largeobject::largeobject(dbtransaction &T) :
   m_ID()
 {
+  ensure_begun(T);
   m_ID = lo_creat(RawConnection(T), INV_READ|INV_WRITE);
   if (m_ID == oid_none)
   {
@@ -95,6 +137,7 @@ pqxx::largeobject::largeobject(dbtransaction &T) :
 pqxx::largeobject::largeobject(dbtransaction &T, const std::string &File) :
   m_ID()
 {
+  ensure_begun(T);
   m_ID = lo_import(RawConnection(T), File.c_str());
   if (m_ID == oid_none)
   {
@@ -106,6 +149,65 @@ pqxx::largeobject::largeobject(dbtransaction &T, const std::string &File) :
 }
 
 
+pqxx::largeobject::largeobject(
+	dbtransaction &T,
+	const char Data[],
+	size_type Len) :
+  m_ID(largeobject(T).id())
+{
+  try
+  {
+    largeobjectaccess A(T, *this, std::ios::out);
+    for (size_type i = 0; i < Len; i += default_buffer_size)
+      A.write(Data + i, std::min(Len - i, default_buffer_size));
+  }
+  catch (const std::exception &)
+  {
+    discard(T);
+    throw;
+  }
+}
+
+
+pqxx::largeobject pqxx::largeobject::from_fd(dbtransaction &T, int fd)
+{
+  const largeobject L(T);
+  try
+  {
+    largeobjectaccess A(T, L, std::ios::out);
+    std::string Buf(std::string::size_type(default_buffer_size), '\0');
+    for (bool eof = false; !eof; )
+    {
+      // Fill the buffer before sending it, so each write is a big one.
+      size_type Len = 0;
+      while (Len < default_buffer_size)
+      {
+        const long n = read_fd(fd, &Buf[Len], default_buffer_size - Len);
+        if (n == -1)
+        {
+          const int err = errno;
+          throw failure("Could not read file descriptor " + to_string(fd) +
+		" into large object: " + L.Reason(err));
+        }
+        if (n == 0)
+        {
+          eof = true;
+          break;
+        }
+        Len += n;
+      }
+      if (Len) A.write(Buf.data(), Len);
+    }
+  }
+  catch (const std::exception &)
+  {
+    L.discard(T);
+    throw;
+  }
+  return L;
+}
+
+
 pqxx::largeobject::largeobject(const largeobjectaccess &O) PQXX_NOEXCEPT :
   m_ID(O.id())
 {
@@ -115,6 +217,7 @@ pqxx::largeobject::largeobject(const largeobjectaccess &O) PQXX_NOEXCEPT :
 void pqxx::largeobject::to_file(dbtransaction &T,
 	const std::string &File) const
 {
+  ensure_begun(T);
   if (lo_export(RawConnection(T), id(), File.c_str()) == -1)
   {
     const int err = errno;
@@ -126,8 +229,47 @@ void pqxx::largeobject::to_file(dbtransaction &T,
 }
 
 
+void pqxx::largeobject::to_buffer(dbtransaction &T, std::string &Buf) const
+{
+  largeobjectaccess A(T, *this, std::ios::in);
+  Buf.clear();
+
+  // Read straight into the string, growing it a chunk at a time.
+  std::string::size_type Len = 0;
+  for (size_type n = default_buffer_size; n == default_buffer_size; )
+  {
+    Buf.resize(Len + std::string::size_type(default_buffer_size));
+    n = A.read(&Buf[Len], default_buffer_size);
+    Len += std::string::size_type(n);
+  }
+  Buf.resize(Len);
+}
+
+
+void pqxx::largeobject::to_fd(dbtransaction &T, int fd) const
+{
+  largeobjectaccess A(T, *this, std::ios::in);
+  std::string Buf(std::string::size_type(default_buffer_size), '\0');
+  for (size_type Len; (Len = A.read(&Buf[0], default_buffer_size)) > 0; )
+  {
+    for (size_type i = 0; i < Len; )
+    {
+      const long n = write_fd(fd, Buf.data() + i, Len - i);
+      if (n == -1)
+      {
+        const int err = errno;
+        throw failure("Could not write large object " + to_string(m_ID) +
+		" to file descriptor " + to_string(fd) + ": " + Reason(err));
+      }
+      i += n;
+    }
+  }
+}
+
+
 void pqxx::largeobject::remove(dbtransaction &T) const
 {
+  ensure_begun(T);
   if (lo_unlink(RawConnection(T), id()) == -1)
   {
     const int err = errno;
@@ -138,6 +280,18 @@ void pqxx::largeobject::remove(dbtransaction &T) const
 }
 
 
+void pqxx::largeobject::discard(dbtransaction &T) const PQXX_NOEXCEPT
+{
+  try
+  {
+    remove(T);
+  }
+  catch (const std::exception &)
+  {
+  }
+}
+
+
 pqxx::internal::pq::PGconn *pqxx::largeobject::RawConnection(
 	const dbtransaction &T)
 {
@@ -145,6 +299,15 @@ pqxx::internal::pq::PGconn *pqxx::largeobject::RawConnection(
 }
 
 
+// With deferred BEGIN, the transaction may not have started on the backend
+// yet.  Large object calls don't go through the regular query path, so they
+// would run outside the transaction.
+void pqxx::largeobject::ensure_begun(const dbtransaction &T)
+{
+  gate::connection_largeobject(T.conn()).flush_deferred();
+}
+
+
 std::string pqxx::largeobject::Reason(int err) const
 {
   if (err == ENOMEM) return "Out of memory";
@@ -212,9 +375,41 @@ pqxx::largeobjectaccess::seek(size_type dest, seekdir dir)
 }
 
 
+pqxx::largeobjectaccess::pos64_type
+pqxx::largeobjectaccess::seek64(off64_type dest, seekdir dir)
+{
+  const pos64_type Result = cseek64(dest, dir);
+  if (Result == -1)
+  {
+    const int err = errno;
+    if (err == ENOMEM) throw std::bad_alloc();
+    throw failure("Error seeking in large object: " + Reason(err));
+  }
+
+  return Result;
+}
+
+
 pqxx::largeobjectaccess::pos_type
 pqxx::largeobjectaccess::cseek(off_type dest, seekdir dir) PQXX_NOEXCEPT
 {
+  if (large_offsets()) return narrow(cseek64(dest, dir));
+  return lo_lseek(RawConnection(), m_fd, int(dest), StdDirToPQDir(dir));
+}
+
+
+pqxx::largeobjectaccess::pos64_type
+pqxx::largeobjectaccess::cseek64(off64_type dest, seekdir dir) PQXX_NOEXCEPT
+{
+#ifdef PQXX_HAVE_LO_64
+  if (large_offsets())
+    return lo_lseek64(RawConnection(), m_fd, dest, StdDirToPQDir(dir));
+#endif
+  if (dest > INT_MAX || dest < INT_MIN)
+  {
+    errno = ERANGE;
+    return -1;
+  }
   return lo_lseek(RawConnection(), m_fd, int(dest), StdDirToPQDir(dir));
 }
 
@@ -239,10 +434,47 @@ pqxx::largeobjectaccess::cread(char Buf[], size_type Bytes) PQXX_NOEXCEPT
 pqxx::largeobjectaccess::pos_type
 pqxx::largeobjectaccess::ctell() const PQXX_NOEXCEPT
 {
+  if (large_offsets()) return narrow(ctell64());
+  return lo_tell(RawConnection(), m_fd);
+}
+
+
+pqxx::largeobjectaccess::pos64_type
+pqxx::largeobjectaccess::ctell64() const PQXX_NOEXCEPT
+{
+#ifdef PQXX_HAVE_LO_64
+  if (large_offsets()) return lo_tell64(RawConnection(), m_fd);
+#endif
   return lo_tell(RawConnection(), m_fd);
 }
 
 
+int pqxx::largeobjectaccess::ctruncate(pos64_type Len) PQXX_NOEXCEPT
+{
+#ifdef PQXX_HAVE_LO_64
+  if (large_offsets()) return lo_truncate64(RawConnection(), m_fd, Len);
+#endif
+  if (Len > INT_MAX)
+  {
+    errno = ERANGE;
+    return -1;
+  }
+  return lo_truncate(RawConnection(), m_fd, size_t(Len));
+}
+
+
+void pqxx::largeobjectaccess::truncate(pos64_type Len)
+{
+  if (ctruncate(Len) == -1)
+  {
+    const int err = errno;
+    if (err == ENOMEM) throw std::bad_alloc();
+    throw failure("Could not truncate large object #" + to_string(id()) +
+	": " + Reason(err));
+  }
+}
+
+
 void pqxx::largeobjectaccess::write(const char Buf[], size_type Len)
 {
   const long Bytes = cwrite(Buf, Len);
@@ -281,6 +513,7 @@ pqxx::largeobjectaccess::read(char Buf[], size_type Len)
 
 void pqxx::largeobjectaccess::open(openmode mode)
 {
+  ensure_begun(m_Trans);
   m_fd = lo_open(RawConnection(), id(), StdModeToPQMode(mode));
   if (m_fd < 0)
   {
@@ -306,6 +539,21 @@ pqxx::largeobjectaccess::size_type pqxx::largeobjectaccess::tell() const
 }
 
 
+pqxx::largeobjectaccess::pos64_type
+pqxx::largeobjectaccess::tell64() const
+{
+  const pos64_type res = ctell64();
+  if (res == -1) throw failure(Reason(errno));
+  return res;
+}
+
+
+bool pqxx::largeobjectaccess::large_offsets() const PQXX_NOEXCEPT
+{
+  return m_Trans.conn().supports(connection_base::cap_large_objects_64);
+}
+
+
 std::string pqxx::largeobjectaccess::Reason(int err) const
 {
   return (m_fd == -1) ? "No object opened" : largeobject::Reason(err);
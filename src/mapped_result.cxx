@@ -0,0 +1,469 @@
+/*-------------------------------------------------------------------------
+ *
+ *   FILE
+ *	mapped_result.cxx
+ *
+ *   DESCRIPTION
+ *      implementation of the pqxx::mapped_result and related classes.
+ *   Spill query results to disk, and read them back through a memory map.
+ *
+ * Copyright (c) 2016, Jeroen T. Vermeulen <jtv@xs4all.nl>
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this mistake,
+ * or contact the author.
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "pqxx/compiler-internal.hxx"
+
+#include <cerrno>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "pqxx/cursor"
+#include "pqxx/mapped_result"
+#include "pqxx/row_scanner"
+
+
+/* File layout, all numbers in native byte order:
+ *
+ * Header (40 bytes):
+ *   0	magic "PQXXSPL1"
+ *   8	number of rows (64 bits)
+ *   16	number of columns (32 bits)
+ *   20	byte order marker 0x01020304 (32 bits)
+ *   24	offset of row index (64 bits)
+ *   32	offset of column descriptions (64 bits)
+ *
+ * Rows, each starting at a 4-byte boundary: for every column, the 32-bit
+ * offset just past the end of its text, relative to the start of the row's
+ * text, with the top bit set for nulls.  Then the text of all fields, each
+ * with a terminating zero.  Nulls are stored as empty strings.
+ *
+ * Row index, at an 8-byte boundary: a 64-bit file offset for every row.
+ *
+ * Column descriptions: for every column, its 32-bit type oid followed by its
+ * zero-terminated name.
+ */
+namespace
+{
+typedef char int_is_32_bits[(sizeof(int) == 4) ? 1 : -1];
+typedef char long_long_is_64_bits[(sizeof(long long) == 8) ? 1 : -1];
+
+const char magic[] = "PQXXSPL1";
+const unsigned int byte_order_marker = 0x01020304u;
+const size_t header_size = 40;
+const unsigned int null_bit = 0x80000000u;
+
+
+std::string error_string(int err)
+{
+  char buf[500];
+  return pqxx::internal::strerror_wrapper(err, buf, sizeof(buf));
+}
+
+
+template<typename T> void put(char *Buf, size_t Pos, T Value)
+{
+  std::memcpy(Buf + Pos, &Value, sizeof(Value));
+}
+
+
+template<typename T> T get(const unsigned char *Buf, size_t Pos)
+{
+  T Value;
+  std::memcpy(&Value, Buf + Pos, sizeof(Value));
+  return Value;
+}
+} // namespace
+
+
+pqxx::result_spiller::result_spiller(const std::string &Path) :
+  m_path(Path),
+  m_file(0),
+  m_index(0),
+  m_pos(0),
+  m_rows(0),
+  m_have_columns(false),
+  m_names(),
+  m_types(),
+  m_row()
+{
+  m_file = std::fopen(Path.c_str(), "wb");
+  if (!m_file)
+    throw failure("Could not create " + Path + ": " + error_string(errno));
+
+  m_index = std::tmpfile();
+  if (!m_index)
+  {
+    const int err = errno;
+    close();
+    std::remove(Path.c_str());
+    throw failure("Could not create temporary file: " + error_string(err));
+  }
+
+  // Leave room for the header; finish() fills it in.
+  try
+  {
+    const char blank[header_size] = { 0 };
+    write(blank, sizeof(blank));
+  }
+  catch (const std::exception &)
+  {
+    close();
+    std::remove(Path.c_str());
+    throw;
+  }
+}
+
+
+pqxx::result_spiller::~result_spiller() PQXX_NOEXCEPT
+{
+  if (m_file)
+  {
+    close();
+    std::remove(m_path.c_str());
+  }
+}
+
+
+void pqxx::result_spiller::append(const result &R)
+{
+  check_open();
+
+  const row::size_type cols = R.columns();
+  if (!m_have_columns)
+  {
+    for (row::size_type c = 0; c < cols; ++c)
+    {
+      m_names.push_back(R.column_name(c));
+      m_types.push_back(R.column_type(c));
+    }
+    m_have_columns = true;
+  }
+  else if (cols != m_names.size())
+  {
+    throw usage_error(
+	"Spilling result with " + to_string(cols) + " columns "
+	"to file with " + to_string(m_names.size()));
+  }
+
+  const size_t ends_size = cols * sizeof(unsigned int);
+  row_scanner s(R);
+  while (s.next())
+  {
+    const char *const *values = s.values();
+    const int *lengths = s.lengths();
+
+    m_row.resize(ends_size);
+    for (row::size_type c = 0; c < cols; ++c)
+    {
+      if (lengths[c] > 0)
+        m_row.insert(m_row.end(), values[c], values[c] + lengths[c]);
+      m_row.push_back('\0');
+
+      const size_t end = m_row.size() - ends_size;
+      if (end >= null_bit) throw failure("Row too large to spill to disk");
+      put(
+	&m_row[0],
+	c * sizeof(unsigned int),
+	static_cast<unsigned int>(end) | ((lengths[c] < 0) ? null_bit : 0));
+    }
+
+    pad(sizeof(unsigned int));
+    const unsigned long long offset = m_pos;
+    write(m_row.empty() ? 0 : &m_row[0], m_row.size());
+    if (std::fwrite(&offset, sizeof(offset), 1, m_index) != 1)
+      throw failure("Could not write row index: " + error_string(errno));
+    ++m_rows;
+  }
+}
+
+
+pqxx::result_spiller::size_type pqxx::result_spiller::read(
+	icursorstream &Stream)
+{
+  size_type n = 0;
+  result Block;
+  while (Stream >> Block)
+  {
+    append(Block);
+    n += Block.size();
+  }
+  return n;
+}
+
+
+void pqxx::result_spiller::finish()
+{
+  check_open();
+
+  // Copy the row index.
+  pad(sizeof(unsigned long long));
+  const unsigned long long index_offset = m_pos;
+  std::rewind(m_index);
+  char buf[8192];
+  size_t n;
+  while ((n = std::fread(buf, 1, sizeof(buf), m_index)) > 0) write(buf, n);
+  if (std::ferror(m_index))
+    throw failure("Could not read row index: " + error_string(errno));
+
+  // Column descriptions.
+  const unsigned long long columns_offset = m_pos;
+  for (std::vector<std::string>::size_type c = 0; c < m_names.size(); ++c)
+  {
+    const unsigned int type = m_types[c];
+    write(&type, sizeof(type));
+    write(m_names[c].c_str(), m_names[c].size() + 1);
+  }
+
+  char header[header_size];
+  std::memcpy(header, magic, 8);
+  put(header, 8, static_cast<unsigned long long>(m_rows));
+  put(header, 16, static_cast<unsigned int>(m_names.size()));
+  put(header, 20, byte_order_marker);
+  put(header, 24, index_offset);
+  put(header, 32, columns_offset);
+  if (std::fseek(m_file, 0, SEEK_SET) != 0 ||
+      std::fwrite(header, sizeof(header), 1, m_file) != 1 ||
+      std::fflush(m_file) != 0)
+    throw failure("Could not write " + m_path + ": " + error_string(errno));
+
+  std::FILE *const f = m_file;
+  m_file = 0;
+  std::fclose(m_index);
+  m_index = 0;
+  if (std::fclose(f) != 0)
+  {
+    const int err = errno;
+    std::remove(m_path.c_str());
+    throw failure("Could not close " + m_path + ": " + error_string(err));
+  }
+}
+
+
+void pqxx::result_spiller::write(const void *Data, size_t Len)
+{
+  if (Len && std::fwrite(Data, 1, Len, m_file) != Len)
+    throw failure("Could not write " + m_path + ": " + error_string(errno));
+  m_pos += Len;
+}
+
+
+void pqxx::result_spiller::pad(size_t Alignment)
+{
+  const char zeroes[8] = { 0 };
+  const size_t excess = size_t(m_pos % Alignment);
+  if (excess) write(zeroes, Alignment - excess);
+}
+
+
+void pqxx::result_spiller::check_open() const
+{
+  if (!m_file) throw usage_error("Spill file " + m_path + " is already closed");
+}
+
+
+void pqxx::result_spiller::close() PQXX_NOEXCEPT
+{
+  if (m_index) std::fclose(m_index);
+  m_index = 0;
+  if (m_file) std::fclose(m_file);
+  m_file = 0;
+}
+
+
+pqxx::mapped_field pqxx::mapped_row::operator[](const char ColName[]) const
+{
+  return operator[](m_home->column_number(ColName));
+}
+
+
+pqxx::mapped_field pqxx::mapped_row::at(size_type Col) const
+{
+  if (Col >= m_columns) throw range_error("Invalid field number");
+  return operator[](Col);
+}
+
+
+pqxx::mapped_field pqxx::mapped_row::at(int Col) const
+{
+  if (Col < 0) throw range_error("Invalid field number");
+  return at(size_type(Col));
+}
+
+
+pqxx::mapped_result::mapped_result(const std::string &Path) :
+  m_base(0),
+  m_length(0),
+  m_rows(0),
+  m_columns(0),
+  m_index(0),
+  m_names(),
+  m_types()
+#ifdef _WIN32
+  , m_file(INVALID_HANDLE_VALUE),
+  m_mapping(0)
+#endif
+{
+#ifdef _WIN32
+  m_file = CreateFileA(
+	Path.c_str(),
+	GENERIC_READ,
+	FILE_SHARE_READ,
+	0,
+	OPEN_EXISTING,
+	FILE_ATTRIBUTE_NORMAL,
+	0);
+  if (m_file == INVALID_HANDLE_VALUE)
+    throw failure("Could not open " + Path);
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(m_file, &size))
+  {
+    unmap();
+    throw failure("Could not get size of " + Path);
+  }
+  m_length = static_cast<unsigned long long>(size.QuadPart);
+  if (m_length >= header_size)
+  {
+    m_mapping = CreateFileMappingA(m_file, 0, PAGE_READONLY, 0, 0, 0);
+    if (m_mapping)
+      m_base = static_cast<const unsigned char *>(
+	MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!m_base)
+    {
+      unmap();
+      throw failure("Could not map " + Path);
+    }
+  }
+#else
+  const int fd = ::open(Path.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw failure("Could not open " + Path + ": " + error_string(errno));
+  struct stat st;
+  if (fstat(fd, &st) != 0)
+  {
+    const int err = errno;
+    ::close(fd);
+    throw failure("Could not get size of " + Path + ": " + error_string(err));
+  }
+  m_length = static_cast<unsigned long long>(st.st_size);
+  if (m_length >= header_size)
+  {
+    void *const p = mmap(0, size_t(m_length), PROT_READ, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED)
+    {
+      const int err = errno;
+      ::close(fd);
+      throw failure("Could not map " + Path + ": " + error_string(err));
+    }
+    m_base = static_cast<const unsigned char *>(p);
+  }
+  // The mapping stays valid without the file descriptor.
+  ::close(fd);
+#endif
+
+  try
+  {
+    if (m_length < header_size ||
+        std::memcmp(m_base, magic, 8) != 0 ||
+        get<unsigned int>(m_base, 20) != byte_order_marker)
+      throw failure("Not a valid spill file: " + Path);
+
+    const unsigned long long
+	rows = get<unsigned long long>(m_base, 8),
+	index_offset = get<unsigned long long>(m_base, 24),
+	columns_offset = get<unsigned long long>(m_base, 32);
+    m_columns = get<unsigned int>(m_base, 16);
+    if (index_offset % sizeof(unsigned long long) ||
+        index_offset > columns_offset ||
+        columns_offset > m_length ||
+        (columns_offset - index_offset) / sizeof(unsigned long long) != rows)
+      throw failure("Corrupt spill file: " + Path);
+    m_rows = size_type(rows);
+    m_index = reinterpret_cast<const unsigned long long *>(
+	m_base + index_offset);
+
+    const char *p = reinterpret_cast<const char *>(m_base + columns_offset);
+    const char *const end = reinterpret_cast<const char *>(m_base + m_length);
+    for (row::size_type c = 0; c < m_columns; ++c)
+    {
+      if (end - p < 5) throw failure("Corrupt spill file: " + Path);
+      m_types.push_back(get<unsigned int>(
+	reinterpret_cast<const unsigned char *>(p),
+	0));
+      p += sizeof(unsigned int);
+      const void *const z = std::memchr(p, '\0', size_t(end - p));
+      if (!z) throw failure("Corrupt spill file: " + Path);
+      m_names.push_back(p);
+      p = static_cast<const char *>(z) + 1;
+    }
+  }
+  catch (const std::exception &)
+  {
+    unmap();
+    throw;
+  }
+}
+
+
+pqxx::mapped_result::~mapped_result() PQXX_NOEXCEPT
+{
+  unmap();
+}
+
+
+pqxx::mapped_row pqxx::mapped_result::at(size_type Row) const
+{
+  if (Row >= m_rows) throw range_error("Row number out of range");
+  return operator[](Row);
+}
+
+
+const char *pqxx::mapped_result::column_name(row::size_type Col) const
+{
+  if (Col >= m_columns)
+    throw range_error("Invalid column number: " + to_string(Col));
+  return m_names[Col];
+}
+
+
+pqxx::oid pqxx::mapped_result::column_type(row::size_type Col) const
+{
+  if (Col >= m_columns)
+    throw range_error("Invalid column number: " + to_string(Col));
+  return m_types[Col];
+}
+
+
+pqxx::row::size_type pqxx::mapped_result::column_number(
+	const char ColName[]) const
+{
+  for (row::size_type c = 0; c < m_columns; ++c)
+    if (std::strcmp(m_names[c], ColName) == 0) return c;
+  throw argument_error("Unknown column name: '" + std::string(ColName) + "'");
+}
+
+
+void pqxx::mapped_result::unmap() PQXX_NOEXCEPT
+{
+#ifdef _WIN32
+  if (m_base) UnmapViewOfFile(m_base);
+  if (m_mapping) CloseHandle(m_mapping);
+  if (m_file != INVALID_HANDLE_VALUE) CloseHandle(m_file);
+  m_mapping = 0;
+  m_file = INVALID_HANDLE_VALUE;
+#else
+  if (m_base) munmap(const_cast<unsigned char *>(m_base), size_t(m_length));
+#endif
+  m_base = 0;
+}
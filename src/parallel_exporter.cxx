@@ -0,0 +1,267 @@
+/*-------------------------------------------------------------------------
+ *
+ *   FILE
+ *	parallel_exporter.cxx
+ *
+ *   DESCRIPTION
+ *      implementation of the pqxx::parallel_exporter class.
+ *   Reads a table through several connections at once, from one snapshot
+ *
+ * Copyright (c) 2016, Jeroen T. Vermeulen <jtv@xs4all.nl>
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this mistake,
+ * or contact the author.
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "pqxx/compiler-internal.hxx"
+
+#include "pqxx/parallel_exporter"
+#include "pqxx/transaction"
+
+
+/// One connection's share of the work: a transaction and a COPY.
+class pqxx::parallel_exporter::shard
+{
+public:
+  explicit shard(connection_base &C) :
+    m_trans(C, "parallel_exporter"),
+    m_reader(0)
+  {
+  }
+
+  ~shard() PQXX_NOEXCEPT { delete m_reader; }
+
+  /// Start reading.  The query goes where COPY expects a table name.
+  void start(const std::string &Query)
+	{ m_reader = new tablereader(m_trans, "(" + Query + ")"); }
+
+  transaction<repeatable_read, read_only> m_trans;
+  tablereader *m_reader;
+
+private:
+  /// Not allowed
+  shard(const shard &);
+  /// Not allowed
+  shard &operator=(const shard &);
+};
+
+
+pqxx::parallel_exporter::sink::~sink()
+{
+}
+
+
+pqxx::parallel_exporter::parallel_exporter(const std::string &Table) :
+  m_table(Table),
+  m_columns(),
+  m_conns(),
+  m_conditions(),
+  m_shards(),
+  m_next(0),
+  m_live(0),
+  m_rows(0),
+  m_started(false)
+{
+}
+
+
+pqxx::parallel_exporter::~parallel_exporter() PQXX_NOEXCEPT
+{
+  close();
+}
+
+
+void pqxx::parallel_exporter::add_connection(connection_base &C)
+{
+  if (m_started)
+    throw usage_error("Adding connection to parallel_exporter after start");
+  m_conns.push_back(&C);
+}
+
+
+void pqxx::parallel_exporter::partition(
+	const std::vector<std::string> &conditions)
+{
+  if (m_started)
+    throw usage_error("Partitioning parallel_exporter after start");
+  m_conditions = conditions;
+}
+
+
+bool pqxx::parallel_exporter::get_raw_line(std::string &Line)
+{
+  size_type Source;
+  return get_raw_line(Line, Source);
+}
+
+
+bool pqxx::parallel_exporter::get_raw_line(
+	std::string &Line,
+	size_type &Source)
+{
+  if (!m_started) start();
+
+  try
+  {
+    while (m_live)
+    {
+      // Take a row from the next connection that has one.
+      for (std::vector<shard *>::size_type n = 0; n < m_shards.size(); ++n)
+      {
+        const std::vector<shard *>::size_type here = m_next;
+        if (++m_next == m_shards.size()) m_next = 0;
+
+        tablereader &R = *m_shards[here]->m_reader;
+        if (!R) continue;
+        if (R.try_get_raw_line(Line))
+        {
+          Source = here;
+          ++m_rows;
+          return true;
+        }
+        if (!R) --m_live;
+      }
+
+      if (m_live)
+      {
+        std::vector<std::pair<int, bool> > socks;
+        for (std::vector<shard *>::size_type i = 0; i < m_shards.size(); ++i)
+        {
+          const tablereader &R = *m_shards[i]->m_reader;
+          if (R) socks.push_back(std::make_pair(R.sock(), false));
+        }
+        internal::wait_any(socks);
+      }
+    }
+  }
+  catch (const std::exception &)
+  {
+    close();
+    throw;
+  }
+  return false;
+}
+
+
+void pqxx::parallel_exporter::export_to(sink &s)
+{
+  std::string Line;
+  size_type Source;
+  while (get_raw_line(Line, Source)) s(Line, Source);
+}
+
+
+void pqxx::parallel_exporter::complete()
+{
+  if (!m_started) start();
+
+  try
+  {
+    for (std::vector<shard *>::size_type i = 0; i < m_shards.size(); ++i)
+    {
+      m_shards[i]->m_reader->complete();
+      m_shards[i]->m_trans.commit();
+    }
+  }
+  catch (const std::exception &)
+  {
+    close();
+    throw;
+  }
+  close();
+}
+
+
+void pqxx::parallel_exporter::start()
+{
+  if (m_conns.empty())
+    throw usage_error("Starting parallel_exporter without connections");
+  if (!m_conditions.empty() && m_conditions.size() != m_conns.size())
+    throw usage_error(
+	"parallel_exporter has " + to_string(m_conns.size()) + " connections, "
+	"but " + to_string(m_conditions.size()) + " partitions");
+
+  m_started = true;
+  try
+  {
+    m_shards.reserve(m_conns.size());
+    m_shards.push_back(new shard(*m_conns[0]));
+
+    // Let all transactions share the first one's snapshot.  This must happen
+    // before they execute any queries.
+    if (m_conns.size() > 1)
+    {
+      transaction_base &Leader = m_shards[0]->m_trans;
+      const std::string Snapshot =
+	Leader.exec("SELECT pg_export_snapshot()")[0][0].as<std::string>();
+      for (std::vector<connection_base *>::size_type i = 1;
+	   i < m_conns.size();
+	   ++i)
+      {
+        m_shards.push_back(new shard(*m_conns[i]));
+        transaction_base &T = m_shards.back()->m_trans;
+        T.exec("SET TRANSACTION SNAPSHOT " + T.quote(Snapshot));
+      }
+    }
+
+    if (m_conditions.empty())
+      m_conditions = ctid_partitions(m_shards[0]->m_trans);
+
+    const std::string Select =
+	"SELECT " + (m_columns.empty() ? std::string("*") : m_columns) +
+	" FROM " + m_table;
+    for (std::vector<shard *>::size_type i = 0; i < m_shards.size(); ++i)
+      m_shards[i]->start(
+	m_conditions[i].empty() ?
+		Select :
+		Select + " WHERE " + m_conditions[i]);
+    m_live = m_shards.size();
+  }
+  catch (const std::exception &)
+  {
+    close();
+    throw;
+  }
+}
+
+
+std::vector<std::string>
+pqxx::parallel_exporter::ctid_partitions(transaction_base &T)
+{
+  const std::vector<std::string>::size_type n = m_conns.size();
+  std::vector<std::string> conditions(n);
+  if (n < 2) return conditions;
+
+  // Split the table's pages evenly.  The first and last partitions are open-
+  // ended, so nothing gets lost if the table's size changes meanwhile.
+  // Before PostgreSQL 14 there is no TID range scan, so each of these becomes
+  // a sequential scan of the whole table; see the class documentation.
+  const unsigned long pages = T.exec(
+	"SELECT pg_relation_size(" + T.quote(m_table) + "::regclass) / "
+	"current_setting('block_size')::bigint")[0][0].as<unsigned long>();
+  const unsigned long per_shard = pages / n + 1;
+  for (std::vector<std::string>::size_type i = 0; i < n; ++i)
+  {
+    std::string C;
+    if (i > 0)
+      C = "ctid >= '(" + to_string(i*per_shard) + ",0)'::tid";
+    if (i+1 < n)
+    {
+      if (!C.empty()) C += " AND ";
+      C += "ctid < '(" + to_string((i+1)*per_shard) + ",0)'::tid";
+    }
+    conditions[i] = C;
+  }
+  return conditions;
+}
+
+
+void pqxx::parallel_exporter::close() PQXX_NOEXCEPT
+{
+  for (std::vector<shard *>::size_type i = 0; i < m_shards.size(); ++i)
+    delete m_shards[i];
+  m_shards.clear();
+  m_live = 0;
+}
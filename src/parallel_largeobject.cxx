@@ -0,0 +1,475 @@
+/*-------------------------------------------------------------------------
+ *
+ *   FILE
+ *	parallel_largeobject.cxx
+ *
+ *   DESCRIPTION
+ *      implementation of the pqxx::parallel_largeobject class.
+ *   Transfers a large object through several connections at once
+ *
+ * Copyright (c) 2016, Jeroen T. Vermeulen <jtv@xs4all.nl>
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this mistake,
+ * or contact the author.
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "pqxx/compiler-internal.hxx"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#include "pqxx/async_query"
+#include "pqxx/binarystring"
+#include "pqxx/parallel_largeobject"
+#include "pqxx/transaction"
+
+
+namespace
+{
+typedef std::vector<pqxx::partial_write_error::range> range_list;
+
+/// Sort ranges, and merge those that touch or overlap.
+range_list merge(range_list R)
+{
+  std::sort(R.begin(), R.end());
+  range_list Merged;
+  for (range_list::const_iterator i = R.begin(); i != R.end(); ++i)
+  {
+    if (!Merged.empty() && i->first <= Merged.back().second)
+      Merged.back().second = std::max(Merged.back().second, i->second);
+    else
+      Merged.push_back(*i);
+  }
+  return Merged;
+}
+
+
+std::string describe(const range_list &R)
+{
+  if (R.empty()) return "none";
+  std::string Text;
+  for (range_list::const_iterator i = R.begin(); i != R.end(); ++i)
+  {
+    if (i != R.begin()) Text += ", ";
+    Text +=
+	"[" + pqxx::to_string(i->first) + ", " + pqxx::to_string(i->second) +
+	")";
+  }
+  return Text;
+}
+} // namespace
+
+
+pqxx::partial_write_error::partial_write_error(
+	const std::string &whatarg,
+	const std::vector<range> &Committed,
+	const std::vector<range> &InDoubt) :
+  failure(
+	whatarg + "\nCommitted bytes: " + describe(merge(Committed)) +
+	"\nBytes in doubt: " + describe(merge(InDoubt))),
+  m_committed(merge(Committed)),
+  m_in_doubt(merge(InDoubt))
+{
+}
+
+
+pqxx::partial_write_error::~partial_write_error() PQXX_NOEXCEPT
+{
+}
+
+
+/// Where a transfer's data comes from, or goes to, on the client side.
+class pqxx::parallel_largeobject::endpoint
+{
+public:
+  virtual ~endpoint() {}
+
+  /// Store data read from the object at the given offset.
+  virtual void put(size_type Offset, const unsigned char Data[], size_type Len)
+	=0;
+
+  /// Fetch data to write to the object at the given offset.
+  virtual std::string get(size_type Offset, size_type Len) =0;
+};
+
+
+class pqxx::parallel_largeobject::memory_endpoint : public endpoint
+{
+public:
+  /// Read into Buf, which must be large enough to hold the object.
+  explicit memory_endpoint(char Buf[]) : m_in(Buf), m_out(Buf) {}
+
+  /// Write from Buf.
+  explicit memory_endpoint(const char Buf[]) : m_in(Buf), m_out(0) {}
+
+  virtual void put(size_type Offset, const unsigned char Data[], size_type Len)
+	PQXX_OVERRIDE
+  {
+    std::memcpy(m_out + Offset, Data, size_t(Len));
+  }
+
+  virtual std::string get(size_type Offset, size_type Len) PQXX_OVERRIDE
+  {
+    return std::string(m_in + Offset, std::string::size_type(Len));
+  }
+
+private:
+  const char *m_in;
+  char *m_out;
+};
+
+
+class pqxx::parallel_largeobject::file_endpoint : public endpoint
+{
+public:
+  file_endpoint(const std::string &File, std::ios::openmode Mode) :
+    m_name(File),
+    m_file(File.c_str(), Mode | std::ios::binary)
+  {
+    if (!m_file) throw failure("Could not open file '" + File + "'");
+  }
+
+  /// Size of the file, for writing it to the object.
+  size_type size()
+  {
+    m_file.seekg(0, std::ios::end);
+    const std::streamoff end = m_file.tellg();
+    if (end < 0) throw failure("Could not read file '" + m_name + "'");
+    return size_type(end);
+  }
+
+  virtual void put(size_type Offset, const unsigned char Data[], size_type Len)
+	PQXX_OVERRIDE
+  {
+    m_file.seekp(std::streamoff(Offset));
+    m_file.write(reinterpret_cast<const char *>(Data), std::streamsize(Len));
+    if (!m_file) throw failure("Could not write file '" + m_name + "'");
+  }
+
+  virtual std::string get(size_type Offset, size_type Len) PQXX_OVERRIDE
+  {
+    std::string Data(std::string::size_type(Len), '\0');
+    m_file.seekg(std::streamoff(Offset));
+    if (Len) m_file.read(&Data[0], std::streamsize(Len));
+    if (!m_file) throw failure("Could not read file '" + m_name + "'");
+    return Data;
+  }
+
+private:
+  std::string m_name;
+  std::fstream m_file;
+};
+
+
+/// One connection's share of the work: a transaction, and a chunk in flight.
+class pqxx::parallel_largeobject::shard
+{
+public:
+  explicit shard(connection_base &C) :
+    m_trans(C, "parallel_largeobject"),
+    m_query(0),
+    m_offset(0)
+  {
+  }
+
+  ~shard() PQXX_NOEXCEPT { delete m_query; }
+
+  transaction<repeatable_read> m_trans;
+  async_query *m_query;
+
+  /// Offset of the chunk in flight
+  size_type m_offset;
+
+  /// Byte ranges written through this shard's transaction
+  std::vector<partial_write_error::range> m_written;
+
+private:
+  /// Not allowed
+  shard(const shard &);
+  /// Not allowed
+  shard &operator=(const shard &);
+};
+
+
+pqxx::parallel_largeobject::parallel_largeobject(
+	oid Object,
+	size_type ChunkSize) :
+  m_object(Object),
+  m_chunk(ChunkSize),
+  m_conns(),
+  m_shards(),
+  m_next(0),
+  m_bytes(0)
+{
+  if (ChunkSize <= 0)
+    throw argument_error("parallel_largeobject needs a positive chunk size");
+}
+
+
+pqxx::parallel_largeobject::~parallel_largeobject() PQXX_NOEXCEPT
+{
+  close();
+}
+
+
+void pqxx::parallel_largeobject::add_connection(connection_base &C)
+{
+  m_conns.push_back(&C);
+}
+
+
+void pqxx::parallel_largeobject::read(std::string &Buf)
+{
+  start(false);
+  try
+  {
+    const size_type Size = object_size();
+    Buf.assign(std::string::size_type(Size), '\0');
+    memory_endpoint E(Size ? &Buf[0] : 0);
+    transfer(E, Size, false);
+  }
+  catch (const std::exception &)
+  {
+    close();
+    throw;
+  }
+  close();
+}
+
+
+void pqxx::parallel_largeobject::to_file(const std::string &File)
+{
+  start(false);
+  try
+  {
+    const size_type Size = object_size();
+    file_endpoint E(File, std::ios::out | std::ios::trunc);
+    transfer(E, Size, false);
+  }
+  catch (const std::exception &)
+  {
+    close();
+    throw;
+  }
+  close();
+}
+
+
+void pqxx::parallel_largeobject::write(const char Buf[], size_type Len)
+{
+  start(true);
+  try
+  {
+    memory_endpoint E(Buf);
+    transfer(E, Len, true);
+  }
+  catch (const std::exception &)
+  {
+    close();
+    throw;
+  }
+  commit();
+}
+
+
+void pqxx::parallel_largeobject::from_file(const std::string &File)
+{
+  file_endpoint E(File, std::ios::in);
+  const size_type Size = E.size();
+  start(true);
+  try
+  {
+    transfer(E, Size, true);
+  }
+  catch (const std::exception &)
+  {
+    close();
+    throw;
+  }
+  commit();
+}
+
+
+void pqxx::parallel_largeobject::start(bool Writing)
+{
+  if (m_conns.empty())
+    throw usage_error("Starting parallel_largeobject without connections");
+
+  close();
+  m_next = 0;
+  try
+  {
+    m_shards.reserve(m_conns.size());
+    m_shards.push_back(new shard(*m_conns[0]));
+    transaction_base &Leader = m_shards[0]->m_trans;
+
+    if (Writing)
+    {
+      // Two connections writing the same page would block one another.
+      const size_type Page = Leader.exec(
+	"SELECT current_setting('block_size')::integer / 4")[0][0].
+	as<size_type>();
+      m_chunk = (m_chunk + Page - 1) / Page * Page;
+    }
+
+    // When reading, let all transactions share the first one's snapshot.
+    // This must happen before they execute any queries.
+    std::string Snapshot;
+    if (!Writing && m_conns.size() > 1)
+      Snapshot =
+	Leader.exec("SELECT pg_export_snapshot()")[0][0].as<std::string>();
+
+    for (std::vector<connection_base *>::size_type i = 1;
+	 i < m_conns.size();
+	 ++i)
+    {
+      m_shards.push_back(new shard(*m_conns[i]));
+      transaction_base &T = m_shards.back()->m_trans;
+      if (!Writing) T.exec("SET TRANSACTION SNAPSHOT " + T.quote(Snapshot));
+    }
+  }
+  catch (const std::exception &)
+  {
+    close();
+    throw;
+  }
+}
+
+
+pqxx::parallel_largeobject::size_type
+pqxx::parallel_largeobject::object_size()
+{
+  // Open the object for reading (INV_READ), and seek to its end.
+  return m_shards[0]->m_trans.exec(
+	"SELECT lo_lseek64(lo_open(" + to_string(m_object) + ", " +
+	to_string(0x40000) + "), 0, 2)")[0][0].as<size_type>();
+}
+
+
+void pqxx::parallel_largeobject::transfer(
+	endpoint &E,
+	size_type Size,
+	bool Writing)
+{
+  for (std::vector<shard *>::size_type i = 0; i < m_shards.size(); ++i)
+    issue(*m_shards[i], E, Size, Writing);
+
+  for (bool busy = true; busy; )
+  {
+    std::vector<std::pair<int, bool> > socks;
+    bool progress = false;
+    busy = false;
+    for (std::vector<shard *>::size_type i = 0; i < m_shards.size(); ++i)
+    {
+      shard &S = *m_shards[i];
+      if (!S.m_query) continue;
+      busy = true;
+
+      if (S.m_query->wants_write())
+      {
+        socks.push_back(std::make_pair(S.m_query->sock(), true));
+      }
+      else if (S.m_query->ready())
+      {
+        const result R = S.m_query->get();
+        if (!Writing)
+        {
+          const binarystring Data(R[0][0]);
+          E.put(S.m_offset, Data.data(), size_type(Data.size()));
+          m_bytes += size_type(Data.size());
+        }
+        issue(S, E, Size, Writing);
+        progress = true;
+      }
+      else
+      {
+        socks.push_back(std::make_pair(S.m_query->sock(), false));
+      }
+    }
+
+    // A shard that just finished may have a new chunk in flight, which is
+    // not in socks yet.  Only wait if nothing happened in this pass.
+    if (!progress && !socks.empty()) internal::wait_any(socks);
+  }
+}
+
+
+/// Send the next chunk, if any, through S.
+void pqxx::parallel_largeobject::issue(
+	shard &S,
+	endpoint &E,
+	size_type Size,
+	bool Writing)
+{
+  delete S.m_query;
+  S.m_query = 0;
+  if (m_next >= Size) return;
+
+  const size_type Len = std::min(m_chunk, Size - m_next);
+  S.m_offset = m_next;
+  m_next += Len;
+
+  std::string Query;
+  if (Writing)
+  {
+    const std::string Data = E.get(S.m_offset, Len);
+    S.m_written.push_back(std::make_pair(S.m_offset, S.m_offset + Len));
+    Query =
+	"SELECT lo_put(" + to_string(m_object) + ", " +
+	to_string(S.m_offset) + ", " +
+	S.m_trans.quote_raw(Data) + ")";
+    m_bytes += Len;
+  }
+  else
+  {
+    Query =
+	"SELECT lo_get(" + to_string(m_object) + ", " +
+	to_string(S.m_offset) + ", " + to_string(Len) + ")";
+  }
+  S.m_query = new async_query(S.m_trans, Query);
+}
+
+
+void pqxx::parallel_largeobject::commit()
+{
+  const std::vector<shard *>::size_type total = m_shards.size();
+  std::vector<partial_write_error::range> Committed;
+  for (std::vector<shard *>::size_type i = 0; i < total; ++i)
+  {
+    shard &S = *m_shards[i];
+    try
+    {
+      S.m_trans.commit();
+    }
+    catch (const std::exception &e)
+    {
+      // Nothing committed yet: the error tells the whole story.
+      if (!i)
+      {
+        close();
+        throw;
+      }
+
+      std::vector<partial_write_error::range> InDoubt;
+      if (dynamic_cast<const in_doubt_error *>(&e)) InDoubt = S.m_written;
+      const std::string Msg =
+	"parallel_largeobject committed " + to_string(i) + " out of " +
+	to_string(total) + " transactions, then failed: " + e.what();
+      close();
+      throw partial_write_error(Msg, Committed, InDoubt);
+    }
+    Committed.insert(Committed.end(), S.m_written.begin(), S.m_written.end());
+  }
+  close();
+}
+
+
+void pqxx::parallel_largeobject::close() PQXX_NOEXCEPT
+{
+  for (std::vector<shard *>::size_type i = 0; i < m_shards.size(); ++i)
+    delete m_shards[i];
+  m_shards.clear();
+}
@@ -0,0 +1,166 @@
+/*-------------------------------------------------------------------------
+ *
+ *   FILE
+ *	parallel_loader.cxx
+ *
+ *   DESCRIPTION
+ *      implementation of the pqxx::parallel_loader class.
+ *   Bulk-loads a table through several connections at once
+ *
+ * Copyright (c) 2016, Jeroen T. Vermeulen <jtv@xs4all.nl>
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this mistake,
+ * or contact the author.
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "pqxx/compiler-internal.hxx"
+
+#include "pqxx/parallel_loader"
+#include "pqxx/transaction"
+
+
+/// One connection's share of the work: a transaction and a COPY.
+class pqxx::parallel_loader::shard
+{
+public:
+  shard(connection_base &C,
+	const std::string &Table,
+	const std::vector<std::string> &Columns,
+	const std::string &Null) :
+    m_trans(C, "parallel_loader"),
+    m_writer(m_trans, Table, Columns.begin(), Columns.end(), Null)
+  {
+    m_writer.set_nonblocking(true);
+  }
+
+  work m_trans;
+  tablewriter m_writer;
+};
+
+
+pqxx::parallel_loader::parallel_loader(const std::string &Table,
+	const std::string &Null) :
+  m_table(Table),
+  m_columns(),
+  m_null(Null),
+  m_shards(),
+  m_next(0),
+  m_rows(0),
+  m_bytes(0),
+  m_finished(false)
+{
+}
+
+
+pqxx::parallel_loader::~parallel_loader() PQXX_NOEXCEPT
+{
+  abort();
+}
+
+
+void pqxx::parallel_loader::add_connection(connection_base &C)
+{
+  if (m_finished)
+    throw usage_error("Adding connection to finished parallel_loader");
+
+  m_shards.reserve(m_shards.size() + 1);
+  m_shards.push_back(new shard(C, m_table, m_columns, m_null));
+}
+
+
+void pqxx::parallel_loader::write_raw_line(const std::string &Line)
+{
+  if (m_finished)
+    throw usage_error("Writing to finished parallel_loader");
+  if (m_shards.empty())
+    throw usage_error("Writing to parallel_loader without connections");
+
+  try
+  {
+    for (;;)
+    {
+      // Hand the row to the next connection that can take it.
+      for (std::vector<shard *>::size_type n = 0; n < m_shards.size(); ++n)
+      {
+        tablewriter &W = m_shards[m_next]->m_writer;
+        if (++m_next == m_shards.size()) m_next = 0;
+        if (W.try_write_raw_line(Line))
+        {
+          ++m_rows;
+          m_bytes += Line.size();
+          return;
+        }
+      }
+      flush_shards();
+    }
+  }
+  catch (const std::exception &)
+  {
+    abort();
+    throw;
+  }
+}
+
+
+void pqxx::parallel_loader::commit()
+{
+  if (m_finished)
+    throw usage_error("Committing finished parallel_loader");
+
+  try
+  {
+    // Send all remaining data concurrently, not one connection at a time.
+    while (flush_shards()) ;
+    for (std::vector<shard *>::size_type i = 0; i < m_shards.size(); ++i)
+      m_shards[i]->m_writer.complete();
+  }
+  catch (const std::exception &)
+  {
+    abort();
+    throw;
+  }
+
+  m_finished = true;
+  const std::vector<shard *>::size_type total = m_shards.size();
+  for (std::vector<shard *>::size_type i = 0; i < total; ++i)
+  {
+    try
+    {
+      m_shards[i]->m_trans.commit();
+    }
+    catch (const std::exception &e)
+    {
+      abort();
+      if (!i) throw;
+      throw in_doubt_error(
+	"parallel_loader committed " + to_string(i) + " out of " +
+	to_string(total) + " transactions, then failed: " +
+	e.what());
+    }
+  }
+}
+
+
+void pqxx::parallel_loader::abort() PQXX_NOEXCEPT
+{
+  m_finished = true;
+  for (std::vector<shard *>::size_type i = 0; i < m_shards.size(); ++i)
+    delete m_shards[i];
+  m_shards.clear();
+}
+
+
+bool pqxx::parallel_loader::flush_shards()
+{
+  std::vector<std::pair<int, bool> > pending;
+  for (std::vector<shard *>::size_type i = 0; i < m_shards.size(); ++i)
+  {
+    tablewriter &W = m_shards[i]->m_writer;
+    if (W.wants_write()) pending.push_back(std::make_pair(W.sock(), true));
+  }
+  if (pending.empty()) return false;
+  internal::wait_any(pending);
+  return true;
+}
@@ -40,6 +40,18 @@ pqxx::prepare::invocation::invocation(
 
 
 pqxx::result pqxx::prepare::invocation::exec() const
+{
+  return execute(0);
+}
+
+
+pqxx::result pqxx::prepare::invocation::exec_binary() const
+{
+  return execute(1);
+}
+
+
+pqxx::result pqxx::prepare::invocation::execute(int result_format) const
 {
   scoped_array<const char *> ptrs;
   scoped_array<int> lens;
@@ -51,7 +63,8 @@ pqxx::result pqxx::prepare::invocation::exec() const
 	ptrs.get(),
 	lens.get(),
 	binaries.get(),
-	elts);
+	elts,
+	result_format);
 }
 
 
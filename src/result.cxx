@@ -19,6 +19,7 @@
 
 #include <cstdlib>
 #include <cstring>
+#include <new>
 #include <stdexcept>
 
 #include "libpq-fe.h"
@@ -36,7 +37,9 @@ pqxx::internal::result_data::result_data() :
   data(0),
   protocol(0),
   query(),
-  encoding_code(0)
+  encoding_code(0),
+  column_index(),
+  views(0)
 {}
 
 pqxx::internal::result_data::result_data(pqxx::internal::pq::PGresult *d,
@@ -46,17 +49,89 @@ pqxx::internal::result_data::result_data(pqxx::internal::pq::PGresult *d,
   data(d),
   protocol(p),
   query(q),
-  encoding_code(e)
+  encoding_code(e),
+  column_index(),
+  views(0)
 {}
 
 
-pqxx::internal::result_data::~result_data() { PQclear(data); }
+pqxx::internal::result_data::~result_data()
+{
+  view_registration::orphan_all(views);
+  PQclear(data);
+}
 
 
 void pqxx::internal::freemem_result_data(const result_data *d) PQXX_NOEXCEPT
 	{ delete d; }
 
 
+namespace
+{
+/// FNV-1a hash of a zero-terminated string
+inline unsigned long hash_name(const char name[]) PQXX_NOEXCEPT
+{
+  unsigned long h = 2166136261ul;
+  for (; *name; ++name)
+  {
+    h ^= static_cast<unsigned char>(*name);
+    h *= 16777619ul;
+  }
+  return h;
+}
+
+
+/// Does PQfnumber() take this name literally?
+/** It does unless the name contains quotes or uppercase letters.  Non-ASCII
+ * bytes may be uppercase in some locales, so leave those to PQfnumber() too.
+ */
+inline bool is_literal_name(const char name[]) PQXX_NOEXCEPT
+{
+  if (!*name) return false;
+  for (; *name; ++name)
+  {
+    const unsigned char c = static_cast<unsigned char>(*name);
+    if (c == '"' || c >= 0x80 || (c >= 'A' && c <= 'Z')) return false;
+  }
+  return true;
+}
+} // namespace
+
+
+void pqxx::internal::result_data::build_column_index() const
+{
+  const int cols = PQnfields(data);
+  std::vector<int>::size_type slots = 8;
+  while (slots < std::vector<int>::size_type(cols) * 2) slots *= 2;
+
+  std::vector<int> index(slots, -1);
+  for (int c = 0; c < cols; ++c)
+  {
+    const char *const name = PQfname(data, c);
+    std::vector<int>::size_type i = hash_name(name) & (slots - 1);
+    // If several columns have the same name, the first one wins.
+    while (index[i] != -1 && std::strcmp(PQfname(data, index[i]), name) != 0)
+      i = (i + 1) & (slots - 1);
+    if (index[i] == -1) index[i] = c;
+  }
+  column_index.swap(index);
+}
+
+
+int pqxx::internal::result_data::column_number(const char name[]) const
+{
+  if (!data || !is_literal_name(name)) return PQfnumber(data, name);
+
+  if (column_index.empty()) build_column_index();
+  const std::vector<int>::size_type mask = column_index.size() - 1;
+  for (std::vector<int>::size_type i = hash_name(name) & mask; ; i = (i+1) & mask)
+  {
+    const int c = column_index[i];
+    if (c == -1 || std::strcmp(PQfname(data, c), name) == 0) return c;
+  }
+}
+
+
 pqxx::result::result(pqxx::internal::pq::PGresult *rhs,
 	int protocol,
 	const std::string &Query,
@@ -166,6 +241,11 @@ void pqxx::result::ThrowSQLError(
   case '4':
     switch (code[1])
     {
+    case '0':
+      if (strcmp(code,"40001")==0) throw serialization_failure(Err, Query);
+      if (strcmp(code,"40P01")==0) throw deadlock_detected(Err, Query);
+      if (strcmp(code,"40003")==0) throw in_doubt_error(Err);
+      throw transaction_rollback(Err, Query);
     case '2':
       if (strcmp(code,"42501")==0) throw insufficient_privilege(Err, Query);
       if (strcmp(code,"42601")==0)
@@ -261,6 +341,218 @@ pqxx::result::size_type pqxx::result::affected_rows() const
 }
 
 
+pqxx::result pqxx::result::copy_rows(const std::vector<row> &Rows) const
+{
+  if (!m_data) throw usage_error("Copying rows into null result");
+
+  internal::pq::PGresult *const R = PQcopyResult(m_data, PG_COPYRES_ATTRS);
+  if (!R) throw std::bad_alloc();
+  const result Copy(R, get()->protocol, get()->query, get()->encoding_code);
+
+  const row::size_type Cols = columns();
+  for (std::vector<row>::size_type i = 0; i < Rows.size(); ++i)
+  {
+    if (Rows[i].size() != Cols)
+      throw usage_error("Copying row with wrong number of columns");
+    for (row::size_type c = 0; c < Cols; ++c)
+    {
+      const field F = Rows[i][c];
+      // A null value pointer makes a null field.
+      char *const Value = F.is_null() ? 0 : const_cast<char *>(F.c_str());
+      if (!PQsetvalue(R, int(i), int(c), Value, int(F.size())))
+        throw std::bad_alloc();
+    }
+  }
+  return Copy;
+}
+
+
+namespace
+{
+/* Serialized result layout, all numbers in native byte order:
+ *
+ * magic "PQXXRES1", then 32-bit byte order marker 0x01020304, libpq status,
+ * protocol version, encoding, column count; then 64-bit row count.
+ * Query: 32-bit length, text.
+ * Per column: 32-bit name length, name, then 32-bit type oid, table oid,
+ * column number in table, format, type size, and type modifier.
+ * Per field, row by row: 32-bit length (-1 for null), text.
+ */
+const char serial_magic[] = "PQXXRES1";
+const unsigned int serial_byte_order = 0x01020304u;
+
+
+template<typename T> void serialize_int(std::string &Out, T Value)
+{
+  Out.append(reinterpret_cast<const char *>(&Value), sizeof(Value));
+}
+
+
+void serialize_text(std::string &Out, const char Text[], size_t Len)
+{
+  serialize_int(Out, static_cast<unsigned int>(Len));
+  Out.append(Text, Len);
+}
+
+
+class serial_reader
+{
+public:
+  explicit serial_reader(const std::string &Blob) : m_blob(Blob), m_pos(0) {}
+
+  const char *take(size_t Len)
+  {
+    if (Len > m_blob.size() - m_pos)
+      throw pqxx::failure("Serialized result is truncated");
+    const char *const here = m_blob.data() + m_pos;
+    m_pos += Len;
+    return here;
+  }
+
+  template<typename T> T read_int()
+  {
+    T Value;
+    std::memcpy(&Value, take(sizeof(Value)), sizeof(Value));
+    return Value;
+  }
+
+  std::string read_text()
+  {
+    const unsigned int len = read_int<unsigned int>();
+    return std::string(take(len), len);
+  }
+
+  bool at_end() const PQXX_NOEXCEPT { return m_pos == m_blob.size(); }
+
+private:
+  const std::string &m_blob;
+  std::string::size_type m_pos;
+};
+} // namespace
+
+
+std::string pqxx::result::serialize() const
+{
+  std::string Out(serial_magic, 8);
+  serialize_int(Out, serial_byte_order);
+  if (!m_data)
+  {
+    // A null result: no columns, no rows, no query.
+    serialize_int(Out, static_cast<int>(PGRES_EMPTY_QUERY));
+    serialize_int(Out, 0);
+    serialize_int(Out, 0);
+    serialize_int(Out, 0u);
+    serialize_int(Out, 0ull);
+    serialize_text(Out, "", 0);
+    return Out;
+  }
+
+  const row::size_type Cols = columns();
+  const size_type Rows = size();
+  serialize_int(Out, static_cast<int>(PQresultStatus(m_data)));
+  serialize_int(Out, get()->protocol);
+  serialize_int(Out, get()->encoding_code);
+  serialize_int(Out, static_cast<unsigned int>(Cols));
+  serialize_int(Out, static_cast<unsigned long long>(Rows));
+  serialize_text(Out, get()->query.data(), get()->query.size());
+
+  for (row::size_type c = 0; c < Cols; ++c)
+  {
+    const int C = int(c);
+    const char *const Name = PQfname(m_data, C);
+    serialize_text(Out, Name, std::strlen(Name));
+    serialize_int(Out, static_cast<unsigned int>(PQftype(m_data, C)));
+    serialize_int(Out, static_cast<unsigned int>(PQftable(m_data, C)));
+    serialize_int(Out, PQftablecol(m_data, C));
+    serialize_int(Out, PQfformat(m_data, C));
+    serialize_int(Out, PQfsize(m_data, C));
+    serialize_int(Out, PQfmod(m_data, C));
+  }
+
+  for (size_type r = 0; r < Rows; ++r)
+    for (row::size_type c = 0; c < Cols; ++c)
+    {
+      if (GetIsNull(r, c))
+      {
+        serialize_int(Out, -1);
+      }
+      else
+      {
+        const field::size_type Len = GetLength(r, c);
+        serialize_int(Out, static_cast<int>(Len));
+        Out.append(GetValue(r, c), Len);
+      }
+    }
+
+  return Out;
+}
+
+
+pqxx::result pqxx::result::deserialize(const std::string &Blob)
+{
+  serial_reader In(Blob);
+  if (std::memcmp(In.take(8), serial_magic, 8) != 0 ||
+      In.read_int<unsigned int>() != serial_byte_order)
+    throw failure("Not a serialized result");
+
+  const ExecStatusType Status = ExecStatusType(In.read_int<int>());
+  const int Protocol = In.read_int<int>();
+  const int Encoding = In.read_int<int>();
+  const unsigned int Cols = In.read_int<unsigned int>();
+  const unsigned long long Rows = In.read_int<unsigned long long>();
+  const std::string Query = In.read_text();
+  if (Status == PGRES_EMPTY_QUERY)
+  {
+    if (Cols || Rows || !In.at_end())
+      throw failure("Corrupt serialized result");
+    return result();
+  }
+  if (Status != PGRES_TUPLES_OK && Status != PGRES_COMMAND_OK)
+    throw failure("Serialized result has unexpected status");
+
+  internal::pq::PGresult *const R = PQmakeEmptyPGresult(0, Status);
+  if (!R) throw std::bad_alloc();
+  // From here on, Result owns R.
+  const result Result(R, Protocol, Query, Encoding);
+
+  if (Cols)
+  {
+    std::vector<std::string> Names(Cols);
+    std::vector<PGresAttDesc> Attrs(Cols);
+    for (unsigned int c = 0; c < Cols; ++c)
+    {
+      Names[c] = In.read_text();
+      PGresAttDesc &A = Attrs[c];
+      A.name = const_cast<char *>(Names[c].c_str());
+      A.typid = In.read_int<unsigned int>();
+      A.tableid = In.read_int<unsigned int>();
+      A.columnid = In.read_int<int>();
+      A.format = In.read_int<int>();
+      A.typlen = In.read_int<int>();
+      A.atttypmod = In.read_int<int>();
+    }
+    if (!PQsetResultAttrs(R, int(Cols), &Attrs[0])) throw std::bad_alloc();
+  }
+
+  // Every field takes at least 4 bytes, so this bounds Rows for a bad blob.
+  // Rows without columns can't be represented in a PGresult.
+  if (Cols && Rows > Blob.size()) throw failure("Corrupt serialized result");
+  for (unsigned long long r = 0; Cols && r < Rows; ++r)
+    for (unsigned int c = 0; c < Cols; ++c)
+    {
+      const int Len = In.read_int<int>();
+      if (Len < -1) throw failure("Corrupt serialized result");
+      // A null value pointer makes a null field.
+      char *const Value =
+	(Len < 0) ? 0 : const_cast<char *>(In.take(size_t(Len)));
+      if (!PQsetvalue(R, int(r), int(c), Value, Len)) throw std::bad_alloc();
+    }
+
+  if (!In.at_end()) throw failure("Corrupt serialized result");
+  return Result;
+}
+
+
 const char *pqxx::result::GetValue(
 	pqxx::result::size_type Row,
 	pqxx::row::size_type Col) const
@@ -295,6 +587,16 @@ pqxx::oid pqxx::result::column_type(row::size_type ColNum) const
 }
 
 
+int pqxx::result::column_format(row::size_type ColNum) const
+{
+  if (ColNum >= columns())
+    throw argument_error(
+	"Attempt to retrieve format of nonexistant column " +
+	to_string(ColNum) + " of query result");
+  return PQfformat(m_data, int(ColNum));
+}
+
+
 pqxx::oid pqxx::result::column_table(row::size_type ColNum) const
 {
   const oid T = PQftable(m_data, int(ColNum));
@@ -0,0 +1,209 @@
+/*-------------------------------------------------------------------------
+ *
+ *   FILE
+ *	result_cache.cxx
+ *
+ *   DESCRIPTION
+ *      implementation of the pqxx::result_cache class and its storage.
+ *   Client-side caching of query results, through a pluggable store.
+ *
+ * Copyright (c) 2016, Jeroen T. Vermeulen <jtv@xs4all.nl>
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this mistake,
+ * or contact the author.
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "pqxx/compiler-internal.hxx"
+
+#include "pqxx/result_cache"
+#include "pqxx/transaction_base"
+
+
+pqxx::result_store::~result_store()
+{
+}
+
+
+pqxx::memory_result_store::memory_result_store(size_t MaxBytes) :
+  result_store(),
+  m_entries(),
+  m_expiry(),
+  m_bytes(0),
+  m_max_bytes(MaxBytes)
+{
+}
+
+
+bool pqxx::memory_result_store::get(const std::string &Key, std::string &Blob)
+{
+  const map_type::iterator i = m_entries.find(Key);
+  if (i == m_entries.end()) return false;
+  if (i->second.expires <= std::time(0))
+  {
+    erase(i);
+    return false;
+  }
+  Blob = i->second.blob;
+  return true;
+}
+
+
+void pqxx::memory_result_store::put(
+	const std::string &Key,
+	const std::string &Blob,
+	unsigned long TTL)
+{
+  remove(Key);
+  const size_t Size = Key.size() + Blob.size();
+  if (Size > m_max_bytes) return;
+  make_room(Size);
+
+  entry &E = m_entries[Key];
+  E.blob = Blob;
+  E.expires = std::time(0) + std::time_t(TTL);
+  E.by_expiry = m_expiry.insert(std::make_pair(E.expires, Key));
+  m_bytes += Size;
+}
+
+
+void pqxx::memory_result_store::remove(const std::string &Key)
+{
+  const map_type::iterator i = m_entries.find(Key);
+  if (i != m_entries.end()) erase(i);
+}
+
+
+void pqxx::memory_result_store::clear() PQXX_NOEXCEPT
+{
+  m_entries.clear();
+  m_expiry.clear();
+  m_bytes = 0;
+}
+
+
+void pqxx::memory_result_store::erase(map_type::iterator i) PQXX_NOEXCEPT
+{
+  m_bytes -= i->first.size() + i->second.blob.size();
+  m_expiry.erase(i->second.by_expiry);
+  m_entries.erase(i);
+}
+
+
+void pqxx::memory_result_store::make_room(size_t Bytes) PQXX_NOEXCEPT
+{
+  if (m_bytes + Bytes <= m_max_bytes) return;
+
+  // Expired entries come first in m_expiry; drop all of those, then more
+  // entries in order of expiry until the new one fits.
+  const std::time_t now = std::time(0);
+  while (!m_expiry.empty() &&
+	 (m_expiry.begin()->first <= now || m_bytes + Bytes > m_max_bytes))
+    erase(m_entries.find(m_expiry.begin()->second));
+}
+
+
+pqxx::result_cache::result_cache(
+	result_store &Store,
+	unsigned long TTL,
+	const std::string &Namespace) :
+  m_store(Store),
+  m_namespace(Namespace),
+  m_ttl(TTL),
+  m_hits(0),
+  m_misses(0)
+{
+}
+
+
+pqxx::result pqxx::result_cache::exec(
+	transaction_base &T,
+	const std::string &Query)
+{
+  const std::string Key = make_key(Query);
+  result R;
+  if (!lookup(Key, R))
+  {
+    R = T.exec(Query);
+    store(Key, R);
+  }
+  return R;
+}
+
+
+pqxx::result pqxx::result_cache::exec(
+	transaction_base &T,
+	const std::string &Query,
+	const std::vector<std::string> &Params)
+{
+  const std::string Key = make_key(Query, Params);
+  result R;
+  if (!lookup(Key, R))
+  {
+    internal::parameterized_invocation Invocation = T.parameterized(Query);
+    for (std::vector<std::string>::size_type i = 0; i < Params.size(); ++i)
+      Invocation(Params[i]);
+    R = Invocation.exec();
+    store(Key, R);
+  }
+  return R;
+}
+
+
+bool pqxx::result_cache::lookup(const std::string &Key, result &Out)
+{
+  const std::string Stored = stored_key(Key);
+  std::string Blob;
+  if (m_store.get(Stored, Blob))
+  {
+    try
+    {
+      Out = result::deserialize(Blob);
+      ++m_hits;
+      return true;
+    }
+    catch (const failure &)
+    {
+      // Unusable entry; treat it as a miss.
+      m_store.remove(Stored);
+    }
+  }
+  ++m_misses;
+  return false;
+}
+
+
+void pqxx::result_cache::store(const std::string &Key, const result &R)
+{
+  m_store.put(stored_key(Key), R.serialize(), m_ttl);
+}
+
+
+void pqxx::result_cache::invalidate(
+	const std::string &Query,
+	const std::vector<std::string> &Params)
+{
+  m_store.remove(stored_key(make_key(Query, Params)));
+}
+
+
+std::string pqxx::result_cache::stored_key(const std::string &Key) const
+{
+  // Length-prefixed like the rest of the key, so a namespaced key can never
+  // equal one without a namespace.
+  if (m_namespace.empty()) return Key;
+  return to_string(m_namespace.size()) + ":" + m_namespace + Key;
+}
+
+
+std::string pqxx::result_cache::make_key(
+	const std::string &Query,
+	const std::vector<std::string> &Params)
+{
+  // Prefix each part with its length, so no two combinations look the same.
+  std::string Key = to_string(Query.size()) + ":" + Query;
+  for (std::vector<std::string>::size_type i = 0; i < Params.size(); ++i)
+    Key += to_string(Params[i].size()) + ":" + Params[i];
+  return Key;
+}
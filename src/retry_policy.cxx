@@ -0,0 +1,113 @@
+/*-------------------------------------------------------------------------
+ *
+ *   FILE
+ *	retry_policy.cxx
+ *
+ *   DESCRIPTION
+ *      implementation of the pqxx::retry_policy class.
+ *   Decides whether and when connection_base::perform() retries a transactor
+ *
+ * Copyright (c) 2016, Jeroen T. Vermeulen <jtv@xs4all.nl>
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this mistake,
+ * or contact the author.
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "pqxx/compiler-internal.hxx"
+
+#include <cstddef>
+
+#include "pqxx/except"
+#include "pqxx/retry_policy"
+
+
+pqxx::retry_policy::retry_policy(
+	int MaxAttempts,
+	unsigned long InitialDelay,
+	unsigned long MaxDelay,
+	unsigned long Deadline) :
+  m_max_attempts(MaxAttempts),
+  m_initial_delay(InitialDelay),
+  m_max_delay(MaxDelay),
+  m_deadline(Deadline),
+  m_start(internal::clock_msec()),
+  m_seed(m_start ^ static_cast<unsigned long>(
+	reinterpret_cast<std::size_t>(this))),
+  m_retries()
+{
+  if (MaxAttempts <= 0)
+    throw argument_error("retry_policy needs at least one attempt");
+  if (!m_seed) m_seed = 1;
+}
+
+
+pqxx::retry_policy::~retry_policy()
+{
+}
+
+
+bool pqxx::retry_policy::retryable(const std::exception &e) const
+{
+  // An error that leaves us in doubt must never be retried.
+  if (dynamic_cast<const in_doubt_error *>(&e)) return false;
+  return
+	dynamic_cast<const transaction_rollback *>(&e) ||
+	dynamic_cast<const broken_connection *>(&e);
+}
+
+
+unsigned long pqxx::retry_policy::backoff(int Retry)
+{
+  // Double the ceiling with each retry, without overflowing.
+  unsigned long ceiling = m_initial_delay;
+  for (int i = 0; i < Retry && ceiling < m_max_delay; ++i) ceiling *= 2;
+  if (ceiling > m_max_delay) ceiling = m_max_delay;
+  if (!ceiling) return 0;
+
+  // Xorshift is plenty random for spreading out retries.
+  m_seed ^= m_seed << 13;
+  m_seed ^= m_seed >> 7;
+  m_seed ^= m_seed << 17;
+  return m_seed % (ceiling + 1);
+}
+
+
+unsigned long pqxx::retry_policy::retries(const std::string &Name) const
+{
+  const stats_type::const_iterator i = m_retries.find(Name);
+  return (i == m_retries.end()) ? 0 : i->second;
+}
+
+
+void pqxx::retry_policy::start() PQXX_NOEXCEPT
+{
+  m_start = internal::clock_msec();
+}
+
+
+bool pqxx::retry_policy::retry(
+	const std::exception &Error,
+	int Attempt,
+	const std::string &Name)
+{
+  if (Attempt >= m_max_attempts || !retryable(Error)) return false;
+
+  const unsigned long wait = backoff(Attempt - 1);
+  if (m_deadline)
+  {
+    const unsigned long elapsed = internal::clock_msec() - m_start;
+    if (elapsed >= m_deadline || wait > m_deadline - elapsed) return false;
+  }
+
+  ++m_retries[Name];
+  sleep(wait);
+  return true;
+}
+
+
+void pqxx::retry_policy::sleep(unsigned long Msec)
+{
+  internal::sleep_msec(Msec);
+}
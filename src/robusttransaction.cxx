@@ -53,6 +53,17 @@ pqxx::basic_robusttransaction::~basic_robusttransaction()
 
 void pqxx::basic_robusttransaction::do_begin()
 {
+  m_record_id = 0;
+  m_xid.clear();
+
+  // Where the server can tell us what became of a transaction, we need no log
+  // record.  Starting the transaction and learning its id takes one round trip.
+  if (conn().supports(connection_base::cap_txid_status))
+  {
+    begin_with("SELECT txid_current()")[0][0].to(m_xid);
+    return;
+  }
+
   try
   {
     CreateTransactionRecord();
@@ -68,25 +79,23 @@ void pqxx::basic_robusttransaction::do_begin()
     CreateTransactionRecord();
   }
 
-  dbtransaction::do_begin();
-
   // If this transaction commits, the transaction record should also be gone.
-  DirectExec(sql_delete().c_str());
-
-  if (conn().server_version() >= 80300)
-    DirectExec("SELECT txid_current()")[0][0].to(m_xid);
+  begin_with(sql_delete() + "; SELECT txid_current()")[0][0].to(m_xid);
 }
 
 
 
 void pqxx::basic_robusttransaction::do_commit()
 {
-  if (!m_record_id)
+  // With a log record, the record identifies the transaction.  Without one,
+  // the server's transaction id does.
+  if (!m_record_id && m_xid.empty())
     throw internal_error("transaction '" + name() + "' has no ID");
 
   // Check constraints before sending the COMMIT to the database to reduce the
-  // work being done inside our in-doubt window.
-  try
+  // work being done inside our in-doubt window.  Without a log record there is
+  // no need: the server can tell us exactly what happened to the transaction.
+  if (m_record_id) try
   {
     DirectExec("SET CONSTRAINTS ALL IMMEDIATE");
   }
@@ -128,9 +137,37 @@ void pqxx::basic_robusttransaction::do_commit()
   }
 
   // If we get here, we're in doubt.  Talk to the backend, figure out what
-  // happened.  If the transaction record still exists, the transaction failed.
-  // If not, it succeeded.
+  // happened.
+  if (!m_record_id)
+  {
+    bool committed;
+    try
+    {
+      committed = CheckTransactionStatus();
+    }
+    catch (const std::exception &f)
+    {
+      const std::string Msg = "WARNING: "
+	"Connection lost while committing transaction "
+	"'" + name() + "' (transaction_id " + m_xid + "). "
+	"Please check txid_status(" + m_xid + ") to see whether it was "
+	"executed.\n";
+
+      process_notice(Msg);
+      process_notice("Could not verify transaction status "
+	"because of the following error:\n");
+      process_notice(std::string(f.what()) + "\n");
 
+      throw in_doubt_error(Msg);
+    }
+
+    if (!committed)
+      throw broken_connection("Connection lost while committing.");
+    return;
+  }
+
+  // If the transaction record still exists, the transaction failed.  If not,
+  // it succeeded.
   bool exists;
   try
   {
@@ -213,27 +250,19 @@ void pqxx::basic_robusttransaction::CreateLogTable()
 
 void pqxx::basic_robusttransaction::CreateTransactionRecord()
 {
-  static const std::string Fail = "Could not create transaction log record: ";
-
-  // Clean up old transaction records.
-  DirectExec((
-	"DELETE FROM " + m_LogTable + " "
-	"WHERE date < CURRENT_TIMESTAMP - '30 days'::interval").c_str());
-
-  // Allocate id.
-  const std::string sql_get_id("SELECT nextval(" + quote(m_sequence) + ")");
-  DirectExec(sql_get_id.c_str())[0][0].to(m_record_id);
-
+  // Clean up old transaction records, and create ours, in one round trip.
   DirectExec((
+	"DELETE FROM \"" + m_LogTable + "\" "
+	"WHERE date < CURRENT_TIMESTAMP - '30 days'::interval; "
 	"INSERT INTO \"" + m_LogTable + "\" "
 	"(id, username, name, date) "
 	"VALUES "
-	"(" +
-	to_string(m_record_id) + ", " +
+	"(nextval(" + quote(m_sequence) + "), " +
         quote(conn().username()) + ", " +
 	(name().empty() ? "NULL" : quote(name())) + ", "
 	"CURRENT_TIMESTAMP"
-	")").c_str());
+	") "
+	"RETURNING id").c_str())[0][0].to(m_record_id);
 }
 
 
@@ -324,3 +353,26 @@ bool pqxx::basic_robusttransaction::CheckTransactionRecord()
   return !DirectExec(Find.c_str(), 20).empty();
 }
 
+
+// Ask the server whether our transaction committed
+bool pqxx::basic_robusttransaction::CheckTransactionStatus()
+{
+  const std::string query = "SELECT txid_status(" + m_xid + ")";
+  for (int c=20; c; internal::sleep_seconds(5), --c)
+  {
+    const result R = DirectExec(query.c_str(), 20);
+    if (R[0][0].is_null())
+      throw in_doubt_error(
+	"Transaction " + m_xid + " is too old for its status to be known.");
+
+    const std::string status = R[0][0].c_str();
+    if (status == "committed") return true;
+    if (status == "aborted") return false;
+
+    // Still "in progress": the old backend has yet to notice that it lost its
+    // connection.  Wait for it to commit or roll back.
+  }
+
+  throw in_doubt_error(
+	"Old backend process stays alive too long to wait for.");
+}
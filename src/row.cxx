@@ -187,7 +187,7 @@ pqxx::row::size_type pqxx::row::column_number(const char ColName[]) const
 
 pqxx::row::size_type pqxx::result::column_number(const char ColName[]) const
 {
-  const int N = PQfnumber(m_data, ColName);
+  const int N = m_data ? get()->column_number(ColName) : -1;
   // TODO: Should this be an out_of_range?
   if (N == -1)
     throw argument_error("Unknown column name: '" + std::string(ColName) + "'");
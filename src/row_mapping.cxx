@@ -0,0 +1,92 @@
+/*-------------------------------------------------------------------------
+ *
+ *   FILE
+ *	row_mapping.cxx
+ *
+ *   DESCRIPTION
+ *      implementation of the non-template parts of pqxx::row_mapping.
+ *   Converts whole results to tuples or structs, checking column types once.
+ *
+ * Copyright (c) 2016, Jeroen T. Vermeulen <jtv@xs4all.nl>
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this mistake,
+ * or contact the author.
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "pqxx/compiler-internal.hxx"
+
+#include "pqxx/row_mapping"
+
+#include "pqxx/internal/type_oids.hxx"
+
+using namespace pqxx::internal;
+
+
+namespace
+{
+/// Can a value of this type look like a number?
+/** This includes floating-point and numeric types even when reading integers:
+ * a sum() or a cast to numeric of integers holds integral values.
+ */
+bool is_numeric_type(pqxx::oid Type) PQXX_NOEXCEPT
+{
+  return
+	Type == oid_int2 ||
+	Type == oid_int4 ||
+	Type == oid_int8 ||
+	Type == oid_oid ||
+	Type == oid_float4 ||
+	Type == oid_float8 ||
+	Type == oid_numeric;
+}
+
+
+/// Can a value of this type hold any text at all, e.g. a literal?
+bool is_text_type(pqxx::oid Type) PQXX_NOEXCEPT
+{
+  return
+	Type == oid_text ||
+	Type == oid_varchar ||
+	Type == oid_bpchar ||
+	Type == oid_name ||
+	Type == oid_char ||
+	Type == oid_unknown;
+}
+
+
+/// Can a column of this type ever convert to the given kind?
+/** Only rejects types that never can.  Whether a given value converts is up
+ * to the conversion itself.
+ */
+bool holds(pqxx::oid Type, pqxx::internal::column_kind Kind) PQXX_NOEXCEPT
+{
+  if (Type >= first_normal_oid || is_text_type(Type)) return true;
+  switch (Kind)
+  {
+  case pqxx::internal::column_any:
+    return true;
+  case pqxx::internal::column_bool:
+    return Type == oid_bool;
+  case pqxx::internal::column_integer:
+  case pqxx::internal::column_floating:
+    return is_numeric_type(Type);
+  }
+  return true;
+}
+} // namespace
+
+
+void pqxx::internal::check_column_kind(
+	const result &R,
+	row::size_type Col,
+	column_kind Kind,
+	const char TypeName[])
+{
+  const oid Type = R.column_type(Col);
+  if (!holds(Type, Kind))
+    throw usage_error(
+	"Can't read column '" + std::string(R.column_name(Col)) + "' "
+	"(type oid " + to_string(Type) + ") as " + TypeName);
+}
@@ -0,0 +1,75 @@
+/*-------------------------------------------------------------------------
+ *
+ *   FILE
+ *	row_scanner.cxx
+ *
+ *   DESCRIPTION
+ *      implementation of the pqxx::row_scanner class.
+ *   Fast sequential access to the fields of a result, row by row.
+ *
+ * Copyright (c) 2016, Jeroen T. Vermeulen <jtv@xs4all.nl>
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this mistake,
+ * or contact the author.
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "pqxx/compiler-internal.hxx"
+
+#include "libpq-fe.h"
+
+#include "pqxx/row_scanner"
+
+#include "pqxx/internal/gates/result-row_scanner.hxx"
+
+
+pqxx::row_scanner::row_scanner(const result &R) :
+  m_home(R),
+  m_data(internal::gate::result_row_scanner(R).data()),
+  m_columns(R.columns()),
+  m_rows(R.size()),
+  m_next(0),
+  m_values(m_columns, ""),
+  m_lengths(m_columns, -1)
+{
+}
+
+
+bool pqxx::row_scanner::next()
+{
+  if (m_next >= m_rows) return false;
+  load_row(m_next);
+  ++m_next;
+  return true;
+}
+
+
+void pqxx::row_scanner::seek(result::difference_type Row)
+{
+  if (Row < -1 || Row >= result::difference_type(m_rows))
+    throw range_error(
+	"Row " + to_string(Row) + " out of range "
+	"(result has " + to_string(m_rows) + " rows)");
+  m_next = size_type(Row + 1);
+  if (Row >= 0) load_row(size_type(Row));
+}
+
+
+void pqxx::row_scanner::load_row(size_type Row)
+{
+  // libpq's accessors are const-incorrect.
+  internal::pq::PGresult *const data =
+	const_cast<internal::pq::PGresult *>(m_data);
+  const int r = int(Row);
+  for (row::size_type c = 0; c < m_columns; ++c)
+  {
+    const int col = int(c);
+    const char *const value = PQgetvalue(data, r, col);
+    m_values[c] = value;
+    // Only an empty value can be null.
+    m_lengths[c] = (!value[0] && PQgetisnull(data, r, col)) ?
+	-1 :
+	PQgetlength(data, r, col);
+  }
+}
@@ -33,8 +33,16 @@ pqxx::subtransaction::subtransaction(
   namedclass("subtransaction", T.conn().adorn_name(Name)),
   transactionfocus(T),
   dbtransaction(T.conn(), false),
-  m_parent(T)
+  m_parent(T),
+  m_depth(1),
+  m_deferred(T.conn().deferred_begin()),
+  m_savepoint(),
+  m_release(),
+  m_rollback()
 {
+  const subtransaction *const Parent = dynamic_cast<subtransaction *>(&T);
+  if (Parent) m_depth = Parent->m_depth + 1;
+  set_up_savepoint();
 }
 
 
@@ -50,21 +58,41 @@ pqxx::subtransaction::subtransaction(
   namedclass("subtransaction", T.conn().adorn_name(Name)),
   transactionfocus(dbtransaction_ref(T)),
   dbtransaction(T.conn(), false),
-  m_parent(T)
+  m_parent(T),
+  m_depth(T.m_depth + 1),
+  m_deferred(T.conn().deferred_begin()),
+  m_savepoint(),
+  m_release(),
+  m_rollback()
 {
+  set_up_savepoint();
+}
+
+
+void pqxx::subtransaction::set_up_savepoint()
+{
+  // A deferred savepoint lives until the next statement after it at the
+  // earliest, so one name per nesting depth will do.  Any older savepoint of
+  // the same name is gone by then, or belongs to an enclosing subtransaction
+  // and so has a lower depth.
+  const std::string quoted = m_deferred ?
+	"pqxx_savepoint_" + to_string(m_depth) :
+	"\"" + name() + "\"";
+
+  m_savepoint = "SAVEPOINT " + quoted;
+  m_release = "RELEASE SAVEPOINT " + quoted;
+  m_rollback = "ROLLBACK TO SAVEPOINT " + quoted;
+
+  // Rolling back to a savepoint keeps it in place.  Don't let reused ones
+  // pile up.
+  if (m_deferred) m_rollback += "; " + m_release;
 }
 
 
 void pqxx::subtransaction::do_begin()
 {
-  try
-  {
-    DirectExec(("SAVEPOINT \"" + name() + "\"").c_str());
-  }
-  catch (const sql_error &)
-  {
-    throw;
-  }
+  if (m_deferred) defer(m_savepoint);
+  else DirectExec(m_savepoint.c_str());
 }
 
 
@@ -72,7 +100,8 @@ void pqxx::subtransaction::do_commit()
 {
   const int ra = m_reactivation_avoidance.get();
   m_reactivation_avoidance.clear();
-  DirectExec(("RELEASE SAVEPOINT \"" + name() + "\"").c_str());
+  if (!m_deferred) DirectExec(m_release.c_str());
+  else if (!cancel_deferred(m_savepoint)) defer(m_release);
   gate::transaction_subtransaction(m_parent).add_reactivation_avoidance_count(
 	ra);
 }
@@ -80,5 +109,16 @@ void pqxx::subtransaction::do_commit()
 
 void pqxx::subtransaction::do_abort()
 {
-  DirectExec(("ROLLBACK TO SAVEPOINT \"" + name() + "\"").c_str());
+  if (!m_deferred)
+  {
+    DirectExec(m_rollback.c_str());
+    return;
+  }
+
+  if (cancel_deferred(m_savepoint)) return;
+
+  // Our savepoint went out, so anything still waiting to be sent came from
+  // inside this subtransaction, and is moot now.
+  drop_deferred();
+  defer(m_rollback);
 }
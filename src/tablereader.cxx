@@ -72,6 +72,24 @@ bool pqxx::tablereader::get_raw_line(std::string &Line)
 }
 
 
+bool pqxx::tablereader::try_get_raw_line(std::string &Line)
+{
+  if (m_Done) return false;
+  int Res;
+  try
+  {
+    Res = gate::transaction_tablereader(m_Trans).TryReadCopyLine(Line);
+  }
+  catch (const std::exception &)
+  {
+    m_Done = true;
+    throw;
+  }
+  if (Res < 0) m_Done = true;
+  return Res > 0;
+}
+
+
 void pqxx::tablereader::complete()
 {
   reader_close();
@@ -126,11 +144,13 @@ std::string::size_type findtab(const std::string &Line,
 } // namespace
 
 
-std::string pqxx::tablereader::extract_field(const std::string &Line,
-    std::string::size_type &i) const
+bool pqxx::internal::extract_copy_field(
+	const std::string &Line,
+	std::string::size_type &i,
+	std::string &Field)
 {
   // TODO: Pick better exception types
-    std::string R;
+  Field.clear();
   bool isnull=false;
   std::string::size_type stop = findtab(Line, i);
   for (; i < stop; ++i)
@@ -152,9 +172,8 @@ std::string pqxx::tablereader::extract_field(const std::string &Line,
 	switch (n)
 	{
 	case 'N':	// Null value
-	  if (!R.empty())
+	  if (!Field.empty())
 	    throw failure("Null sequence found in nonempty field");
-	  R = NullStr();
 	  isnull = true;
 	  break;
 
@@ -173,7 +192,7 @@ std::string pqxx::tablereader::extract_field(const std::string &Line,
 	    const char n2 = Line[++i];
 	    if (!is_octalchar(n1) || !is_octalchar(n2))
 	      throw failure("Invalid octal in encoded table stream");
-	    R += char((digit_to_number(n)<<6) |
+	    Field += char((digit_to_number(n)<<6) |
 		(digit_to_number(n1)<<3) |
 		digit_to_number(n2));
           }
@@ -181,28 +200,28 @@ std::string pqxx::tablereader::extract_field(const std::string &Line,
 
 	case 'b':
 	  // TODO: Escape code?
-	  R += char(8);
+	  Field += char(8);
 	  break;	// Backspace
 	case 'v':
 	  // TODO: Escape code?
-	  R += char(11);
+	  Field += char(11);
 	  break;	// Vertical tab
 	case 'f':
 	  // TODO: Escape code?
-	  R += char(12);
+	  Field += char(12);
 	  break;	// Form feed
 	case 'n':
-	  R += '\n';
+	  Field += '\n';
 	  break;	// Newline
 	case 't':
-	  R += '\t';
+	  Field += '\t';
 	  break;	// Tab
 	case 'r':
-	  R += '\r';
+	  Field += '\r';
 	  break;	// Carriage return;
 
 	default:	// Self-escaped character
-	  R += n;
+	  Field += n;
 	  // This may be a self-escaped tab that we thought was a terminator...
 	  if (i == stop)
 	  {
@@ -216,15 +235,24 @@ std::string pqxx::tablereader::extract_field(const std::string &Line,
       break;
 
     default:
-      R += c;
+      Field += c;
       break;
     }
   }
   ++i;
 
-  if (isnull && (R.size() != NullStr().size()))
+  if (isnull && !Field.empty())
     throw failure("Field contains data behind null sequence");
 
+  return !isnull;
+}
+
+
+std::string pqxx::tablereader::extract_field(const std::string &Line,
+    std::string::size_type &i) const
+{
+  std::string R;
+  if (!extract_copy_field(Line, i, R)) R = NullStr();
   return R;
 }
 
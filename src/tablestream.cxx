@@ -20,13 +20,18 @@
 #include "pqxx/tablestream"
 #include "pqxx/transaction"
 
+#include "pqxx/internal/gates/connection-tablestream.hxx"
+
+using namespace pqxx::internal;
+
 
 pqxx::tablestream::tablestream(transaction_base &STrans,
 	const std::string &Null) :
   internal::namedclass("tablestream"),
   internal::transactionfocus(STrans),
   m_Null(Null),
-  m_Finished(false)
+  m_Finished(false),
+  m_Nonblocking(false)
 {
 }
 
@@ -42,8 +47,50 @@ void pqxx::tablestream::base_close()
   {
     m_Finished = true;
     unregister_me();
+    if (m_Nonblocking)
+    {
+      // libpq won't leave nonblocking mode while output is still queued.
+      m_Nonblocking = false;
+      gate::connection_tablestream gate(m_Trans.conn());
+      while (gate.flush_output()) gate.wait_write();
+      gate.set_nonblocking(false);
+    }
   }
 }
 
 
+void pqxx::tablestream::set_nonblocking(bool nonblocking)
+{
+  if (nonblocking == m_Nonblocking) return;
+  if (is_finished())
+    throw usage_error("Setting nonblocking mode on closed " + description());
+  gate::connection_tablestream(m_Trans.conn()).set_nonblocking(nonblocking);
+  m_Nonblocking = nonblocking;
+}
+
+
+int pqxx::tablestream::sock() const PQXX_NOEXCEPT
+{
+  return m_Trans.conn().sock();
+}
+
+
+bool pqxx::tablestream::wants_write()
+{
+  return gate::connection_tablestream(m_Trans.conn()).flush_output();
+}
+
+
+void pqxx::tablestream::wait_read() const
+{
+  gate::connection_tablestream(m_Trans.conn()).wait_read();
+}
+
+
+void pqxx::tablestream::wait_write() const
+{
+  gate::connection_tablestream(m_Trans.conn()).wait_write();
+}
+
+
 
@@ -30,7 +30,8 @@ pqxx::tablewriter::tablewriter(transaction_base &T,
     const std::string &WName,
     const std::string &Null) :
   namedclass("tablewriter", WName),
-  tablestream(T, Null)
+  tablestream(T, Null),
+  m_Unflushed(0)
 {
   setup(T, WName);
 }
@@ -69,11 +70,35 @@ pqxx::tablewriter &pqxx::tablewriter::operator<<(pqxx::tablereader &R)
 
 void pqxx::tablewriter::write_raw_line(const std::string &Line)
 {
+  while (!try_write_raw_line(Line)) wait_write();
+}
+
+
+namespace
+{
+/// How much output we let pile up before waiting for it to be sent.
+/** libpq will keep growing its output buffer when the socket can't keep up,
+ * so in nonblocking mode we need to apply backpressure ourselves.
+ */
+const std::string::size_type max_unflushed = 65536;
+} // namespace
+
+
+bool pqxx::tablewriter::try_write_raw_line(const std::string &Line)
+{
+  if (m_Unflushed >= max_unflushed)
+  {
+    if (wants_write()) return false;
+    m_Unflushed = 0;
+  }
+
   const std::string::size_type len = Line.size();
   gate::transaction_tablewriter(m_Trans).WriteCopyLine(
 	(!len || Line[len-1] != '\n') ?
 	Line :
         std::string(Line, 0, len-1));
+  m_Unflushed += len;
+  return true;
 }
 
 
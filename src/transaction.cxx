@@ -36,33 +36,55 @@ pqxx::basic_transaction::basic_transaction(
 
 void pqxx::basic_transaction::do_commit()
 {
+  // If the transaction never executed anything, it never started either.
+  if (cancel_deferred_begin()) return;
+
   try
   {
     DirectExec(internal::sql_commit_work);
   }
   catch (const std::exception &e)
   {
-    if (!conn().is_open())
-    {
-      // We've lost the connection while committing.  There is just no way of
-      // telling what happened on the other end.  >8-O
-      process_notice(e.what() + std::string("\n"));
+    // If we've lost the connection, there is no telling what happened.
+    if (!conn().is_open()) lost_connection(e);
+
+    // Commit failed--probably due to a constraint violation or something
+    // similar.
+    throw;
+  }
+}
 
-      const std::string Msg = "WARNING: "
-		  "Connection lost while committing transaction "
-		  "'" + name() + "'. "
-		  "There is no way to tell whether the transaction succeeded "
-		  "or was aborted except to check manually.";
 
-      process_notice(Msg + "\n");
-      throw in_doubt_error(Msg);
-    }
-    else
-    {
-      // Commit failed--probably due to a constraint violation or something
-      // similar.
-      throw;
-    }
+pqxx::result pqxx::basic_transaction::do_exec_and_commit(const char Query[])
+{
+  bool committing = false;
+  try
+  {
+    return exec_then(Query, internal::sql_commit_work, committing);
+  }
+  catch (const std::exception &e)
+  {
+    if (!conn().is_open()) lost_connection(e);
+
+    // If it was the query that failed, the transaction is still open.
+    if (!committing) try { do_abort(); } catch (const std::exception &) {}
+    throw;
   }
 }
 
+
+void pqxx::basic_transaction::lost_connection(const std::exception &e)
+{
+  // We've lost the connection while committing.  There is just no way of
+  // telling what happened on the other end.  >8-O
+  process_notice(e.what() + std::string("\n"));
+
+  const std::string Msg = "WARNING: "
+	"Connection lost while committing transaction "
+	"'" + name() + "'. "
+	"There is no way to tell whether the transaction succeeded "
+	"or was aborted except to check manually.";
+
+  process_notice(Msg + "\n");
+  throw in_doubt_error(Msg);
+}
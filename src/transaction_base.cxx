@@ -283,6 +283,68 @@ pqxx::result pqxx::transaction_base::exec(const std::string &Query,
 }
 
 
+pqxx::result pqxx::transaction_base::exec_and_commit(
+	const std::string &Query,
+	const std::string &Desc)
+{
+  CheckPendingError();
+
+  const std::string N = (Desc.empty() ? "" : "'" + Desc + "' ");
+
+  if (m_Focus.get())
+    throw usage_error("Attempt to execute query " + N +
+		      "on " + description() + " "
+		      "with " + m_Focus.get()->description() + " "
+		      "still open");
+
+  try
+  {
+    activate();
+  }
+  catch (const usage_error &e)
+  {
+    throw usage_error("Error executing query " + N + ".  " + e.what());
+  }
+
+  // As in commit(): if the connection is known to be broken, say so before
+  // sending anything, rather than leaving the caller in doubt.
+  if (!m_Conn.is_open())
+    throw broken_connection("Broken connection to backend; "
+	"cannot complete transaction");
+
+  result R;
+  try
+  {
+    R = do_exec_and_commit(Query.c_str());
+    m_Status = st_committed;
+  }
+  catch (const in_doubt_error &)
+  {
+    m_Status = st_in_doubt;
+    throw;
+  }
+  catch (const std::exception &)
+  {
+    m_Status = st_aborted;
+    throw;
+  }
+
+  gate::connection_transaction gate(conn());
+  gate.AddVariables(m_Vars);
+
+  End();
+  return R;
+}
+
+
+pqxx::result pqxx::transaction_base::do_exec_and_commit(const char Query[])
+{
+  const result R = do_exec(Query);
+  do_commit();
+  return R;
+}
+
+
 pqxx::internal::parameterized_invocation
 pqxx::transaction_base::parameterized(const std::string &query)
 {
@@ -442,7 +504,7 @@ void pqxx::transaction_base::CheckPendingError()
   {
     const std::string Err(m_PendingError);
     m_PendingError.clear();
-    throw failure(m_PendingError);
+    throw failure(Err);
   }
 }
 
@@ -480,6 +542,12 @@ bool pqxx::transaction_base::ReadCopyLine(std::string &line)
 }
 
 
+int pqxx::transaction_base::TryReadCopyLine(std::string &line)
+{
+  return gate::connection_transaction(conn()).TryReadCopyLine(line);
+}
+
+
 void pqxx::transaction_base::WriteCopyLine(const std::string &line)
 {
   gate::connection_transaction gate(conn());
@@ -35,6 +35,13 @@
 #include <unistd.h>
 #endif
 
+#ifdef PQXX_HAVE_CLOCK_MONOTONIC
+#include <time.h>
+#endif
+#ifndef _WIN32
+#include <sys/time.h>
+#endif
+
 #ifdef _WIN32
 #include <windows.h>
 #endif
@@ -221,6 +228,44 @@ void pqxx::internal::sleep_seconds(int s)
 }
 
 
+void pqxx::internal::sleep_msec(unsigned long ms)
+{
+  if (!ms) return;
+
+#if defined(_WIN32)
+  Sleep(ms);
+#else
+  struct timeval timeout;
+  timeout.tv_sec = long(ms / 1000);
+  timeout.tv_usec = long(ms % 1000) * 1000;
+  if (select(0, NULL, NULL, NULL, &timeout) == -1 && errno != EINTR)
+    throw internal_error("select() failed for unknown reason");
+#endif
+}
+
+
+unsigned long pqxx::internal::clock_msec() PQXX_NOEXCEPT
+{
+  // Use a monotonic clock where there is one, so that adjustments to the
+  // system's wall clock don't distort the intervals we measure.
+#if defined(_WIN32)
+  return GetTickCount();
+#elif defined(PQXX_HAVE_CLOCK_MONOTONIC)
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return
+	static_cast<unsigned long>(now.tv_sec) * 1000 +
+	static_cast<unsigned long>(now.tv_nsec) / 1000000;
+#else
+  struct timeval now;
+  gettimeofday(&now, 0);
+  return
+	static_cast<unsigned long>(now.tv_sec) * 1000 +
+	static_cast<unsigned long>(now.tv_usec) / 1000;
+#endif
+}
+
+
 #if !defined(PQXX_HAVE_STRERROR_R) || !defined(PQXX_HAVE_STRERROR_R_GNU)
 namespace
 {
@@ -0,0 +1,50 @@
+#include <test_helpers.hxx>
+
+using namespace std;
+using namespace pqxx;
+
+namespace
+{
+void test_adaptive_stride(transaction_base &t)
+{
+  icursorstream c(t, "SELECT generate_series(1, 1000)", "adaptive", 1);
+  PQXX_CHECK(!c.adaptive_stride(), "Adaptive stride is on by default.");
+  PQXX_CHECK_THROWS(
+	c.set_adaptive_stride(0),
+	argument_error,
+	"Zero byte target went unnoticed.");
+
+  // Tiny rows, huge byte target, no time target: stride doubles up to max.
+  c.set_adaptive_stride(1000000, 0, 50);
+  PQXX_CHECK(c.adaptive_stride(), "set_adaptive_stride() did not take.");
+
+  int expected = 1;
+  result r;
+  while (c >> r)
+  {
+    PQXX_CHECK(r.size() <= 50u, "Block exceeds maximum stride.");
+    for (result::size_type i = 0; i < r.size(); ++i, ++expected)
+      PQXX_CHECK_EQUAL(r[i][0].as<int>(), expected, "Rows out of order.");
+    PQXX_CHECK(c.stride() <= 50, "Stride exceeds maximum.");
+  }
+  PQXX_CHECK_EQUAL(expected, 1001, "Lost rows.");
+  PQXX_CHECK_EQUAL(c.stride(), 50, "Stride did not grow to maximum.");
+
+  // Wide rows against a small byte target keep the stride down.
+  icursorstream w(t, "SELECT repeat('x', 100) FROM generate_series(1, 100)",
+	"adaptive_wide",
+	20);
+  w.set_adaptive_stride(250, 0);
+  w >> r;
+  PQXX_CHECK_EQUAL(r.size(), 20u, "First block ignored initial stride.");
+  PQXX_CHECK_EQUAL(w.stride(), 2, "Stride did not adapt to wide rows.");
+
+  // A fixed stride turns adaptation off.
+  w.set_stride(7);
+  PQXX_CHECK(!w.adaptive_stride(), "set_stride() left adaptation on.");
+  w >> r;
+  PQXX_CHECK_EQUAL(w.stride(), 7, "Fixed stride changed.");
+}
+} // namespace
+
+PQXX_REGISTER_TEST_T(test_adaptive_stride, work)
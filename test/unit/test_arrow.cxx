@@ -0,0 +1,93 @@
+#include <cstring>
+
+#include <test_helpers.hxx>
+
+#include <pqxx/arrow>
+
+using namespace std;
+using namespace pqxx;
+
+namespace
+{
+template<typename T> T value(const arrow_column &c, arrow_column::size_type i)
+{
+  T v;
+  memcpy(&v, c.data() + i * sizeof(T), sizeof(T));
+  return v;
+}
+
+
+string text(const arrow_column &c, arrow_column::size_type i)
+{
+  const char *const data = reinterpret_cast<const char *>(c.data());
+  return string(data + c.offsets()[i], data + c.offsets()[i+1]);
+}
+
+
+void test_arrow(transaction_base &)
+{
+  PQXX_CHECK(arrow_type_for(23) == arrow_int32, "Wrong type for int4.");
+  PQXX_CHECK(arrow_type_for(25) == arrow_large_utf8, "Wrong type for text.");
+  PQXX_CHECK_EQUAL(
+	string(arrow_format(arrow_float64)),
+	string("g"),
+	"Wrong Arrow format for float64.");
+
+  arrow_batch b;
+  b.add_column("id", 20);
+  b.add_column("flag", 16);
+  b.add_column("name", 25);
+  b.add_column("score", 701);
+
+  b.append_copy_line("1\tt\tone\t1.5");
+  b.append_copy_line("2\t\\N\ttab\\there\t\\N");
+  b.append_copy_line("3\tf\t\\N\t-2");
+  PQXX_CHECK_EQUAL(b.rows(), 3u, "Wrong number of rows.");
+
+  const arrow_column &id = b[0], &flag = b[1], &name = b[2], &score = b[3];
+  PQXX_CHECK(id.type() == arrow_int64, "Wrong type for int8.");
+  PQXX_CHECK_EQUAL(value<long long>(id, 2), 3LL, "Wrong int64 value.");
+  PQXX_CHECK_EQUAL(id.null_count(), 0u, "Spurious nulls.");
+
+  // Booleans are a bitmap: row 0 is true, row 1 null, row 2 false.
+  PQXX_CHECK_EQUAL(int(flag.data()[0]), 0x01, "Wrong boolean bitmap.");
+  PQXX_CHECK_EQUAL(int(flag.validity()[0]), 0x05, "Wrong validity bitmap.");
+
+  PQXX_CHECK_EQUAL(text(name, 0), "one", "Wrong string value.");
+  PQXX_CHECK_EQUAL(text(name, 1), "tab\there", "COPY escape not decoded.");
+  PQXX_CHECK_EQUAL(text(name, 2), "", "Null string not empty.");
+  PQXX_CHECK_EQUAL(name.null_count(), 1u, "Wrong string null count.");
+
+  PQXX_CHECK_EQUAL(value<double>(score, 2), -2.0, "Wrong float64 value.");
+  PQXX_CHECK_EQUAL(score.data_size(), 3 * sizeof(double), "Bad data size.");
+
+  // A bad line changes nothing.
+  PQXX_CHECK_THROWS(
+	b.append_copy_line("4\tt\tfour"),
+	failure,
+	"Short COPY line went unnoticed.");
+  PQXX_CHECK_THROWS(
+	b.append_copy_line("4\tt\tfour\tnotanumber"),
+	failure,
+	"Bad number went unnoticed.");
+  PQXX_CHECK_EQUAL(b.rows(), 3u, "Failed append changed row count.");
+  for (arrow_batch::size_type c = 0; c < b.columns(); ++c)
+    PQXX_CHECK_EQUAL(b[c].size(), 3u, "Failed append left partial row.");
+  PQXX_CHECK_EQUAL(name.data_size(), 11u, "Failed append left string data.");
+
+  PQXX_CHECK_THROWS(
+	b.add_column("late", 23),
+	usage_error,
+	"Added column to nonempty batch.");
+
+  // Clearing keeps the columns.
+  b.clear();
+  PQXX_CHECK_EQUAL(b.rows(), 0u, "clear() left rows.");
+  PQXX_CHECK_EQUAL(b.columns(), 4u, "clear() lost columns.");
+  PQXX_CHECK_EQUAL(name.offsets()[0], 0LL, "Bad offsets after clear().");
+  b.append_copy_line("5\tf\tfive\t0");
+  PQXX_CHECK_EQUAL(text(name, 0), "five", "Wrong string after clear().");
+}
+} // namespace
+
+PQXX_REGISTER_TEST_NODB(test_arrow)
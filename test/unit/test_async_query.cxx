@@ -0,0 +1,64 @@
+#include <test_helpers.hxx>
+
+#include <pqxx/async_query>
+
+using namespace std;
+using namespace pqxx;
+
+namespace
+{
+void test_async_query(transaction_base &t)
+{
+  // An async_query holds transaction focus while it runs.
+  async_query q(t, "SELECT 1, 2", "test_async_query");
+  PQXX_CHECK_THROWS(
+	t.exec("SELECT 3"),
+	logic_error,
+	"async_query does not block regular queries.");
+
+  PQXX_CHECK(q.sock() >= 0, "No socket to wait on.");
+
+  // Poll until the result comes in, as an event loop would.
+  for (int attempts = 0; !q.ready(); ++attempts)
+  {
+    PQXX_CHECK(attempts < 10, "async_query never became ready.");
+    pqxx::internal::sleep_seconds(1);
+  }
+  PQXX_CHECK(q.done(), "Ready async_query is not done.");
+
+  result r = q.get();
+  PQXX_CHECK_EQUAL(r.size(), 1u, "Wrong result size from async_query.");
+  PQXX_CHECK_EQUAL(r[0][1].as<int>(), 2, "Wrong data from async_query.");
+
+  // Once done, the async_query no longer holds up the transaction.
+  PQXX_CHECK_EQUAL(
+	t.exec("SELECT 4")[0][0].as<int>(),
+	4,
+	"Transaction broken after async_query.");
+
+  // Errors come out of get().
+  async_query bad(t, "SELECT nonexistent_column_xyz");
+  PQXX_CHECK_THROWS(bad.get(), sql_error, "async_query swallowed error.");
+
+  // Destroying a running async_query cancels it; the connection stays usable.
+  {
+    async_query sleeper(t, "SELECT pg_sleep(10)");
+  }
+  PQXX_CHECK_EQUAL(
+	t.conn().is_open(),
+	true,
+	"Connection lost after canceling async_query.");
+
+  // The cancellation error is reported once, on the next use.
+  PQXX_CHECK_THROWS(
+	t.exec("SELECT 5"),
+	failure,
+	"Cancellation of async_query went unreported.");
+  PQXX_CHECK_EQUAL(
+	t.exec("SELECT 6")[0][0].as<int>(),
+	6,
+	"Nontransaction broken after canceled async_query.");
+}
+} // namespace
+
+PQXX_REGISTER_TEST_T(test_async_query, nontransaction)
@@ -0,0 +1,90 @@
+#include <test_helpers.hxx>
+
+using namespace std;
+using namespace pqxx;
+
+namespace
+{
+vector<string> make_row(const string &id, const string &n)
+{
+  vector<string> row;
+  row.push_back(id);
+  row.push_back(n);
+  return row;
+}
+
+
+void load_with_rejects(connection_base &conn)
+{
+  work trans(conn);
+  trans.exec(
+	"CREATE TEMP TABLE loadtest "
+	"(id INTEGER PRIMARY KEY, n INTEGER CHECK (n >= 0))");
+
+  vector<vector<string> > rows;
+  for (int i = 0; i < 100; ++i) rows.push_back(make_row(to_string(i), "1"));
+  rows[17] = make_row("16", "1");
+  rows[50] = make_row("50", "-1");
+  rows[51] = make_row("51", "x");
+
+  batch_loader loader(trans, "loadtest");
+  loader.load(rows.begin(), rows.end());
+  PQXX_CHECK_EQUAL(loader.pending(), 100ul, "Wrong number of pending rows.");
+  PQXX_CHECK_EQUAL(loader.flush(), 97ul, "Wrong number of rows loaded.");
+  PQXX_CHECK_EQUAL(loader.pending(), 0ul, "flush() left rows pending.");
+
+  PQXX_CHECK_EQUAL(loader.rejects().size(), 3u, "Wrong number of rejects.");
+  PQXX_CHECK_EQUAL(loader.rejects()[0].index, 17ul, "Wrong reject.");
+  PQXX_CHECK_EQUAL(loader.rejects()[1].index, 50ul, "Wrong reject.");
+  PQXX_CHECK_EQUAL(loader.rejects()[2].index, 51ul, "Wrong reject.");
+  PQXX_CHECK_EQUAL(loader.rejects()[0].line, "16\t1", "Wrong rejected line.");
+  PQXX_CHECK(!loader.rejects()[0].error.empty(), "No error for reject.");
+
+  // Every bad row costs two attempts per halving, at most.
+  PQXX_CHECK(loader.attempts() <= 43ul, "Too many attempts to isolate rows.");
+
+  // A clean batch goes in at once.  Row numbers continue from the last batch.
+  const batch_loader::size_type before = loader.attempts();
+  loader.insert(make_row("100", "2"));
+  loader.insert(make_row("100", "2"));
+  loader.insert(make_row("101", "2"));
+  PQXX_CHECK_EQUAL(loader.flush(), 2ul, "Wrong count for second batch.");
+  PQXX_CHECK_EQUAL(loader.rejects()[3].index, 101ul, "Wrong reject index.");
+  loader.clear_rejects();
+  loader.write_raw_line("102\t3");
+  loader.flush();
+  PQXX_CHECK_EQUAL(loader.attempts(), before + 6, "Wrong number of attempts.");
+  PQXX_CHECK(loader.rejects().empty(), "Spurious rejects.");
+  PQXX_CHECK_EQUAL(loader.rows(), 100ul, "Wrong total row count.");
+
+  PQXX_CHECK_EQUAL(
+	trans.exec("SELECT count(*) FROM loadtest")[0][0].as<int>(),
+	100,
+	"Wrong number of rows in table.");
+
+  // Errors that are not about the data don't get bisected.
+  batch_loader bad(trans, "nonexistent_table");
+  bad.insert(make_row("1", "1"));
+  bad.insert(make_row("2", "1"));
+  PQXX_CHECK_THROWS(bad.flush(), undefined_table, "Missing table not noticed.");
+  PQXX_CHECK_EQUAL(bad.attempts(), 1ul, "Retried a hopeless batch.");
+  PQXX_CHECK_EQUAL(bad.pending(), 0ul, "Failed flush left rows pending.");
+
+  // The transaction itself is still usable.
+  trans.exec("SELECT 1");
+}
+
+
+void test_batch_loader(transaction_base &nontrans)
+{
+  connection_base &conn(nontrans.conn());
+  nontrans.abort();
+  load_with_rejects(conn);
+
+  conn.set_deferred_begin(true);
+  load_with_rejects(conn);
+  conn.set_deferred_begin(false);
+}
+} // namespace
+
+PQXX_REGISTER_TEST_T(test_batch_loader, nontransaction)
@@ -96,6 +96,22 @@ void test_binarystring(transaction_base &T)
 
   b = make_binarystring(T, "\\x");
   PQXX_CHECK_EQUAL(b.str(), "\\x", "Hex-escape header confused (un)escaping.");
+
+  // In binary format, the binarystring refers to the result's own data.  The
+  // parameter must go in binary format too: libpq would cut a text one short
+  // at its nul byte.
+  T.conn().prepare("binary_bytea", "SELECT $1::bytea");
+  const result r =
+	T.prepared("binary_bytea")(binarystring(nully)).exec_binary();
+  PQXX_CHECK_EQUAL(r.column_format(0), 1, "Result is not in binary format.");
+  b = binarystring(r[0][0]);
+  PQXX_CHECK_EQUAL(b.str(), nully, "Binary-format bytea came out wrong.");
+  PQXX_CHECK(
+	b.get() == r[0][0].c_str(),
+	"Binary-format bytea was copied.");
+  const binarystring copy(b);
+  b = make_binarystring(T, "x");
+  PQXX_CHECK_EQUAL(copy.str(), nully, "Copy lost binary-format data.");
 }
 } // namespace
 
@@ -0,0 +1,59 @@
+#include <test_helpers.hxx>
+
+using namespace std;
+using namespace pqxx;
+
+namespace
+{
+void test_column(transaction_base &)
+{
+  column<int> empty;
+  PQXX_CHECK(empty.empty(), "Default column is not empty.");
+  PQXX_CHECK(empty.data() == 0, "Empty column has data.");
+  PQXX_CHECK(empty.validity() == 0, "Empty column has a bitmap.");
+
+  // Nulls at positions 1, 8, and 9, so the bitmap spans two bytes.
+  column<int> c;
+  c.reserve(10);
+  for (int i = 0; i < 10; ++i)
+  {
+    if (i == 1 || i == 8 || i == 9) c.push_null();
+    else c.push_back(i * 10);
+  }
+
+  PQXX_CHECK_EQUAL(c.size(), 10u, "Wrong column size.");
+  PQXX_CHECK_EQUAL(c.null_count(), 3u, "Wrong null count.");
+  PQXX_CHECK_EQUAL(c[7], 70, "Wrong value.");
+  PQXX_CHECK_EQUAL(c.data()[2], 20, "Values are not contiguous.");
+  PQXX_CHECK_EQUAL(c[1], 0, "Null does not hold default value.");
+  PQXX_CHECK(c.is_null(1), "Null not recognized.");
+  PQXX_CHECK(!c.is_null(2), "Non-null taken for null.");
+
+  // Arrow layout: least significant bit first, set bits for non-null values.
+  PQXX_CHECK_EQUAL(int(c.validity()[0]), 0xfd, "Wrong first bitmap byte.");
+  PQXX_CHECK_EQUAL(int(c.validity()[1]), 0x00, "Wrong second bitmap byte.");
+
+  // std::vector<bool> packs its values, so column<bool> indexing has to work
+  // without references to the stored values.
+  column<bool> b;
+  b.push_back(true);
+  b.push_null();
+  b.push_back(false);
+  b.push_back(true);
+  PQXX_CHECK(b[0], "Wrong bool value.");
+  PQXX_CHECK(!b[1], "Bool null does not hold default value.");
+  PQXX_CHECK(!b[2], "Wrong bool value.");
+  PQXX_CHECK(b[3], "Wrong bool value.");
+  PQXX_CHECK(b.is_null(1), "Bool null not recognized.");
+  PQXX_CHECK_EQUAL(int(b.validity()[0]), 0x0d, "Wrong bool bitmap.");
+
+  column<int> d;
+  d.swap(c);
+  PQXX_CHECK(c.empty(), "Swap left data behind.");
+  PQXX_CHECK_EQUAL(d.null_count(), 3u, "Swap lost null count.");
+  d.clear();
+  PQXX_CHECK_EQUAL(d.null_count(), 0u, "Clear left nulls.");
+}
+} // namespace
+
+PQXX_REGISTER_TEST_NODB(test_column)
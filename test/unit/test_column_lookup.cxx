@@ -0,0 +1,71 @@
+#include <test_helpers.hxx>
+
+using namespace std;
+using namespace pqxx;
+
+namespace
+{
+void test_column_lookup(transaction_base &trans)
+{
+  const result r = trans.exec(
+	"SELECT 1 AS a, 2 AS b, 3 AS a, 4 AS \"Mixed\", 5 AS \"x\"\"y\", "
+	"6 AS \"\"");
+
+  PQXX_CHECK_EQUAL(r.column_number("b"), 1u, "Wrong column for name.");
+  PQXX_CHECK_EQUAL(r.column_number("a"), 0u, "Duplicate name: not first.");
+  PQXX_CHECK_EQUAL(r.column_number("A"), 0u, "Name not case-folded.");
+  PQXX_CHECK_EQUAL(
+	r.column_number("\"Mixed\""),
+	3u,
+	"Quoted name not found.");
+  PQXX_CHECK_THROWS(
+	r.column_number("Mixed"),
+	argument_error,
+	"Unquoted name matched mixed-case column.");
+  PQXX_CHECK_EQUAL(
+	r.column_number("\"x\"\"y\""),
+	4u,
+	"Doubled quote not handled.");
+  PQXX_CHECK_THROWS(
+	r.column_number("nonexistent"),
+	argument_error,
+	"Unknown column name went unnoticed.");
+
+  // Repeated lookups go through the same index.
+  for (int i = 0; i < 3; ++i)
+  {
+    PQXX_CHECK_EQUAL(r[0]["b"].as<int>(), 2, "Wrong field by name.");
+    PQXX_CHECK_EQUAL(r[0]["a"].as<int>(), 1, "Wrong duplicate by name.");
+  }
+
+  // Copies of a result share its index.
+  const result copy(r);
+  PQXX_CHECK_EQUAL(copy.column_number("b"), 1u, "Copy lost column names.");
+
+  // Many columns, to exercise collisions in the index.
+  string query = "SELECT ";
+  for (int c = 0; c < 100; ++c)
+  {
+    if (c) query += ", ";
+    query += to_string(c) + " AS c" + to_string(c);
+  }
+  const result wide = trans.exec(query);
+  for (int c = 0; c < 100; ++c)
+    PQXX_CHECK_EQUAL(
+	wide.column_number("c" + to_string(c)),
+	row::size_type(c),
+	"Wrong column in wide result.");
+  PQXX_CHECK_THROWS(
+	wide.column_number("c100"),
+	argument_error,
+	"Nonexistent column found in wide result.");
+
+  const result empty;
+  PQXX_CHECK_THROWS(
+	empty.column_number("a"),
+	argument_error,
+	"Found column in empty result.");
+}
+} // namespace
+
+PQXX_REGISTER_TEST(test_column_lookup)
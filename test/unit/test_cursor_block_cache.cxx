@@ -0,0 +1,89 @@
+#include <test_helpers.hxx>
+
+using namespace std;
+using namespace pqxx;
+
+namespace
+{
+typedef stateless_cursor<cursor_base::read_only, cursor_base::owned> cursor;
+
+void compare(const result &expected, const result &actual, const string &what)
+{
+  PQXX_CHECK_EQUAL(actual.size(), expected.size(), "Wrong size: " + what);
+  PQXX_CHECK_EQUAL(actual.columns(), expected.columns(), "Columns: " + what);
+  for (result::size_type i = 0; i < expected.size(); ++i)
+    for (row::size_type c = 0; c < expected.columns(); ++c)
+    {
+      PQXX_CHECK_EQUAL(
+	actual[i][c].is_null(),
+	expected[i][c].is_null(),
+	"Nullness mismatch: " + what);
+      PQXX_CHECK_EQUAL(
+	actual[i][c].c_str(),
+	string(expected[i][c].c_str()),
+	"Data mismatch: " + what);
+    }
+}
+
+
+void test_cursor_block_cache(transaction_base &trans)
+{
+  const string query =
+	"SELECT n, CASE WHEN n % 3 = 0 THEN NULL ELSE 'r' || n END AS s "
+	"FROM generate_series(0, 99) AS n";
+
+  cursor plain(trans, query, "plain", false);
+  cursor cached(trans, query, "cached", false);
+  cached.set_cache(16);
+
+  PQXX_CHECK_EQUAL(cached.size(), plain.size(), "Cached size() differs.");
+
+  // Every combination of these positions, in both directions.
+  const int positions[] =
+	{ -3, -1, 0, 1, 15, 16, 17, 31, 40, 90, 99, 100, 120 };
+  const int num_positions = int(sizeof(positions) / sizeof(*positions));
+  for (int b = 0; b < num_positions; ++b)
+  {
+    const int begin = positions[b];
+    if (begin < 0 || begin > 100) continue;
+    for (int e = 0; e < num_positions; ++e)
+    {
+      const int end = positions[e];
+      compare(
+	plain.retrieve(begin, end),
+	cached.retrieve(begin, end),
+	to_string(begin) + ".." + to_string(end));
+    }
+  }
+
+  PQXX_CHECK_THROWS(
+	cached.retrieve(101, 0),
+	out_of_range,
+	"Cached retrieve accepted bad start position.");
+
+  // A small budget evicts old blocks, but retrieval still works.
+  cursor small(trans, query, "small", false);
+  small.set_cache(10, 1);
+  compare(
+	plain.retrieve(0, 100),
+	small.retrieve(0, 100),
+	"retrieval through tiny cache");
+  compare(
+	plain.retrieve(35, 75),
+	small.retrieve(35, 75),
+	"retrieval after eviction");
+
+  // With everything cached, retrieval no longer needs the SQL cursor.  This
+  // must come last: the cursor's destructor will fail to close it.
+  const result all = plain.retrieve(0, 100);
+  cached.retrieve(0, 100);
+  trans.exec("CLOSE \"" + cached.name() + "\"");
+  compare(all, cached.retrieve(0, 100), "all rows from cache");
+  compare(
+	plain.retrieve(60, 20),
+	cached.retrieve(60, 20),
+	"backwards from cache");
+}
+} // namespace
+
+PQXX_REGISTER_TEST_T(test_cursor_block_cache, work)
@@ -0,0 +1,68 @@
+#include <test_helpers.hxx>
+
+using namespace std;
+using namespace pqxx;
+
+namespace
+{
+void test_cursor_prefetch(transaction_base &t)
+{
+  const string query = "SELECT generate_series(1, 10)";
+
+  result r;
+  {
+    icursorstream c(t, query, "prefetch", 3);
+    PQXX_CHECK(!c.prefetch(), "Cursor stream prefetches by default.");
+    c.set_prefetch();
+    PQXX_CHECK(c.prefetch(), "set_prefetch() did not take.");
+
+    c >> r;
+    PQXX_CHECK_EQUAL(r.size(), 3u, "Wrong block size.");
+    PQXX_CHECK_EQUAL(r[0][0].as<int>(), 1, "Wrong first row.");
+
+    // The next block is on its way, so the transaction is busy.
+    PQXX_CHECK_THROWS(
+	t.exec("SELECT 1"),
+	logic_error,
+	"Transaction accepted query while cursor was prefetching.");
+
+    // A stride change applies only after the block that's already underway.
+    c.set_stride(4);
+    c >> r;
+    PQXX_CHECK_EQUAL(r.size(), 3u, "Prefetched block has wrong size.");
+    PQXX_CHECK_EQUAL(r[0][0].as<int>(), 4, "Prefetched wrong block.");
+
+    // Can't skip only part of a prefetched block.
+    PQXX_CHECK_THROWS(
+	c.ignore(2),
+	usage_error,
+	"Partial ignore() of prefetched block went unnoticed.");
+  }
+
+  // Destroying the stream let its prefetch finish, without aborting the
+  // transaction.
+  PQXX_CHECK_EQUAL(
+	t.exec("SELECT 2")[0][0].as<int>(),
+	2,
+	"Closing prefetching cursor stream broke transaction.");
+
+  icursorstream c(t, query, "prefetch2", 3);
+  c.set_prefetch();
+  c >> r;
+  c.ignore(4);
+  c >> r;
+  PQXX_CHECK_EQUAL(r.size(), 3u, "Wrong block size after ignore().");
+  PQXX_CHECK_EQUAL(r[0][0].as<int>(), 8, "ignore() skipped wrong rows.");
+
+  // Reading the final block ends the prefetching.
+  c >> r;
+  PQXX_CHECK(r.empty(), "Cursor stream did not end.");
+  PQXX_CHECK(!c, "Cursor stream does not know it's done.");
+  PQXX_CHECK_EQUAL(
+	t.exec("SELECT 5")[0][0].as<int>(),
+	5,
+	"Transaction still busy after cursor stream ended.");
+}
+} // namespace
+
+PQXX_REGISTER_TEST_T(test_cursor_prefetch, work)
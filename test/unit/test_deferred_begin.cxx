@@ -0,0 +1,83 @@
+#include <test_helpers.hxx>
+
+using namespace std;
+using namespace pqxx;
+
+namespace
+{
+void test_deferred_begin(transaction_base &orgT)
+{
+  connection_base &conn = orgT.conn();
+  orgT.abort();
+
+  PQXX_CHECK(!conn.deferred_begin(), "Deferred BEGIN is on by default.");
+  conn.set_deferred_begin(true);
+  PQXX_CHECK(conn.deferred_begin(), "set_deferred_begin() did not take.");
+
+  {
+    // The first statement carries the BEGIN, and runs inside the transaction.
+    work t(conn);
+    const string xid = t.exec("SELECT txid_current()")[0][0].as<string>();
+    PQXX_CHECK_EQUAL(
+	t.exec("SELECT txid_current()")[0][0].as<string>(),
+	xid,
+	"Statements ran in different transactions.");
+    t.commit();
+  }
+
+  {
+    transaction<serializable> t(conn);
+    PQXX_CHECK_EQUAL(
+	t.exec("SHOW transaction_isolation")[0][0].as<string>(),
+	string("serializable"),
+	"Deferred BEGIN lost isolation level.");
+  }
+
+  {
+    // An error in the first statement is reported against that statement.
+    work t(conn);
+    const string query = "SELECT * FROM pqxx_nonexistent_table";
+    try
+    {
+      t.exec(query);
+      PQXX_CHECK_NOTREACHED("Query on nonexistent table succeeded.");
+    }
+    catch (const sql_error &e)
+    {
+      PQXX_CHECK_EQUAL(e.query(), query, "Error attributed to wrong query.");
+    }
+  }
+
+  {
+    // Transactions that execute nothing cost nothing.
+    work t(conn);
+    t.commit();
+    work u(conn);
+    u.abort();
+  }
+
+  {
+    // Statements that can't carry the BEGIN send it first.
+    work t(conn);
+    const string xid =
+	t.parameterized("SELECT txid_current() + $1")(0).exec()[0][0].as<string>();
+    PQXX_CHECK_EQUAL(
+	t.exec("SELECT txid_current()")[0][0].as<string>(),
+	xid,
+	"Parameterized statement ran outside the transaction.");
+  }
+
+  {
+    // Large object calls bypass the regular query path, but still run inside
+    // the transaction: the object's descriptor stays valid.
+    work t(conn);
+    largeobjectaccess obj(t);
+    obj.write("x", 1);
+    PQXX_CHECK_EQUAL(obj.seek(0, ios::beg), 0L, "Large object seek failed.");
+  }
+
+  conn.set_deferred_begin(false);
+}
+} // namespace
+
+PQXX_REGISTER_TEST_T(test_deferred_begin, nontransaction)
@@ -0,0 +1,104 @@
+#include <test_helpers.hxx>
+
+using namespace std;
+using namespace pqxx;
+
+namespace
+{
+int count_rows(connection_base &conn, const string &table)
+{
+  nontransaction n(conn);
+  return n.exec("SELECT count(*) FROM " + table)[0][0].as<int>();
+}
+
+
+void test_exec_and_commit(transaction_base &orgT)
+{
+  connection_base &conn = orgT.conn();
+  orgT.abort();
+
+  const string table = "pqxx_exec_and_commit";
+  {
+    nontransaction n(conn);
+    n.exec("DROP TABLE IF EXISTS " + table);
+    n.exec(
+	"CREATE TABLE " + table + " (x integer UNIQUE "
+	"DEFERRABLE INITIALLY DEFERRED)");
+  }
+
+  {
+    work t(conn);
+    t.exec("INSERT INTO " + table + " VALUES (1)");
+    const result r =
+	t.exec_and_commit("INSERT INTO " + table + " VALUES (2) RETURNING x");
+    PQXX_CHECK_EQUAL(r[0][0].as<int>(), 2, "Wrong result from query.");
+    PQXX_CHECK_THROWS(
+	t.exec("SELECT 1"),
+	usage_error,
+	"Transaction still usable after exec_and_commit.");
+  }
+  PQXX_CHECK_EQUAL(count_rows(conn, table), 2, "exec_and_commit lost data.");
+
+  {
+    // A failing query aborts the transaction, and says so.
+    work t(conn);
+    t.exec("INSERT INTO " + table + " VALUES (3)");
+    const string query = "SELECT * FROM pqxx_nonexistent_table";
+    try
+    {
+      t.exec_and_commit(query);
+      PQXX_CHECK_NOTREACHED("Bad query went unnoticed.");
+    }
+    catch (const sql_error &e)
+    {
+      PQXX_CHECK_EQUAL(e.query(), query, "Error attributed to wrong query.");
+    }
+  }
+  PQXX_CHECK_EQUAL(count_rows(conn, table), 2, "Failed query committed.");
+
+  {
+    // A failing commit is reported as such.
+    work t(conn);
+    try
+    {
+      t.exec_and_commit("INSERT INTO " + table + " VALUES (1)");
+      PQXX_CHECK_NOTREACHED("Deferred constraint violation went unnoticed.");
+    }
+    catch (const sql_error &e)
+    {
+      PQXX_CHECK_EQUAL(e.query(), string("COMMIT"), "Error not in COMMIT.");
+    }
+  }
+  PQXX_CHECK_EQUAL(count_rows(conn, table), 2, "Failed commit committed.");
+
+  // Deferred BEGIN, query, and commit all go out together.
+  conn.set_deferred_begin(true);
+  {
+    work t(conn);
+    t.exec_and_commit("INSERT INTO " + table + " VALUES (4)");
+  }
+  conn.set_deferred_begin(false);
+  PQXX_CHECK_EQUAL(count_rows(conn, table), 3, "Single-flight commit failed.");
+
+  {
+    // A connection that is known to be broken fails before sending anything,
+    // just like commit() does, rather than leaving the outcome in doubt.
+    connection c;
+    work t(c);
+    t.exec("SELECT 1");
+    c.simulate_failure();
+    PQXX_CHECK_THROWS(
+	t.exec_and_commit("SELECT 1"),
+	broken_connection,
+	"exec_and_commit on broken connection did not report it.");
+  }
+
+  {
+    // Other transaction types fall back to exec() and commit().
+    nontransaction n(conn);
+    n.exec_and_commit("DROP TABLE " + table);
+  }
+}
+} // namespace
+
+PQXX_REGISTER_TEST_T(test_exec_and_commit, nontransaction)
@@ -0,0 +1,49 @@
+#include <test_helpers.hxx>
+
+using namespace std;
+using namespace pqxx;
+
+namespace
+{
+void test_field_view(transaction_base &trans)
+{
+  field_view v;
+  {
+    const result r = trans.exec(
+	"SELECT 'hello'::text, NULL::text, 'hello world'::text");
+    const field f = r[0][0];
+    v = f.view();
+    PQXX_CHECK_EQUAL(v.size(), 5u, "Wrong view size.");
+    PQXX_CHECK(v == "hello", "View has wrong contents.");
+    PQXX_CHECK(v == string("hello"), "View differs from equal string.");
+    PQXX_CHECK(v != r[0][2].view(), "Views of different text compare equal.");
+    PQXX_CHECK(v < r[0][2].view(), "Wrong view ordering.");
+    PQXX_CHECK_EQUAL(v.str(), "hello", "Wrong string from view.");
+
+    PQXX_CHECK(r[0][1].view().empty(), "Null field has nonempty view.");
+    field_view n;
+    PQXX_CHECK(!r[0][1].to(n), "to() did not report null.");
+    PQXX_CHECK(r[0][2].to(n), "to() reported null.");
+    PQXX_CHECK(n == "hello world", "to() gave wrong view.");
+    PQXX_CHECK(
+	r[0][0].as<field_view>() == "hello",
+	"as<field_view>() gave wrong view.");
+
+    // A copy of the result keeps the data, and the views, alive.
+    const result copy(r);
+    const field_view w = copy[0][0].view();
+    PQXX_CHECK(w == v, "Views of the same field differ.");
+  }
+
+  PQXX_CHECK_EQUAL(v.size(), 5u, "Dangling view lost its size.");
+#ifdef PQXX_DEBUG_VIEWS
+  // In a build configured with --enable-debug-views, using a view of a
+  // destroyed result throws.
+  PQXX_CHECK_THROWS(v.data(), usage_error, "Dangling view went unnoticed.");
+  field_view copy(v);
+  PQXX_CHECK_THROWS(copy.str(), usage_error, "Copied view stopped dangling.");
+#endif
+}
+} // namespace
+
+PQXX_REGISTER_TEST(test_field_view)
@@ -0,0 +1,31 @@
+#include <test_helpers.hxx>
+
+using namespace std;
+using namespace pqxx;
+
+namespace
+{
+void test_largeobject_64(transaction_base &nontrans)
+{
+  connection_base &conn(nontrans.conn());
+  nontrans.abort();
+  if (!conn.supports(connection_base::cap_large_objects_64)) return;
+
+  work trans(conn);
+  largeobjectaccess obj(trans);
+
+  // Large objects can be sparse, so this doesn't write 3 GB of data.
+  const largeobjectaccess::pos64_type far = 3LL * 1024 * 1024 * 1024;
+  PQXX_CHECK_EQUAL(obj.seek64(far, ios::beg), far, "Bad 64-bit seek.");
+  obj.write("x", 1);
+  PQXX_CHECK_EQUAL(obj.tell64(), far + 1, "Bad 64-bit tell.");
+  PQXX_CHECK_EQUAL(obj.seek64(0, ios::end), far + 1, "Bad object size.");
+
+  obj.truncate(10);
+  PQXX_CHECK_EQUAL(obj.seek64(0, ios::end), 10LL, "truncate() failed.");
+  PQXX_CHECK_EQUAL(obj.seek(-4, ios::cur), 6L, "Bad seek after truncate.");
+  PQXX_CHECK_EQUAL(obj.tell(), 6L, "Bad tell after truncate.");
+}
+} // namespace
+
+PQXX_REGISTER_TEST_T(test_largeobject_64, nontransaction)
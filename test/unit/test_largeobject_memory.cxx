@@ -0,0 +1,56 @@
+#include <cstdio>
+#include <iterator>
+#include <list>
+
+#include <test_helpers.hxx>
+
+using namespace std;
+using namespace pqxx;
+
+namespace
+{
+void test_largeobject_memory(transaction_base &nontrans)
+{
+  connection_base &conn(nontrans.conn());
+  nontrans.abort();
+  work trans(conn);
+
+  // Span several buffers' worth, including zero bytes.
+  string data;
+  for (long i = 0; i < 2 * largeobject::default_buffer_size + 5; ++i)
+    data += char(i % 251);
+
+  const largeobject from_mem(trans, data.data(), long(data.size()));
+  string out = "junk";
+  from_mem.to_buffer(trans, out);
+  PQXX_CHECK(out == data, "Memory roundtrip changed the data.");
+
+  const largeobject empty(trans, "", 0);
+  empty.to_buffer(trans, out);
+  PQXX_CHECK(out.empty(), "Empty object came back nonempty.");
+
+  const list<char> chars(data.begin(), data.begin() + 1000);
+  const largeobject from_iter(trans, chars.begin(), chars.end());
+  string iterated;
+  from_iter.to_iterator(trans, back_inserter(iterated));
+  PQXX_CHECK(
+	iterated == data.substr(0, 1000),
+	"Iterator roundtrip changed the data.");
+
+  FILE *const f = tmpfile();
+  PQXX_CHECK(f != NULL, "Could not create temporary file.");
+  from_mem.to_fd(trans, fileno(f));
+  rewind(f);
+  const largeobject from_file = largeobject::from_fd(trans, fileno(f));
+  fclose(f);
+  from_file.to_buffer(trans, out);
+  PQXX_CHECK(out == data, "File descriptor roundtrip changed the data.");
+
+  PQXX_CHECK_THROWS(
+	largeobject::from_fd(trans, -1),
+	failure,
+	"Reading a bad file descriptor went unnoticed.");
+}
+} // namespace
+
+PQXX_REGISTER_TEST_T(test_largeobject_memory, nontransaction)
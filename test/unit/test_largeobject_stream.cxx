@@ -0,0 +1,93 @@
+#include <test_helpers.hxx>
+
+using namespace std;
+using namespace pqxx;
+
+namespace
+{
+string make_data(string::size_type n)
+{
+  string data;
+  for (string::size_type i = 0; i < n; ++i) data += char('a' + i % 26);
+  return data;
+}
+
+
+string read_all(dbtransaction &trans, oid id)
+{
+  ilostream in(trans, id, 16);
+  string data;
+  char c;
+  while (in.get(c)) data += c;
+  return data;
+}
+
+
+void test_largeobject_stream(transaction_base &nontrans)
+{
+  PQXX_CHECK(
+	largeobject::default_buffer_size >= 65536,
+	"Default large object buffer is small.");
+
+  connection_base &conn(nontrans.conn());
+  nontrans.abort();
+  work trans(conn);
+  const largeobject obj(trans);
+
+  // Small writes get buffered; large ones bypass the small buffer.
+  const string big = make_data(100);
+  {
+    olostream out(trans, obj, 16);
+    out << "abc";
+    out.write(big.c_str(), streamsize(big.size()));
+    out << "xyz";
+  }
+  const string expected = "abc" + big + "xyz";
+  PQXX_CHECK_EQUAL(read_all(trans, obj.id()), expected, "Bad data written.");
+
+  {
+    ilostream in(trans, obj, 16);
+    char c;
+    in.get(c);
+    in.get(c);
+    PQXX_CHECK_EQUAL(string(1, c), "b", "Wrong data read.");
+    PQXX_CHECK_EQUAL(
+	int(in.tellg()),
+	2,
+	"tellg() did not account for read-ahead.");
+
+    char buf[80];
+    in.read(buf, sizeof(buf));
+    PQXX_CHECK_EQUAL(
+	string(buf, sizeof(buf)),
+	expected.substr(2, sizeof(buf)),
+	"Large read went wrong.");
+    PQXX_CHECK_EQUAL(int(in.tellg()), 82, "Wrong position after large read.");
+
+    in.seekg(3, ios::cur);
+    in.get(c);
+    PQXX_CHECK_EQUAL(
+	string(1, c),
+	expected.substr(85, 1),
+	"Relative seek went wrong.");
+  }
+
+  // Writing after reading ahead writes where the stream is, not the object.
+  {
+    lostream io(trans, obj, 16);
+    char c;
+    for (int i = 0; i < 5; ++i) io.get(c);
+    io.seekp(0, ios::cur);
+    io << 'Z';
+    io.flush();
+  }
+  string changed = expected;
+  changed[5] = 'Z';
+  PQXX_CHECK_EQUAL(
+	read_all(trans, obj.id()),
+	changed,
+	"Mixed read/write went to the wrong place.");
+}
+} // namespace
+
+PQXX_REGISTER_TEST_T(test_largeobject_stream, nontransaction)
@@ -0,0 +1,112 @@
+#include <cstdio>
+
+#include <test_helpers.hxx>
+
+using namespace std;
+using namespace pqxx;
+
+namespace
+{
+void test_mapped_result(transaction_base &trans)
+{
+  const string path = "pqxx-test-mapped-result.tmp";
+  const string query =
+	"SELECT n, CASE WHEN n % 3 = 0 THEN NULL ELSE repeat('x', n) END AS s, "
+	"'' AS e "
+	"FROM generate_series(1, 50) AS n ORDER BY n";
+  const result r = trans.exec(query);
+
+  {
+    result_spiller spill(path);
+    icursorstream cur(trans, query, "spill", 7);
+    PQXX_CHECK_EQUAL(spill.read(cur), r.size(), "Wrong number of rows read.");
+    spill.append(trans.exec(query + " LIMIT 1"));
+    PQXX_CHECK_THROWS(
+	spill.append(trans.exec("SELECT 1")),
+	usage_error,
+	"Column count mismatch went unnoticed.");
+    spill.finish();
+    PQXX_CHECK_THROWS(
+	spill.append(r),
+	usage_error,
+	"Appending after finish() went unnoticed.");
+  }
+
+  {
+    const mapped_result m(path);
+    PQXX_CHECK_EQUAL(m.size(), r.size() + 1, "Wrong number of rows.");
+    PQXX_CHECK_EQUAL(m.columns(), 3u, "Wrong number of columns.");
+    PQXX_CHECK_EQUAL(string(m.column_name(1)), "s", "Wrong column name.");
+    PQXX_CHECK_EQUAL(m.column_type(0), r.column_type(0), "Wrong column type.");
+    PQXX_CHECK_EQUAL(m.column_number("e"), 2u, "Wrong column number.");
+
+    // Random access, in no particular order.
+    for (result::size_type i = 0; i < r.size(); ++i)
+    {
+      const result::size_type j = (i * 17) % r.size();
+      for (row::size_type c = 0; c < r.columns(); ++c)
+      {
+        const mapped_field f = m[j][c];
+        PQXX_CHECK_EQUAL(f.is_null(), r[j][c].is_null(), "Null mismatch.");
+        PQXX_CHECK_EQUAL(f.size(), r[j][c].size(), "Size mismatch.");
+        PQXX_CHECK_EQUAL(
+		string(f.c_str()),
+		string(r[j][c].c_str()),
+		"Value mismatch.");
+      }
+    }
+    // Sequential access, through iterators.
+    result::size_type rows = 0;
+    for (mapped_result::const_iterator i = m.begin(); i != m.end(); ++i, ++rows)
+    {
+      PQXX_CHECK_EQUAL(i->rownumber(), rows, "Iterator at wrong row.");
+      PQXX_CHECK_EQUAL(
+	i.end() - i.begin(),
+	mapped_row::difference_type(m.columns()),
+	"Wrong number of fields in iteration.");
+      row::size_type c = 0;
+      for (mapped_row::const_iterator f = i->begin(); f != i->end(); ++f, ++c)
+        PQXX_CHECK_EQUAL(
+		string(f->c_str()),
+		string(m[rows][c].c_str()),
+		"Iterated field is wrong.");
+    }
+    PQXX_CHECK_EQUAL(rows, m.size(), "Wrong number of rows in iteration.");
+    PQXX_CHECK_EQUAL(
+	m.end() - m.begin(),
+	mapped_result::difference_type(m.size()),
+	"Wrong iterator distance.");
+    PQXX_CHECK_EQUAL(
+	(m.end() - 1)[0].as<int>(),
+	1,
+	"Stepping back from end() went wrong.");
+
+    PQXX_CHECK_EQUAL(m[49]["n"].as<int>(), 50, "Wrong value by name.");
+    PQXX_CHECK_EQUAL(m[50][0].as<int>(), 1, "Appended row is wrong.");
+    PQXX_CHECK(m[2]["s"].view().empty(), "Null has nonempty view.");
+    PQXX_CHECK_EQUAL(m[2][1].as<string>("null"), "null", "Bad null default.");
+    PQXX_CHECK_THROWS(m.at(51), pqxx::range_error, "Bad row went unnoticed.");
+    PQXX_CHECK_THROWS(
+	m[0].at(3),
+	pqxx::range_error,
+	"Bad column went unnoticed.");
+    PQXX_CHECK_THROWS(
+	m[0]["nonexistent"],
+	argument_error,
+	"Bad column name went unnoticed.");
+  }
+
+  // An unfinished spill file does not survive.
+  {
+    result_spiller spill(path);
+    spill.append(r);
+  }
+  PQXX_CHECK_THROWS(
+	mapped_result m(path),
+	failure,
+	"Unfinished spill file was left behind.");
+  remove(path.c_str());
+}
+} // namespace
+
+PQXX_REGISTER_TEST(test_mapped_result)
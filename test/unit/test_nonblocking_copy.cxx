@@ -0,0 +1,58 @@
+#include <test_helpers.hxx>
+
+using namespace std;
+using namespace pqxx;
+
+namespace
+{
+/// Wait for a stream's socket, as an event loop would.
+void wait_for(const tablestream &s, bool write)
+{
+  internal::wait_any(vector<pair<int, bool> >(1, make_pair(s.sock(), write)));
+}
+
+
+void test_nonblocking_copy(transaction_base &t)
+{
+  t.exec("CREATE TEMP TABLE pqxx_nbcopy (num INTEGER, txt VARCHAR)");
+
+  const int rows = 10000;
+  {
+    tablewriter w(t, "pqxx_nbcopy");
+    w.set_nonblocking(true);
+    PQXX_CHECK(w.is_nonblocking(), "Could not set nonblocking mode.");
+    for (int i=0; i<rows; ++i)
+    {
+      const string line = to_string(i) + "\tline " + to_string(i);
+      // Enough data to hit backpressure; retry once the socket is writable.
+      while (!w.try_write_raw_line(line))
+        if (w.wants_write()) wait_for(w, true);
+    }
+    w.complete();
+    PQXX_CHECK(!w.is_nonblocking(), "Stream did not leave nonblocking mode.");
+  }
+
+  PQXX_CHECK_EQUAL(
+	t.exec("SELECT count(*) FROM pqxx_nbcopy")[0][0].as<int>(),
+	rows,
+	"Wrong number of rows after nonblocking COPY.");
+
+  tablereader r(t, "pqxx_nbcopy");
+  r.set_nonblocking(true);
+  int count = 0;
+  string line;
+  while (r)
+  {
+    if (r.try_get_raw_line(line)) ++count;
+    else if (r) wait_for(r, false);
+  }
+  PQXX_CHECK_EQUAL(count, rows, "Wrong number of rows read without blocking.");
+  PQXX_CHECK(!r.try_get_raw_line(line), "Read past end of COPY.");
+  r.complete();
+
+  // The connection is back to normal.
+  PQXX_CHECK_EQUAL(t.exec("SELECT 1")[0][0].as<int>(), 1, "Bad query result.");
+}
+} // namespace
+
+PQXX_REGISTER_TEST(test_nonblocking_copy)
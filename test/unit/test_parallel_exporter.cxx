@@ -0,0 +1,134 @@
+#include <test_helpers.hxx>
+
+#include <pqxx/parallel_exporter>
+
+using namespace std;
+using namespace pqxx;
+
+namespace
+{
+long first_field(const string &line)
+{
+  long n;
+  from_string(line.substr(0, line.find('\t')), n);
+  return n;
+}
+
+
+class counting_sink : public parallel_exporter::sink
+{
+public:
+  explicit counting_sink(int shards) : m_counts(shards, 0), m_sum(0) {}
+
+  virtual void operator()(
+	const string &line,
+	parallel_exporter::size_type shard) PQXX_OVERRIDE
+  {
+    ++m_counts.at(shard);
+    m_sum += first_field(line);
+  }
+
+  vector<int> m_counts;
+  long m_sum;
+};
+
+
+/// Commits a row from another session when its connection's BEGIN warns.
+/** This lands the row after the first connection has exported its snapshot,
+ * but before the second one has imported it.
+ */
+class late_insert : public errorhandler
+{
+public:
+  late_insert(connection_base &c, transaction_base &t) :
+    errorhandler(c), m_t(t), m_done(false), m_failed(false) {}
+
+  virtual bool operator()(const char[]) PQXX_NOEXCEPT PQXX_OVERRIDE
+  {
+    if (m_done) return false;
+    m_done = true;
+    try
+    {
+      m_t.exec("INSERT INTO pqxx_parallel_export VALUES (100001, 'late')");
+    }
+    catch (const exception &)
+    {
+      m_failed = true;
+    }
+    return false;
+  }
+
+  transaction_base &m_t;
+  bool m_done, m_failed;
+};
+
+
+void test_parallel_exporter(transaction_base &t)
+{
+  // The exporter's connections need to see the table; it can't be temporary.
+  t.exec("DROP TABLE IF EXISTS pqxx_parallel_export");
+  t.exec(
+	"CREATE TABLE pqxx_parallel_export AS "
+	"SELECT n AS num, 'row ' || n AS txt FROM generate_series(1, 2000) n");
+
+  // Merged stream: every row comes out exactly once.
+  {
+    connection c1, c2, c3;
+    parallel_exporter exporter("pqxx_parallel_export");
+    exporter.add_connection(c1);
+    exporter.add_connection(c2);
+    exporter.add_connection(c3);
+
+    long sum = 0;
+    string line;
+    while (exporter.get_raw_line(line))
+      sum += first_field(line);
+    PQXX_CHECK_EQUAL(exporter.rows(), 2000ul, "Wrong number of rows exported.");
+    PQXX_CHECK_EQUAL(sum, 2001000l, "Exported rows are wrong.");
+    exporter.complete();
+  }
+
+  // Custom partitions, delivered to a sink.  All connections share the same
+  // snapshot, so a row committed after the first connection took its snapshot
+  // must not show up, even though the second connection has not started yet.
+  {
+    connection c1, c2;
+    vector<string> columns;
+    columns.push_back("num");
+    parallel_exporter exporter(
+	"pqxx_parallel_export",
+	columns.begin(),
+	columns.end());
+    exporter.add_connection(c1);
+    exporter.add_connection(c2);
+    vector<string> parts;
+    parts.push_back("num % 2 = 0");
+    parts.push_back("num % 2 = 1");
+    exporter.partition(parts);
+
+    // Leave c2 inside a transaction block, so that its BEGIN gives a warning.
+    // That happens before it sets its snapshot.  Without the shared snapshot,
+    // c2 would take a fresh one at its COPY and see the late row.
+    {
+      nontransaction n(c2);
+      n.exec("BEGIN");
+    }
+    late_insert hook(c2, t);
+
+    counting_sink s(2);
+    exporter.export_to(s);
+    PQXX_CHECK(hook.m_done, "BEGIN on second connection gave no warning.");
+    PQXX_CHECK(!hook.m_failed, "Could not insert late row.");
+    PQXX_CHECK_EQUAL(s.m_sum, 2001000l, "Snapshot was not shared.");
+    PQXX_CHECK_EQUAL(
+	s.m_counts[0] + s.m_counts[1],
+	2000,
+	"Sink got wrong number of rows.");
+    exporter.complete();
+  }
+
+  t.exec("DROP TABLE pqxx_parallel_export");
+}
+} // namespace
+
+PQXX_REGISTER_TEST_T(test_parallel_exporter, nontransaction)
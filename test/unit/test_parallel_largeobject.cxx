@@ -0,0 +1,90 @@
+#include <cstdio>
+
+#include <test_helpers.hxx>
+
+#include <pqxx/parallel_largeobject>
+
+using namespace std;
+using namespace pqxx;
+
+namespace
+{
+void test_parallel_largeobject(transaction_base &nontrans)
+{
+  connection_base &conn(nontrans.conn());
+  nontrans.abort();
+
+  // The other connections need to see the object, so commit it first.
+  oid id;
+  {
+    work trans(conn);
+    id = largeobject(trans).id();
+    trans.commit();
+  }
+
+  string data;
+  for (int i = 0; i < 100000; ++i) data += char((i % 256) ^ (i / 256));
+
+  {
+    connection c1, c2, c3;
+    parallel_largeobject transfer(id, 5000);
+    transfer.add_connection(c1);
+    transfer.add_connection(c2);
+    transfer.add_connection(c3);
+    PQXX_CHECK_EQUAL(transfer.connections(), 3ul, "Wrong connection count.");
+
+    transfer.write(data);
+    PQXX_CHECK_EQUAL(
+	transfer.bytes(),
+	parallel_largeobject::size_type(data.size()),
+	"Wrong byte count.");
+
+    string back;
+    transfer.read(back);
+    PQXX_CHECK_EQUAL(back.size(), data.size(), "Wrong size read back.");
+    PQXX_CHECK(back == data, "Parallel read/write garbled data.");
+
+    // Round trip through a file, into an emptied object.
+    const char file[] = "pqxx_parallel_largeobject.tmp";
+    transfer.to_file(file);
+    {
+      work trans(conn);
+      largeobjectaccess(trans, id).truncate(0);
+      trans.commit();
+    }
+    transfer.from_file(file);
+    remove(file);
+    transfer.read(back);
+    PQXX_CHECK(back == data, "File round trip garbled data.");
+  }
+
+  // A single connection works too.
+  {
+    connection c1;
+    parallel_largeobject transfer(id);
+    transfer.add_connection(c1);
+    string back;
+    transfer.read(back);
+    PQXX_CHECK(back == data, "Single-connection read garbled data.");
+  }
+
+  // One connection, many chunks: each chunk goes out after the last one.
+  {
+    connection c1;
+    parallel_largeobject transfer(id, 4096);
+    transfer.add_connection(c1);
+    string back;
+    transfer.read(back);
+    PQXX_CHECK(back == data, "Chunked single-connection read garbled data.");
+    transfer.write(data);
+    transfer.read(back);
+    PQXX_CHECK(back == data, "Chunked single-connection write garbled data.");
+  }
+
+  work trans(conn);
+  largeobject(id).remove(trans);
+  trans.commit();
+}
+} // namespace
+
+PQXX_REGISTER_TEST_T(test_parallel_largeobject, nontransaction)
@@ -0,0 +1,76 @@
+#include <test_helpers.hxx>
+
+#include <pqxx/parallel_loader>
+
+using namespace std;
+using namespace pqxx;
+
+namespace
+{
+void test_parallel_loader(transaction_base &t)
+{
+  // The loader's connections need to see the table, so it can't be temporary.
+  t.exec("DROP TABLE IF EXISTS pqxx_parallel_load");
+  t.exec("CREATE TABLE pqxx_parallel_load (num INTEGER, txt VARCHAR)");
+
+  const int rows = 5000;
+  vector<vector<string> > data;
+  for (int i=0; i<rows; ++i)
+  {
+    vector<string> row;
+    row.push_back(to_string(i));
+    row.push_back("row " + to_string(i));
+    data.push_back(row);
+  }
+
+  {
+    connection c1, c2, c3;
+    vector<string> columns;
+    columns.push_back("num");
+    columns.push_back("txt");
+    parallel_loader loader("pqxx_parallel_load", columns.begin(), columns.end());
+    loader.add_connection(c1);
+    loader.add_connection(c2);
+    loader.add_connection(c3);
+    PQXX_CHECK_EQUAL(loader.connections(), 3ul, "Wrong connection count.");
+
+    loader.load(data.begin(), data.end());
+    PQXX_CHECK_EQUAL(loader.rows(), 5000ul, "Wrong row count.");
+    PQXX_CHECK(loader.bytes() > 0, "No bytes counted.");
+
+    // Nothing is visible before the loader commits.
+    PQXX_CHECK_EQUAL(
+	t.exec("SELECT count(*) FROM pqxx_parallel_load")[0][0].as<int>(),
+	0,
+	"Uncommitted parallel load is visible.");
+
+    loader.commit();
+    PQXX_CHECK_THROWS(
+	loader.write_raw_line("1\tone"),
+	usage_error,
+	"Writing to committed parallel_loader did not fail.");
+  }
+
+  PQXX_CHECK_EQUAL(
+	t.exec("SELECT count(DISTINCT num) FROM pqxx_parallel_load")[0][0].as<int>(),
+	rows,
+	"Wrong number of rows after parallel load.");
+
+  // An aborted load leaves no trace.
+  {
+    connection c1, c2;
+    parallel_loader loader("pqxx_parallel_load");
+    loader.add_connection(c1);
+    loader.add_connection(c2);
+    loader.load(data.begin(), data.end());
+  }
+  PQXX_CHECK_EQUAL(
+	t.exec("SELECT count(*) FROM pqxx_parallel_load")[0][0].as<int>(),
+	rows,
+	"Aborted parallel load left data behind.");
+
+  t.exec("DROP TABLE pqxx_parallel_load");
+}
+} // namespace
+
+PQXX_REGISTER_TEST_T(test_parallel_loader, nontransaction)
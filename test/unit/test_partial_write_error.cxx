@@ -0,0 +1,42 @@
+#include <test_helpers.hxx>
+
+#include <pqxx/parallel_largeobject>
+
+using namespace std;
+using namespace pqxx;
+
+namespace
+{
+void test_partial_write_error(transaction_base &)
+{
+  typedef partial_write_error::range range;
+  vector<range> committed;
+  committed.push_back(range(200, 300));
+  committed.push_back(range(0, 100));
+  committed.push_back(range(100, 200));
+  committed.push_back(range(500, 600));
+  vector<range> in_doubt;
+  in_doubt.push_back(range(300, 400));
+
+  const partial_write_error e("Oops.", committed, in_doubt);
+  PQXX_CHECK_EQUAL(e.committed().size(), 2u, "Ranges were not merged.");
+  PQXX_CHECK_EQUAL(e.committed()[0].first, 0, "Wrong range start.");
+  PQXX_CHECK_EQUAL(e.committed()[0].second, 300, "Wrong range end.");
+  PQXX_CHECK_EQUAL(e.committed()[1].first, 500, "Ranges not sorted.");
+  PQXX_CHECK_EQUAL(e.in_doubt().size(), 1u, "Lost range in doubt.");
+  PQXX_CHECK_EQUAL(
+	string(e.what()),
+	"Oops.\n"
+	"Committed bytes: [0, 300), [500, 600)\n"
+	"Bytes in doubt: [300, 400)",
+	"Wrong error message.");
+
+  const partial_write_error f("Oops.", committed, vector<range>());
+  PQXX_CHECK(f.in_doubt().empty(), "Invented ranges in doubt.");
+  PQXX_CHECK(
+	string(f.what()).find("Bytes in doubt: none") != string::npos,
+	"Message does not say nothing is in doubt.");
+}
+} // namespace
+
+PQXX_REGISTER_TEST_NODB(test_partial_write_error)
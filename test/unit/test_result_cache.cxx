@@ -0,0 +1,127 @@
+#include <test_helpers.hxx>
+
+using namespace std;
+using namespace pqxx;
+
+namespace
+{
+void compare(const result &expected, const result &actual)
+{
+  PQXX_CHECK_EQUAL(actual.size(), expected.size(), "Wrong number of rows.");
+  PQXX_CHECK_EQUAL(
+	actual.columns(),
+	expected.columns(),
+	"Wrong number of columns.");
+  PQXX_CHECK_EQUAL(actual.query(), expected.query(), "Query was lost.");
+  for (row::size_type c = 0; c < expected.columns(); ++c)
+  {
+    PQXX_CHECK_EQUAL(
+	string(actual.column_name(c)),
+	string(expected.column_name(c)),
+	"Wrong column name.");
+    PQXX_CHECK_EQUAL(
+	actual.column_type(c),
+	expected.column_type(c),
+	"Wrong column type.");
+  }
+  for (result::size_type r = 0; r < expected.size(); ++r)
+    for (row::size_type c = 0; c < expected.columns(); ++c)
+    {
+      PQXX_CHECK_EQUAL(
+	actual[r][c].is_null(),
+	expected[r][c].is_null(),
+	"Nullness mismatch.");
+      PQXX_CHECK_EQUAL(
+	actual[r][c].as<string>(""),
+	expected[r][c].as<string>(""),
+	"Value mismatch.");
+    }
+}
+
+
+void test_result_cache(transaction_base &trans)
+{
+  const result r = trans.exec(
+	"SELECT n, CASE WHEN n % 2 = 0 THEN NULL ELSE 'x' || n END AS s "
+	"FROM generate_series(1, 20) AS n ORDER BY n");
+  compare(r, result::deserialize(r.serialize()));
+  compare(result(), result::deserialize(result().serialize()));
+
+  const result cmd = trans.exec("SET client_min_messages = 'notice'");
+  compare(cmd, result::deserialize(cmd.serialize()));
+
+  string blob = r.serialize();
+  PQXX_CHECK_THROWS(
+	result::deserialize(blob.substr(0, blob.size() - 1)),
+	failure,
+	"Truncated blob went unnoticed.");
+  blob[0] = 'X';
+  PQXX_CHECK_THROWS(
+	result::deserialize(blob),
+	failure,
+	"Bad magic went unnoticed.");
+
+  memory_result_store store;
+  result_cache cache(store, 60);
+  const string query = "SELECT generate_series(1, $1::integer)";
+  vector<string> params(1, "3");
+
+  compare(
+	trans.parameterized(query)("3").exec(),
+	cache.exec(trans, query, params));
+  PQXX_CHECK_EQUAL(cache.misses(), 1u, "First lookup was not a miss.");
+  const result cached = cache.exec(trans, query, params);
+  PQXX_CHECK_EQUAL(cache.hits(), 1u, "Second lookup was not a hit.");
+  PQXX_CHECK_EQUAL(cached.size(), 3u, "Cached result is wrong.");
+
+  params[0] = "4";
+  PQXX_CHECK_EQUAL(
+	cache.exec(trans, query, params).size(),
+	4u,
+	"Different parameters hit the same cache entry.");
+  PQXX_CHECK_EQUAL(store.entries(), 2u, "Wrong number of cache entries.");
+
+  cache.invalidate(query, params);
+  PQXX_CHECK_EQUAL(store.entries(), 1u, "invalidate() did not take.");
+
+  // An expired entry is a miss.
+  cache.set_ttl(0);
+  cache.exec(trans, "SELECT 1");
+  const unsigned long misses = cache.misses();
+  cache.exec(trans, "SELECT 1");
+  PQXX_CHECK_EQUAL(cache.misses(), misses + 1, "Expired entry was a hit.");
+
+  // The store stays within its budget.
+  memory_result_store tiny(blob.size() + 100);
+  result_cache small(tiny, 60);
+  small.store("a", r);
+  small.store("b", r);
+  PQXX_CHECK_EQUAL(tiny.entries(), 1u, "Store exceeded its budget.");
+  PQXX_CHECK(tiny.bytes() <= blob.size() + 100, "Store size out of bounds.");
+
+  // When it needs room, the store drops the entries closest to expiry.
+  memory_result_store two(20);
+  two.put("a", "12345678", 600);
+  two.put("b", "12345678", 60);
+  two.put("c", "12345678", 300);
+  string out;
+  PQXX_CHECK(two.get("a", out), "Evicted entry with longest time to live.");
+  PQXX_CHECK(!two.get("b", out), "Did not evict entry closest to expiry.");
+  PQXX_CHECK(two.get("c", out), "Lost newly stored entry.");
+
+  // Caches with different namespaces don't see each other's results.
+  result_cache db1(store, 60, "db1"), db2(store, 60, "db2");
+  db1.store("k", r);
+  result found;
+  PQXX_CHECK(db1.lookup("k", found), "Namespaced entry was lost.");
+  PQXX_CHECK(!db2.lookup("k", found), "Namespace leaked.");
+  PQXX_CHECK(!cache.lookup("k", found), "Namespace leaked to default.");
+
+  PQXX_CHECK(
+	result_cache::make_key("ab", vector<string>(1, "c")) !=
+	result_cache::make_key("a", vector<string>(1, "bc")),
+	"Ambiguous cache keys.");
+}
+} // namespace
+
+PQXX_REGISTER_TEST(test_result_cache)
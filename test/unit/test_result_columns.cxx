@@ -0,0 +1,41 @@
+#include <test_helpers.hxx>
+
+using namespace std;
+using namespace pqxx;
+
+namespace
+{
+void test_result_columns(transaction_base &t)
+{
+  const result r = t.exec(
+	"SELECT n, CASE WHEN n % 4 = 0 THEN NULL ELSE 'x' || n END AS s "
+	"FROM generate_series(1, 20) AS n");
+
+  column<int> n;
+  r.to_column(0, n);
+  PQXX_CHECK_EQUAL(n.size(), r.size(), "Wrong column size.");
+  PQXX_CHECK_EQUAL(n.null_count(), 0u, "Spurious nulls.");
+  for (result::size_type i = 0; i < r.size(); ++i)
+    PQXX_CHECK_EQUAL(n[i], r[i][0].as<int>(), "Wrong value in column.");
+
+  column<string> s;
+  r.to_column("s", s);
+  PQXX_CHECK_EQUAL(s.null_count(), 5u, "Wrong null count.");
+  PQXX_CHECK(s.is_null(3), "Null field came out non-null.");
+  PQXX_CHECK_EQUAL(s[4], "x5", "Wrong string value.");
+
+  PQXX_CHECK_THROWS(
+	r.to_column(2, n),
+	pqxx::range_error,
+	"to_column() accepted bad column number.");
+
+  // Conversion errors come out, and leave the target unchanged.
+  PQXX_CHECK_THROWS(
+	r.to_column("s", n),
+	failure,
+	"Bad conversion went unnoticed.");
+  PQXX_CHECK_EQUAL(n.size(), r.size(), "Failed conversion changed column.");
+}
+} // namespace
+
+PQXX_REGISTER_TEST_T(test_result_columns, nontransaction)
@@ -0,0 +1,82 @@
+#include <test_helpers.hxx>
+
+using namespace std;
+using namespace pqxx;
+
+namespace
+{
+// Retry policy that records its waits, instead of waiting.
+class quick_policy : public retry_policy
+{
+public:
+  quick_policy(int Attempts, unsigned long Initial, unsigned long Max,
+	unsigned long Deadline=0) :
+    retry_policy(Attempts, Initial, Max, Deadline),
+    waits()
+  {}
+
+  vector<unsigned long> waits;
+
+protected:
+  virtual void sleep(unsigned long Msec) PQXX_OVERRIDE
+	{ waits.push_back(Msec); }
+};
+
+
+void test_retry_policy(transaction_base &)
+{
+  PQXX_CHECK_THROWS(
+	retry_policy(0),
+	argument_error,
+	"Policy without attempts went unnoticed.");
+
+  quick_policy p(4, 10, 50);
+  PQXX_CHECK(
+	p.retryable(serialization_failure("x")),
+	"Serialization failure not retryable.");
+  PQXX_CHECK(
+	p.retryable(deadlock_detected("x")),
+	"Deadlock not retryable.");
+  PQXX_CHECK(
+	p.retryable(broken_connection("x")),
+	"Broken connection not retryable.");
+  PQXX_CHECK(!p.retryable(in_doubt_error("x")), "In-doubt error retryable.");
+  PQXX_CHECK(!p.retryable(unique_violation("x")), "Bad SQL retryable.");
+  PQXX_CHECK(!p.retryable(logic_error("x")), "Non-SQL error retryable.");
+
+  // Waits stay below an exponentially growing ceiling, up to the maximum.
+  for (int i = 0; i < 1000; ++i)
+  {
+    PQXX_CHECK(p.backoff(0) <= 10, "First wait too long.");
+    PQXX_CHECK(p.backoff(2) <= 40, "Third wait too long.");
+    PQXX_CHECK(p.backoff(20) <= 50, "Wait exceeds maximum.");
+  }
+
+  // Retries stop after the last attempt, and get counted.
+  p.start();
+  int attempt = 1;
+  while (p.retry(deadlock_detected("x"), attempt, "mover")) ++attempt;
+  PQXX_CHECK_EQUAL(attempt, 4, "Wrong number of attempts.");
+  PQXX_CHECK_EQUAL(p.waits.size(), 3u, "Wrong number of waits.");
+  PQXX_CHECK_EQUAL(p.retries("mover"), 3ul, "Retries not counted.");
+  PQXX_CHECK_EQUAL(p.retries("other"), 0ul, "Retries counted for others.");
+
+  PQXX_CHECK(
+	!p.retry(unique_violation("x"), 1, "mover"),
+	"Retried non-retryable error.");
+  PQXX_CHECK_EQUAL(p.retries("mover"), 3ul, "Refused retry was counted.");
+
+  p.clear_stats();
+  PQXX_CHECK(p.stats().empty(), "clear_stats() left counts.");
+
+  // Once past the deadline, there are no more retries.
+  quick_policy d(100, 0, 0, 1);
+  d.start();
+  internal::sleep_msec(5);
+  PQXX_CHECK(
+	!d.retry(serialization_failure("x"), 1, "late"),
+	"Retried past deadline.");
+}
+} // namespace
+
+PQXX_REGISTER_TEST_NODB(test_retry_policy)
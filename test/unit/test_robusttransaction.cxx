@@ -0,0 +1,50 @@
+#include <test_helpers.hxx>
+
+using namespace std;
+using namespace pqxx;
+
+namespace
+{
+void test_robusttransaction(transaction_base &orgT)
+{
+  connection_base &conn = orgT.conn();
+  orgT.abort();
+
+  const string table = "pqxx_robust_test";
+  {
+    nontransaction n(conn);
+    n.exec("DROP TABLE IF EXISTS " + table);
+    n.exec("CREATE TABLE " + table + " (x integer)");
+  }
+
+  {
+    robusttransaction<> t(conn);
+    t.exec("INSERT INTO " + table + " VALUES (1)");
+    t.commit();
+  }
+  {
+    robusttransaction<> t(conn);
+    t.exec("INSERT INTO " + table + " VALUES (2)");
+    t.abort();
+  }
+
+  nontransaction n(conn);
+  PQXX_CHECK_EQUAL(
+	n.exec("SELECT sum(x) FROM " + table)[0][0].as<int>(),
+	1,
+	"robusttransaction committed or aborted wrongly.");
+
+  // Where the server knows txid_status(), no log table is needed.
+  if (conn.supports(connection_base::cap_txid_status))
+    PQXX_CHECK(
+	n.exec(
+	  "SELECT 1 FROM pg_tables "
+	  "WHERE tablename = 'pqxx_robusttransaction_log'").empty() ||
+	n.exec("SELECT 1 FROM pqxx_robusttransaction_log").empty(),
+	"robusttransaction left a log record.");
+
+  n.exec("DROP TABLE " + table);
+}
+} // namespace
+
+PQXX_REGISTER_TEST_T(test_robusttransaction, nontransaction)
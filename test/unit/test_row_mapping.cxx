@@ -0,0 +1,87 @@
+#include <test_helpers.hxx>
+
+#include <pqxx/row_mapping>
+
+using namespace std;
+using namespace pqxx;
+
+namespace
+{
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1800)
+struct item
+{
+  int id;
+  string name;
+  double price;
+};
+
+typedef row_mapping<item,
+	PQXX_MEMBER(item, id),
+	PQXX_MEMBER(item, name),
+	PQXX_MEMBER(item, price)> item_mapping;
+
+
+void test_row_mapping(transaction_base &trans)
+{
+  const result r = trans.exec(
+	"SELECT n, 'item' || n, n * 1.5::float8 "
+	"FROM generate_series(1, 5) AS n ORDER BY n");
+
+  vector<tuple<int, string, double> > tuples;
+  to_tuples(r, tuples);
+  PQXX_CHECK_EQUAL(tuples.size(), 5u, "Wrong number of tuples.");
+  PQXX_CHECK_EQUAL(get<0>(tuples[2]), 3, "Wrong integer in tuple.");
+  PQXX_CHECK_EQUAL(get<1>(tuples[2]), "item3", "Wrong string in tuple.");
+  PQXX_CHECK_EQUAL(get<2>(tuples[2]), 4.5, "Wrong double in tuple.");
+
+  // Reading into a bigger vector shrinks it to fit.
+  vector<item> items(10);
+  item_mapping::to_vector(r, items);
+  PQXX_CHECK_EQUAL(items.size(), 5u, "Wrong number of structs.");
+  PQXX_CHECK_EQUAL(items[4].id, 5, "Wrong struct member.");
+  PQXX_CHECK_EQUAL(items[4].name, "item5", "Wrong string member.");
+
+  PQXX_CHECK_THROWS(
+	(as_tuples<int, string>(r)),
+	usage_error,
+	"Column count mismatch went unnoticed.");
+  PQXX_CHECK_THROWS(
+	(as_tuples<bool, string, double>(r)),
+	usage_error,
+	"Reading int as bool went unnoticed.");
+  PQXX_CHECK_THROWS(
+	(as_tuples<int>(trans.exec("SELECT now()"))),
+	usage_error,
+	"Reading timestamp as int went unnoticed.");
+
+  // Integral values of other numeric or text types read as integers.
+  const result sums = trans.exec(
+	"SELECT sum(n::bigint), count(*)::numeric, '5' "
+	"FROM generate_series(1, 4) AS n");
+  const tuple<long, long, long> t = as_tuples<long, long, long>(sums)[0];
+  PQXX_CHECK_EQUAL(get<0>(t), 10L, "Wrong sum.");
+  PQXX_CHECK_EQUAL(get<1>(t), 4L, "Wrong numeric count.");
+  PQXX_CHECK_EQUAL(get<2>(t), 5L, "Wrong integer from text.");
+
+  // Nulls read as null for types that have one, and throw otherwise.
+  const result nulls = trans.exec("SELECT NULL::text, NULL::integer");
+  PQXX_CHECK(
+	get<0>((as_tuples<const char *, const char *>(nulls))[0]) == 0,
+	"Null did not read as null pointer.");
+  PQXX_CHECK_THROWS(
+	(as_tuples<const char *, int>(nulls)),
+	conversion_error,
+	"Null int went unnoticed.");
+  PQXX_CHECK_EQUAL(
+	(as_tuples<int>(trans.exec("SELECT 1 WHERE false")).size()),
+	0u,
+	"Empty result did not give empty vector.");
+}
+#else
+void test_row_mapping(transaction_base &)
+{
+}
+#endif
+} // namespace
+
+PQXX_REGISTER_TEST(test_row_mapping)
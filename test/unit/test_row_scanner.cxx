@@ -0,0 +1,61 @@
+#include <test_helpers.hxx>
+
+using namespace std;
+using namespace pqxx;
+
+namespace
+{
+void test_row_scanner(transaction_base &trans)
+{
+  const result r = trans.exec(
+	"SELECT n, CASE WHEN n % 2 = 0 THEN NULL ELSE 'v' || n END "
+	"FROM generate_series(1, 5) AS n ORDER BY n");
+
+  row_scanner s(r);
+  PQXX_CHECK_EQUAL(s.columns(), 2u, "Wrong number of columns.");
+  PQXX_CHECK_EQUAL(s.row_number(), -1, "Scanner did not start before row 0.");
+
+  // The scanner must see exactly what the iterators see.
+  for (result::const_iterator i = r.begin(); i != r.end(); ++i)
+  {
+    PQXX_CHECK(s.next(), "Scanner ran out of rows early.");
+    PQXX_CHECK_EQUAL(
+	s.row_number(),
+	result::difference_type(i.rownumber()),
+	"Wrong row number.");
+    for (row::size_type c = 0; c < s.columns(); ++c)
+    {
+      PQXX_CHECK_EQUAL(s.is_null(c), i[c].is_null(), "Nullness mismatch.");
+      PQXX_CHECK_EQUAL(s.size(c), i[c].size(), "Size mismatch.");
+      PQXX_CHECK_EQUAL(
+	string(s.c_str(c)),
+	string(i[c].c_str()),
+	"Value mismatch.");
+      PQXX_CHECK_EQUAL(
+	s.lengths()[c],
+	i[c].is_null() ? -1 : int(i[c].size()),
+	"Wrong length array.");
+      PQXX_CHECK(s.values()[c] == s.c_str(c), "Wrong value array.");
+      PQXX_CHECK(s.view(c) == i[c].view(), "Wrong view.");
+    }
+  }
+  PQXX_CHECK(!s.next(), "Scanner went past the end.");
+  PQXX_CHECK(!s.next(), "Scanner went past the end on second try.");
+
+  int n = 0;
+  s.seek(1);
+  PQXX_CHECK(s.to(0, n), "to() reported null.");
+  PQXX_CHECK_EQUAL(n, 2, "Wrong value after seek().");
+  PQXX_CHECK(!s.to(1, n), "Null value not reported.");
+  PQXX_CHECK_EQUAL(n, 2, "to() changed value for null.");
+  s.seek(-1);
+  PQXX_CHECK(s.next(), "No rows after seeking back to the start.");
+  PQXX_CHECK_EQUAL(s.row_number(), 0, "Wrong row after rewinding.");
+  PQXX_CHECK_THROWS(s.seek(5), pqxx::range_error, "Bad seek() went unnoticed.");
+
+  row_scanner e((result()));
+  PQXX_CHECK(!e.next(), "Empty result has rows.");
+}
+} // namespace
+
+PQXX_REGISTER_TEST(test_row_scanner)
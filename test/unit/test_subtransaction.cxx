@@ -71,6 +71,53 @@ void test_subtransaction_aborts_implicitly(connection_base &conn)
 }
 
 
+void test_deferred_subtransactions_isolate_failures(connection_base &conn)
+{
+  work trans(conn);
+  trans.exec("CREATE TEMP TABLE bar (x INTEGER UNIQUE)");
+  trans.exec("INSERT INTO bar(x) VALUES (3)");
+
+  // Every third row nests a second level, and inserts two values.  Rows 0, 3,
+  // and 9 run into existing values and fail; the rest go in.
+  int failures = 0;
+  for (int i = 0; i < 10; ++i)
+  {
+    try
+    {
+      subtransaction sub(trans);
+      if (i % 3)
+      {
+        sub.exec("INSERT INTO bar(x) VALUES (" + to_string(i) + ")");
+      }
+      else
+      {
+        subtransaction inner(sub);
+        inner.exec("INSERT INTO bar(x) VALUES (" + to_string(i) + ")");
+        inner.exec("INSERT INTO bar(x) VALUES (" + to_string(i + 3) + ")");
+        inner.commit();
+      }
+      sub.commit();
+    }
+    catch (const unique_violation &)
+    {
+      ++failures;
+    }
+  }
+  PQXX_CHECK_EQUAL(failures, 3, "Wrong number of failed rows.");
+
+  // An untouched subtransaction costs nothing, and breaks nothing.
+  {
+    subtransaction idle(trans);
+    idle.commit();
+  }
+
+  PQXX_CHECK_EQUAL(
+	trans.exec("SELECT count(*) FROM bar")[0][0].as<int>(),
+	9,
+	"Deferred subtransactions lost or kept the wrong rows.");
+}
+
+
 void test_subtransaction(transaction_base &nontrans)
 {
   connection_base &conn(nontrans.conn());
@@ -78,6 +125,13 @@ void test_subtransaction(transaction_base &nontrans)
   test_subtransaction_commits_if_commit_called(conn);
   test_subtransaction_aborts_if_abort_called(conn);
   test_subtransaction_aborts_implicitly(conn);
+
+  conn.set_deferred_begin(true);
+  test_subtransaction_commits_if_commit_called(conn);
+  test_subtransaction_aborts_if_abort_called(conn);
+  test_subtransaction_aborts_implicitly(conn);
+  test_deferred_subtransactions_isolate_failures(conn);
+  conn.set_deferred_begin(false);
 }
 }
 
@@ -0,0 +1,56 @@
+#include <cstring>
+
+#include <test_helpers.hxx>
+
+using namespace std;
+using namespace pqxx;
+
+namespace
+{
+void test_unescape_bytea_hex(transaction_base &)
+{
+  unsigned char buf[20];
+  PQXX_CHECK_EQUAL(
+	unescape_bytea_hex("\\x", 2, buf),
+	size_t(0),
+	"Empty hex bytea decoded to nonempty value.");
+
+  // Enough bytes to exercise both the unrolled loop and the tail.
+  const char text[] = "\\x00ff7A0b10203040a5";
+  const unsigned char expected[] =
+	{ 0x00, 0xff, 0x7a, 0x0b, 0x10, 0x20, 0x30, 0x40, 0xa5 };
+  PQXX_CHECK_EQUAL(
+	unescape_bytea_hex(text, strlen(text), buf),
+	sizeof(expected),
+	"Wrong decoded length.");
+  PQXX_CHECK(
+	memcmp(buf, expected, sizeof(expected)) == 0,
+	"Wrong decoded data.");
+
+  // Decoding in place.
+  char inplace[sizeof(text)];
+  memcpy(inplace, text, sizeof(text));
+  unescape_bytea_hex(
+	inplace,
+	strlen(inplace),
+	reinterpret_cast<unsigned char *>(inplace));
+  PQXX_CHECK(
+	memcmp(inplace, expected, sizeof(expected)) == 0,
+	"In-place decoding went wrong.");
+
+  PQXX_CHECK_THROWS(
+	unescape_bytea_hex("ab", 2, buf),
+	argument_error,
+	"Missing hex prefix went unnoticed.");
+  PQXX_CHECK_THROWS(
+	unescape_bytea_hex("\\x0", 3, buf),
+	argument_error,
+	"Odd number of hex digits went unnoticed.");
+  PQXX_CHECK_THROWS(
+	unescape_bytea_hex("\\x0123456g", 10, buf),
+	argument_error,
+	"Bad hex digit went unnoticed.");
+}
+} // namespace
+
+PQXX_REGISTER_TEST_NODB(test_unescape_bytea_hex)
@@ -0,0 +1,125 @@
+// Benchmark: per-field overhead of the ways to iterate over a result.
+//
+// Usage: pqxxiterbench [rows [columns]]
+//
+// Needs a running PostgreSQL server: connects to the default database (set
+// PGHOST, PGDATABASE etc. to choose another), and runs a generate_series()
+// query there that returns rows x columns small integers (by default,
+// 1000000 x 10).  Once the whole result is in client memory, it reads every
+// field through result and row iterators, through indexing, and through a
+// row_scanner, and prints the CPU time per field for each.  Only the reading
+// is timed, not the query.
+//
+// To reproduce the default run from a build tree: tools/pqxxiterbench
+//
+// Results depend on compiler, optimisation flags, and CPU; compare the three
+// methods within one run, not numbers from different machines.
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+
+#include "pqxx/pqxx"
+
+using namespace pqxx;
+
+namespace
+{
+// Checksum of everything we read, so the compiler can't optimise it away.
+unsigned long checksum = 0;
+
+
+void read_field(const char *Value, field::size_type Len)
+{
+  checksum += Len;
+  if (Len) checksum += static_cast<unsigned char>(Value[0]);
+}
+
+
+void iterators(const result &R)
+{
+  for (result::const_iterator r = R.begin(); r != R.end(); ++r)
+    for (row::const_iterator f = r->begin(); f != r->end(); ++f)
+      read_field(f->c_str(), f->size());
+}
+
+
+void indexing(const result &R)
+{
+  const result::size_type rows = R.size();
+  const row::size_type cols = R.columns();
+  for (result::size_type r = 0; r < rows; ++r)
+    for (row::size_type c = 0; c < cols; ++c)
+    {
+      const field f = R[r][c];
+      read_field(f.c_str(), f.size());
+    }
+}
+
+
+void scanner(const result &R)
+{
+  row_scanner s(R);
+  const row::size_type cols = s.columns();
+  while (s.next())
+  {
+    const char *const *v = s.values();
+    const int *len = s.lengths();
+    for (row::size_type c = 0; c < cols; ++c)
+      read_field(v[c], (len[c] < 0) ? 0 : field::size_type(len[c]));
+  }
+}
+
+
+void run(const char Name[], void (*Func)(const result &), const result &R)
+{
+  const std::clock_t start = std::clock();
+  Func(R);
+  const double secs = double(std::clock() - start) / CLOCKS_PER_SEC;
+  const double fields = double(R.size()) * double(R.columns());
+  std::cout << std::setw(12) << Name << ": "
+	<< std::fixed << std::setprecision(3) << secs << " s, "
+	<< std::setprecision(2) << (fields ? secs * 1e9 / fields : 0.0)
+	<< " ns/field" << std::endl;
+}
+} // namespace
+
+
+int main(int argc, char *argv[])
+{
+  try
+  {
+    const long rows = (argc > 1) ? std::atol(argv[1]) : 1000000;
+    const int cols = (argc > 2) ? std::atoi(argv[2]) : 10;
+    if (rows < 0 || cols < 1)
+    {
+      std::cerr << "Usage: " << argv[0] << " [rows [columns]]" << std::endl;
+      return 2;
+    }
+
+    std::string query = "SELECT ";
+    for (int c = 0; c < cols; ++c)
+    {
+      if (c) query += ", ";
+      query += "n + " + to_string(c);
+    }
+    query += " FROM generate_series(1, " + to_string(rows) + ") AS n";
+
+    connection C;
+    nontransaction T(C);
+    const result R = T.exec(query);
+    std::cout << R.size() << " rows x " << R.columns() << " columns"
+	<< std::endl;
+
+    run("iterators", iterators, R);
+    run("indexing", indexing, R);
+    run("row_scanner", scanner, R);
+    std::cout << "(checksum " << checksum << ")" << std::endl;
+  }
+  catch (const std::exception &e)
+  {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
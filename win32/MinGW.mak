@@ -19,6 +19,9 @@ include win32/common
 CXX = g++.exe
 
 OBJ = \
+  src/arrow.o \
+  src/async_query.o \
+  src/batch_loader.o \
   src/binarystring.o \
   src/connection.o \
   src/connection_base.o \
@@ -28,13 +31,21 @@ OBJ = \
   src/except.o \
   src/field.o \
   src/largeobject.o \
+  src/mapped_result.o \
   src/nontransaction.o \
   src/notification.o \
+  src/parallel_exporter.o \
+  src/parallel_largeobject.o \
+  src/parallel_loader.o \
   src/pipeline.o \
   src/prepared_statement.o \
   src/result.o \
+  src/result_cache.o \
+  src/retry_policy.o \
   src/robusttransaction.o \
   src/row.o \
+  src/row_mapping.o \
+  src/row_scanner.o \
   src/statement_parameters.o \
   src/strconv.o \
   src/subtransaction.o \
@@ -68,6 +79,15 @@ STATICLIB=libpqxx.a
 $(BIN): $(OBJ)
 	$(DLLWRAP) --output-def $(DEFFILE) --driver-name c++ --implib $(STATICLIB) $(OBJ) $(LDFLAGS) $(LIBS) -o $(BIN)
 
+src/arrow.o: src/arrow.cxx
+	$(CXX) $(CPPFLAGS) -c src/arrow.cxx -o src/arrow.o $(CXXFLAGS)
+
+src/async_query.o: src/async_query.cxx
+	$(CXX) $(CPPFLAGS) -c src/async_query.cxx -o src/async_query.o $(CXXFLAGS)
+
+src/batch_loader.o: src/batch_loader.cxx
+	$(CXX) $(CPPFLAGS) -c src/batch_loader.cxx -o src/batch_loader.o $(CXXFLAGS)
+
 src/binarystring.o: src/binarystring.cxx
 	$(CXX) $(CPPFLAGS) -c src/binarystring.cxx -o src/binarystring.o $(CXXFLAGS)
 
@@ -95,12 +115,24 @@ src/field.o: src/field.cxx
 src/largeobject.o: src/largeobject.cxx
 	$(CXX) $(CPPFLAGS) -c src/largeobject.cxx -o src/largeobject.o $(CXXFLAGS)
 
+src/mapped_result.o: src/mapped_result.cxx
+	$(CXX) $(CPPFLAGS) -c src/mapped_result.cxx -o src/mapped_result.o $(CXXFLAGS)
+
 src/nontransaction.o: src/nontransaction.cxx
 	$(CXX) $(CPPFLAGS) -c src/nontransaction.cxx -o src/nontransaction.o $(CXXFLAGS)
 
 src/notification.o: src/notification.cxx
 	$(CXX) $(CPPFLAGS) -c src/notification.cxx -o src/notification.o $(CXXFLAGS)
 
+src/parallel_exporter.o: src/parallel_exporter.cxx
+	$(CXX) $(CPPFLAGS) -c src/parallel_exporter.cxx -o src/parallel_exporter.o $(CXXFLAGS)
+
+src/parallel_largeobject.o: src/parallel_largeobject.cxx
+	$(CXX) $(CPPFLAGS) -c src/parallel_largeobject.cxx -o src/parallel_largeobject.o $(CXXFLAGS)
+
+src/parallel_loader.o: src/parallel_loader.cxx
+	$(CXX) $(CPPFLAGS) -c src/parallel_loader.cxx -o src/parallel_loader.o $(CXXFLAGS)
+
 src/pipeline.o: src/pipeline.cxx
 	$(CXX) $(CPPFLAGS) -c src/pipeline.cxx -o src/pipeline.o $(CXXFLAGS)
 
@@ -110,12 +142,24 @@ src/prepared_statement.o: src/prepared_statement.cxx
 src/result.o: src/result.cxx
 	$(CXX) $(CPPFLAGS) -c src/result.cxx -o src/result.o $(CXXFLAGS)
 
+src/result_cache.o: src/result_cache.cxx
+	$(CXX) $(CPPFLAGS) -c src/result_cache.cxx -o src/result_cache.o $(CXXFLAGS)
+
+src/retry_policy.o: src/retry_policy.cxx
+	$(CXX) $(CPPFLAGS) -c src/retry_policy.cxx -o src/retry_policy.o $(CXXFLAGS)
+
 src/robusttransaction.o: src/robusttransaction.cxx
 	$(CXX) $(CPPFLAGS) -c src/robusttransaction.cxx -o src/robusttransaction.o $(CXXFLAGS)
 
 src/row.o: src/row.cxx
 	$(CXX) $(CPPFLAGS) -c src/row.cxx -o src/row.o $(CXXFLAGS)
 
+src/row_mapping.o: src/row_mapping.cxx
+	$(CXX) $(CPPFLAGS) -c src/row_mapping.cxx -o src/row_mapping.o $(CXXFLAGS)
+
+src/row_scanner.o: src/row_scanner.cxx
+	$(CXX) $(CPPFLAGS) -c src/row_scanner.cxx -o src/row_scanner.o $(CXXFLAGS)
+
 src/statement_parameters.o: src/statement_parameters.cxx
 	$(CXX) $(CPPFLAGS) -c src/statement_parameters.cxx -o src/statement_parameters.o $(CXXFLAGS)
 
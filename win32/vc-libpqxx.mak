@@ -99,6 +99,9 @@ LIB_FLAGS=/nologo
 ########################################################
 
 OBJ_STATICDEBUG=\
+       "$(INTDIR_STATICDEBUG)\arrow.obj" \
+       "$(INTDIR_STATICDEBUG)\async_query.obj" \
+       "$(INTDIR_STATICDEBUG)\batch_loader.obj" \
        "$(INTDIR_STATICDEBUG)\binarystring.obj" \
        "$(INTDIR_STATICDEBUG)\connection.obj" \
        "$(INTDIR_STATICDEBUG)\connection_base.obj" \
@@ -108,13 +111,21 @@ OBJ_STATICDEBUG=\
        "$(INTDIR_STATICDEBUG)\except.obj" \
        "$(INTDIR_STATICDEBUG)\field.obj" \
        "$(INTDIR_STATICDEBUG)\largeobject.obj" \
+       "$(INTDIR_STATICDEBUG)\mapped_result.obj" \
        "$(INTDIR_STATICDEBUG)\nontransaction.obj" \
        "$(INTDIR_STATICDEBUG)\notification.obj" \
+       "$(INTDIR_STATICDEBUG)\parallel_exporter.obj" \
+       "$(INTDIR_STATICDEBUG)\parallel_largeobject.obj" \
+       "$(INTDIR_STATICDEBUG)\parallel_loader.obj" \
        "$(INTDIR_STATICDEBUG)\pipeline.obj" \
        "$(INTDIR_STATICDEBUG)\prepared_statement.obj" \
        "$(INTDIR_STATICDEBUG)\result.obj" \
+       "$(INTDIR_STATICDEBUG)\result_cache.obj" \
+       "$(INTDIR_STATICDEBUG)\retry_policy.obj" \
        "$(INTDIR_STATICDEBUG)\robusttransaction.obj" \
        "$(INTDIR_STATICDEBUG)\row.obj" \
+       "$(INTDIR_STATICDEBUG)\row_mapping.obj" \
+       "$(INTDIR_STATICDEBUG)\row_scanner.obj" \
        "$(INTDIR_STATICDEBUG)\statement_parameters.obj" \
        "$(INTDIR_STATICDEBUG)\strconv.obj" \
        "$(INTDIR_STATICDEBUG)\subtransaction.obj" \
@@ -126,6 +137,9 @@ OBJ_STATICDEBUG=\
        "$(INTDIR_STATICDEBUG)\util.obj" \
 
 OBJ_STATICRELEASE=\
+       "$(INTDIR_STATICRELEASE)\arrow.obj" \
+       "$(INTDIR_STATICRELEASE)\async_query.obj" \
+       "$(INTDIR_STATICRELEASE)\batch_loader.obj" \
        "$(INTDIR_STATICRELEASE)\binarystring.obj" \
        "$(INTDIR_STATICRELEASE)\connection.obj" \
        "$(INTDIR_STATICRELEASE)\connection_base.obj" \
@@ -135,13 +149,21 @@ OBJ_STATICRELEASE=\
        "$(INTDIR_STATICRELEASE)\except.obj" \
        "$(INTDIR_STATICRELEASE)\field.obj" \
        "$(INTDIR_STATICRELEASE)\largeobject.obj" \
+       "$(INTDIR_STATICRELEASE)\mapped_result.obj" \
        "$(INTDIR_STATICRELEASE)\nontransaction.obj" \
        "$(INTDIR_STATICRELEASE)\notification.obj" \
+       "$(INTDIR_STATICRELEASE)\parallel_exporter.obj" \
+       "$(INTDIR_STATICRELEASE)\parallel_largeobject.obj" \
+       "$(INTDIR_STATICRELEASE)\parallel_loader.obj" \
        "$(INTDIR_STATICRELEASE)\pipeline.obj" \
        "$(INTDIR_STATICRELEASE)\prepared_statement.obj" \
        "$(INTDIR_STATICRELEASE)\result.obj" \
+       "$(INTDIR_STATICRELEASE)\result_cache.obj" \
+       "$(INTDIR_STATICRELEASE)\retry_policy.obj" \
        "$(INTDIR_STATICRELEASE)\robusttransaction.obj" \
        "$(INTDIR_STATICRELEASE)\row.obj" \
+       "$(INTDIR_STATICRELEASE)\row_mapping.obj" \
+       "$(INTDIR_STATICRELEASE)\row_scanner.obj" \
        "$(INTDIR_STATICRELEASE)\statement_parameters.obj" \
        "$(INTDIR_STATICRELEASE)\strconv.obj" \
        "$(INTDIR_STATICRELEASE)\subtransaction.obj" \
@@ -153,6 +175,9 @@ OBJ_STATICRELEASE=\
        "$(INTDIR_STATICRELEASE)\util.obj" \
 
 OBJ_DLLDEBUG=\
+       "$(INTDIR_DLLDEBUG)\arrow.obj" \
+       "$(INTDIR_DLLDEBUG)\async_query.obj" \
+       "$(INTDIR_DLLDEBUG)\batch_loader.obj" \
        "$(INTDIR_DLLDEBUG)\binarystring.obj" \
        "$(INTDIR_DLLDEBUG)\connection.obj" \
        "$(INTDIR_DLLDEBUG)\connection_base.obj" \
@@ -162,13 +187,21 @@ OBJ_DLLDEBUG=\
        "$(INTDIR_DLLDEBUG)\except.obj" \
        "$(INTDIR_DLLDEBUG)\field.obj" \
        "$(INTDIR_DLLDEBUG)\largeobject.obj" \
+       "$(INTDIR_DLLDEBUG)\mapped_result.obj" \
        "$(INTDIR_DLLDEBUG)\nontransaction.obj" \
        "$(INTDIR_DLLDEBUG)\notification.obj" \
+       "$(INTDIR_DLLDEBUG)\parallel_exporter.obj" \
+       "$(INTDIR_DLLDEBUG)\parallel_largeobject.obj" \
+       "$(INTDIR_DLLDEBUG)\parallel_loader.obj" \
        "$(INTDIR_DLLDEBUG)\pipeline.obj" \
        "$(INTDIR_DLLDEBUG)\prepared_statement.obj" \
        "$(INTDIR_DLLDEBUG)\result.obj" \
+       "$(INTDIR_DLLDEBUG)\result_cache.obj" \
+       "$(INTDIR_DLLDEBUG)\retry_policy.obj" \
        "$(INTDIR_DLLDEBUG)\robusttransaction.obj" \
        "$(INTDIR_DLLDEBUG)\row.obj" \
+       "$(INTDIR_DLLDEBUG)\row_mapping.obj" \
+       "$(INTDIR_DLLDEBUG)\row_scanner.obj" \
        "$(INTDIR_DLLDEBUG)\statement_parameters.obj" \
        "$(INTDIR_DLLDEBUG)\strconv.obj" \
        "$(INTDIR_DLLDEBUG)\subtransaction.obj" \
@@ -181,6 +214,9 @@ OBJ_DLLDEBUG=\
        "$(INTDIR_DLLDEBUG)\libpqxx.obj" \
 
 OBJ_DLLRELEASE=\
+       "$(INTDIR_DLLRELEASE)\arrow.obj" \
+       "$(INTDIR_DLLRELEASE)\async_query.obj" \
+       "$(INTDIR_DLLRELEASE)\batch_loader.obj" \
        "$(INTDIR_DLLRELEASE)\binarystring.obj" \
        "$(INTDIR_DLLRELEASE)\connection.obj" \
        "$(INTDIR_DLLRELEASE)\connection_base.obj" \
@@ -190,13 +226,21 @@ OBJ_DLLRELEASE=\
        "$(INTDIR_DLLRELEASE)\except.obj" \
        "$(INTDIR_DLLRELEASE)\field.obj" \
        "$(INTDIR_DLLRELEASE)\largeobject.obj" \
+       "$(INTDIR_DLLRELEASE)\mapped_result.obj" \
        "$(INTDIR_DLLRELEASE)\nontransaction.obj" \
        "$(INTDIR_DLLRELEASE)\notification.obj" \
+       "$(INTDIR_DLLRELEASE)\parallel_exporter.obj" \
+       "$(INTDIR_DLLRELEASE)\parallel_largeobject.obj" \
+       "$(INTDIR_DLLRELEASE)\parallel_loader.obj" \
        "$(INTDIR_DLLRELEASE)\pipeline.obj" \
        "$(INTDIR_DLLRELEASE)\prepared_statement.obj" \
        "$(INTDIR_DLLRELEASE)\result.obj" \
+       "$(INTDIR_DLLRELEASE)\result_cache.obj" \
+       "$(INTDIR_DLLRELEASE)\retry_policy.obj" \
        "$(INTDIR_DLLRELEASE)\robusttransaction.obj" \
        "$(INTDIR_DLLRELEASE)\row.obj" \
+       "$(INTDIR_DLLRELEASE)\row_mapping.obj" \
+       "$(INTDIR_DLLRELEASE)\row_scanner.obj" \
        "$(INTDIR_DLLRELEASE)\statement_parameters.obj" \
        "$(INTDIR_DLLRELEASE)\strconv.obj" \
        "$(INTDIR_DLLRELEASE)\subtransaction.obj" \
@@ -308,6 +352,27 @@ $(INTDIR_DLLRELEASE)::
 
 
 
+"$(INTDIR_STATICRELEASE)\arrow.obj": src/arrow.cxx $(INTDIR_STATICRELEASE)
+	$(CXX) $(CXX_FLAGS_STATICRELEASE) /Fo"$(INTDIR_STATICRELEASE)\\" /Fd"$(INTDIR_STATICRELEASE)\\" src/arrow.cxx
+
+"$(INTDIR_STATICDEBUG)\arrow.obj": src/arrow.cxx $(INTDIR_STATICDEBUG)
+	$(CXX) $(CXX_FLAGS_STATICDEBUG) /Fo"$(INTDIR_STATICDEBUG)\\" /Fd"$(INTDIR_STATICDEBUG)\\" src/arrow.cxx
+
+
+"$(INTDIR_STATICRELEASE)\async_query.obj": src/async_query.cxx $(INTDIR_STATICRELEASE)
+	$(CXX) $(CXX_FLAGS_STATICRELEASE) /Fo"$(INTDIR_STATICRELEASE)\\" /Fd"$(INTDIR_STATICRELEASE)\\" src/async_query.cxx
+
+"$(INTDIR_STATICDEBUG)\async_query.obj": src/async_query.cxx $(INTDIR_STATICDEBUG)
+	$(CXX) $(CXX_FLAGS_STATICDEBUG) /Fo"$(INTDIR_STATICDEBUG)\\" /Fd"$(INTDIR_STATICDEBUG)\\" src/async_query.cxx
+
+
+"$(INTDIR_STATICRELEASE)\batch_loader.obj": src/batch_loader.cxx $(INTDIR_STATICRELEASE)
+	$(CXX) $(CXX_FLAGS_STATICRELEASE) /Fo"$(INTDIR_STATICRELEASE)\\" /Fd"$(INTDIR_STATICRELEASE)\\" src/batch_loader.cxx
+
+"$(INTDIR_STATICDEBUG)\batch_loader.obj": src/batch_loader.cxx $(INTDIR_STATICDEBUG)
+	$(CXX) $(CXX_FLAGS_STATICDEBUG) /Fo"$(INTDIR_STATICDEBUG)\\" /Fd"$(INTDIR_STATICDEBUG)\\" src/batch_loader.cxx
+
+
 "$(INTDIR_STATICRELEASE)\binarystring.obj": src/binarystring.cxx $(INTDIR_STATICRELEASE)
 	$(CXX) $(CXX_FLAGS_STATICRELEASE) /Fo"$(INTDIR_STATICRELEASE)\\" /Fd"$(INTDIR_STATICRELEASE)\\" src/binarystring.cxx
 
@@ -371,6 +436,13 @@ $(INTDIR_DLLRELEASE)::
 	$(CXX) $(CXX_FLAGS_STATICDEBUG) /Fo"$(INTDIR_STATICDEBUG)\\" /Fd"$(INTDIR_STATICDEBUG)\\" src/largeobject.cxx
 
 
+"$(INTDIR_STATICRELEASE)\mapped_result.obj": src/mapped_result.cxx $(INTDIR_STATICRELEASE)
+	$(CXX) $(CXX_FLAGS_STATICRELEASE) /Fo"$(INTDIR_STATICRELEASE)\\" /Fd"$(INTDIR_STATICRELEASE)\\" src/mapped_result.cxx
+
+"$(INTDIR_STATICDEBUG)\mapped_result.obj": src/mapped_result.cxx $(INTDIR_STATICDEBUG)
+	$(CXX) $(CXX_FLAGS_STATICDEBUG) /Fo"$(INTDIR_STATICDEBUG)\\" /Fd"$(INTDIR_STATICDEBUG)\\" src/mapped_result.cxx
+
+
 "$(INTDIR_STATICRELEASE)\nontransaction.obj": src/nontransaction.cxx $(INTDIR_STATICRELEASE)
 	$(CXX) $(CXX_FLAGS_STATICRELEASE) /Fo"$(INTDIR_STATICRELEASE)\\" /Fd"$(INTDIR_STATICRELEASE)\\" src/nontransaction.cxx
 
@@ -385,6 +457,27 @@ $(INTDIR_DLLRELEASE)::
 	$(CXX) $(CXX_FLAGS_STATICDEBUG) /Fo"$(INTDIR_STATICDEBUG)\\" /Fd"$(INTDIR_STATICDEBUG)\\" src/notification.cxx
 
 
+"$(INTDIR_STATICRELEASE)\parallel_exporter.obj": src/parallel_exporter.cxx $(INTDIR_STATICRELEASE)
+	$(CXX) $(CXX_FLAGS_STATICRELEASE) /Fo"$(INTDIR_STATICRELEASE)\\" /Fd"$(INTDIR_STATICRELEASE)\\" src/parallel_exporter.cxx
+
+"$(INTDIR_STATICDEBUG)\parallel_exporter.obj": src/parallel_exporter.cxx $(INTDIR_STATICDEBUG)
+	$(CXX) $(CXX_FLAGS_STATICDEBUG) /Fo"$(INTDIR_STATICDEBUG)\\" /Fd"$(INTDIR_STATICDEBUG)\\" src/parallel_exporter.cxx
+
+
+"$(INTDIR_STATICRELEASE)\parallel_largeobject.obj": src/parallel_largeobject.cxx $(INTDIR_STATICRELEASE)
+	$(CXX) $(CXX_FLAGS_STATICRELEASE) /Fo"$(INTDIR_STATICRELEASE)\\" /Fd"$(INTDIR_STATICRELEASE)\\" src/parallel_largeobject.cxx
+
+"$(INTDIR_STATICDEBUG)\parallel_largeobject.obj": src/parallel_largeobject.cxx $(INTDIR_STATICDEBUG)
+	$(CXX) $(CXX_FLAGS_STATICDEBUG) /Fo"$(INTDIR_STATICDEBUG)\\" /Fd"$(INTDIR_STATICDEBUG)\\" src/parallel_largeobject.cxx
+
+
+"$(INTDIR_STATICRELEASE)\parallel_loader.obj": src/parallel_loader.cxx $(INTDIR_STATICRELEASE)
+	$(CXX) $(CXX_FLAGS_STATICRELEASE) /Fo"$(INTDIR_STATICRELEASE)\\" /Fd"$(INTDIR_STATICRELEASE)\\" src/parallel_loader.cxx
+
+"$(INTDIR_STATICDEBUG)\parallel_loader.obj": src/parallel_loader.cxx $(INTDIR_STATICDEBUG)
+	$(CXX) $(CXX_FLAGS_STATICDEBUG) /Fo"$(INTDIR_STATICDEBUG)\\" /Fd"$(INTDIR_STATICDEBUG)\\" src/parallel_loader.cxx
+
+
 "$(INTDIR_STATICRELEASE)\pipeline.obj": src/pipeline.cxx $(INTDIR_STATICRELEASE)
 	$(CXX) $(CXX_FLAGS_STATICRELEASE) /Fo"$(INTDIR_STATICRELEASE)\\" /Fd"$(INTDIR_STATICRELEASE)\\" src/pipeline.cxx
 
@@ -406,6 +499,20 @@ $(INTDIR_DLLRELEASE)::
 	$(CXX) $(CXX_FLAGS_STATICDEBUG) /Fo"$(INTDIR_STATICDEBUG)\\" /Fd"$(INTDIR_STATICDEBUG)\\" src/result.cxx
 
 
+"$(INTDIR_STATICRELEASE)\result_cache.obj": src/result_cache.cxx $(INTDIR_STATICRELEASE)
+	$(CXX) $(CXX_FLAGS_STATICRELEASE) /Fo"$(INTDIR_STATICRELEASE)\\" /Fd"$(INTDIR_STATICRELEASE)\\" src/result_cache.cxx
+
+"$(INTDIR_STATICDEBUG)\result_cache.obj": src/result_cache.cxx $(INTDIR_STATICDEBUG)
+	$(CXX) $(CXX_FLAGS_STATICDEBUG) /Fo"$(INTDIR_STATICDEBUG)\\" /Fd"$(INTDIR_STATICDEBUG)\\" src/result_cache.cxx
+
+
+"$(INTDIR_STATICRELEASE)\retry_policy.obj": src/retry_policy.cxx $(INTDIR_STATICRELEASE)
+	$(CXX) $(CXX_FLAGS_STATICRELEASE) /Fo"$(INTDIR_STATICRELEASE)\\" /Fd"$(INTDIR_STATICRELEASE)\\" src/retry_policy.cxx
+
+"$(INTDIR_STATICDEBUG)\retry_policy.obj": src/retry_policy.cxx $(INTDIR_STATICDEBUG)
+	$(CXX) $(CXX_FLAGS_STATICDEBUG) /Fo"$(INTDIR_STATICDEBUG)\\" /Fd"$(INTDIR_STATICDEBUG)\\" src/retry_policy.cxx
+
+
 "$(INTDIR_STATICRELEASE)\robusttransaction.obj": src/robusttransaction.cxx $(INTDIR_STATICRELEASE)
 	$(CXX) $(CXX_FLAGS_STATICRELEASE) /Fo"$(INTDIR_STATICRELEASE)\\" /Fd"$(INTDIR_STATICRELEASE)\\" src/robusttransaction.cxx
 
@@ -420,6 +527,20 @@ $(INTDIR_DLLRELEASE)::
 	$(CXX) $(CXX_FLAGS_STATICDEBUG) /Fo"$(INTDIR_STATICDEBUG)\\" /Fd"$(INTDIR_STATICDEBUG)\\" src/row.cxx
 
 
+"$(INTDIR_STATICRELEASE)\row_mapping.obj": src/row_mapping.cxx $(INTDIR_STATICRELEASE)
+	$(CXX) $(CXX_FLAGS_STATICRELEASE) /Fo"$(INTDIR_STATICRELEASE)\\" /Fd"$(INTDIR_STATICRELEASE)\\" src/row_mapping.cxx
+
+"$(INTDIR_STATICDEBUG)\row_mapping.obj": src/row_mapping.cxx $(INTDIR_STATICDEBUG)
+	$(CXX) $(CXX_FLAGS_STATICDEBUG) /Fo"$(INTDIR_STATICDEBUG)\\" /Fd"$(INTDIR_STATICDEBUG)\\" src/row_mapping.cxx
+
+
+"$(INTDIR_STATICRELEASE)\row_scanner.obj": src/row_scanner.cxx $(INTDIR_STATICRELEASE)
+	$(CXX) $(CXX_FLAGS_STATICRELEASE) /Fo"$(INTDIR_STATICRELEASE)\\" /Fd"$(INTDIR_STATICRELEASE)\\" src/row_scanner.cxx
+
+"$(INTDIR_STATICDEBUG)\row_scanner.obj": src/row_scanner.cxx $(INTDIR_STATICDEBUG)
+	$(CXX) $(CXX_FLAGS_STATICDEBUG) /Fo"$(INTDIR_STATICDEBUG)\\" /Fd"$(INTDIR_STATICDEBUG)\\" src/row_scanner.cxx
+
+
 "$(INTDIR_STATICRELEASE)\statement_parameters.obj": src/statement_parameters.cxx $(INTDIR_STATICRELEASE)
 	$(CXX) $(CXX_FLAGS_STATICRELEASE) /Fo"$(INTDIR_STATICRELEASE)\\" /Fd"$(INTDIR_STATICRELEASE)\\" src/statement_parameters.cxx
 
@@ -485,6 +606,27 @@ $(INTDIR_DLLRELEASE)::
 
 
 
+"$(INTDIR_DLLRELEASE)\arrow.obj": src/arrow.cxx $(INTDIR_DLLRELEASE)
+	$(CXX) $(CXX_FLAGS_DLLRELEASE) /Fo"$(INTDIR_DLLRELEASE)\\" /Fd"$(INTDIR_DLLRELEASE)\\" src/arrow.cxx
+
+"$(INTDIR_DLLDEBUG)\arrow.obj": src/arrow.cxx $(INTDIR_DLLDEBUG)
+	$(CXX) $(CXX_FLAGS_DLLDEBUG) /Fo"$(INTDIR_DLLDEBUG)\\" /Fd"$(INTDIR_DLLDEBUG)\\" src/arrow.cxx
+
+
+"$(INTDIR_DLLRELEASE)\async_query.obj": src/async_query.cxx $(INTDIR_DLLRELEASE)
+	$(CXX) $(CXX_FLAGS_DLLRELEASE) /Fo"$(INTDIR_DLLRELEASE)\\" /Fd"$(INTDIR_DLLRELEASE)\\" src/async_query.cxx
+
+"$(INTDIR_DLLDEBUG)\async_query.obj": src/async_query.cxx $(INTDIR_DLLDEBUG)
+	$(CXX) $(CXX_FLAGS_DLLDEBUG) /Fo"$(INTDIR_DLLDEBUG)\\" /Fd"$(INTDIR_DLLDEBUG)\\" src/async_query.cxx
+
+
+"$(INTDIR_DLLRELEASE)\batch_loader.obj": src/batch_loader.cxx $(INTDIR_DLLRELEASE)
+	$(CXX) $(CXX_FLAGS_DLLRELEASE) /Fo"$(INTDIR_DLLRELEASE)\\" /Fd"$(INTDIR_DLLRELEASE)\\" src/batch_loader.cxx
+
+"$(INTDIR_DLLDEBUG)\batch_loader.obj": src/batch_loader.cxx $(INTDIR_DLLDEBUG)
+	$(CXX) $(CXX_FLAGS_DLLDEBUG) /Fo"$(INTDIR_DLLDEBUG)\\" /Fd"$(INTDIR_DLLDEBUG)\\" src/batch_loader.cxx
+
+
 "$(INTDIR_DLLRELEASE)\binarystring.obj": src/binarystring.cxx $(INTDIR_DLLRELEASE)
 	$(CXX) $(CXX_FLAGS_DLLRELEASE) /Fo"$(INTDIR_DLLRELEASE)\\" /Fd"$(INTDIR_DLLRELEASE)\\" src/binarystring.cxx
 
@@ -548,6 +690,13 @@ $(INTDIR_DLLRELEASE)::
 	$(CXX) $(CXX_FLAGS_DLLDEBUG) /Fo"$(INTDIR_DLLDEBUG)\\" /Fd"$(INTDIR_DLLDEBUG)\\" src/largeobject.cxx
 
 
+"$(INTDIR_DLLRELEASE)\mapped_result.obj": src/mapped_result.cxx $(INTDIR_DLLRELEASE)
+	$(CXX) $(CXX_FLAGS_DLLRELEASE) /Fo"$(INTDIR_DLLRELEASE)\\" /Fd"$(INTDIR_DLLRELEASE)\\" src/mapped_result.cxx
+
+"$(INTDIR_DLLDEBUG)\mapped_result.obj": src/mapped_result.cxx $(INTDIR_DLLDEBUG)
+	$(CXX) $(CXX_FLAGS_DLLDEBUG) /Fo"$(INTDIR_DLLDEBUG)\\" /Fd"$(INTDIR_DLLDEBUG)\\" src/mapped_result.cxx
+
+
 "$(INTDIR_DLLRELEASE)\nontransaction.obj": src/nontransaction.cxx $(INTDIR_DLLRELEASE)
 	$(CXX) $(CXX_FLAGS_DLLRELEASE) /Fo"$(INTDIR_DLLRELEASE)\\" /Fd"$(INTDIR_DLLRELEASE)\\" src/nontransaction.cxx
 
@@ -562,6 +711,27 @@ $(INTDIR_DLLRELEASE)::
 	$(CXX) $(CXX_FLAGS_DLLDEBUG) /Fo"$(INTDIR_DLLDEBUG)\\" /Fd"$(INTDIR_DLLDEBUG)\\" src/notification.cxx
 
 
+"$(INTDIR_DLLRELEASE)\parallel_exporter.obj": src/parallel_exporter.cxx $(INTDIR_DLLRELEASE)
+	$(CXX) $(CXX_FLAGS_DLLRELEASE) /Fo"$(INTDIR_DLLRELEASE)\\" /Fd"$(INTDIR_DLLRELEASE)\\" src/parallel_exporter.cxx
+
+"$(INTDIR_DLLDEBUG)\parallel_exporter.obj": src/parallel_exporter.cxx $(INTDIR_DLLDEBUG)
+	$(CXX) $(CXX_FLAGS_DLLDEBUG) /Fo"$(INTDIR_DLLDEBUG)\\" /Fd"$(INTDIR_DLLDEBUG)\\" src/parallel_exporter.cxx
+
+
+"$(INTDIR_DLLRELEASE)\parallel_largeobject.obj": src/parallel_largeobject.cxx $(INTDIR_DLLRELEASE)
+	$(CXX) $(CXX_FLAGS_DLLRELEASE) /Fo"$(INTDIR_DLLRELEASE)\\" /Fd"$(INTDIR_DLLRELEASE)\\" src/parallel_largeobject.cxx
+
+"$(INTDIR_DLLDEBUG)\parallel_largeobject.obj": src/parallel_largeobject.cxx $(INTDIR_DLLDEBUG)
+	$(CXX) $(CXX_FLAGS_DLLDEBUG) /Fo"$(INTDIR_DLLDEBUG)\\" /Fd"$(INTDIR_DLLDEBUG)\\" src/parallel_largeobject.cxx
+
+
+"$(INTDIR_DLLRELEASE)\parallel_loader.obj": src/parallel_loader.cxx $(INTDIR_DLLRELEASE)
+	$(CXX) $(CXX_FLAGS_DLLRELEASE) /Fo"$(INTDIR_DLLRELEASE)\\" /Fd"$(INTDIR_DLLRELEASE)\\" src/parallel_loader.cxx
+
+"$(INTDIR_DLLDEBUG)\parallel_loader.obj": src/parallel_loader.cxx $(INTDIR_DLLDEBUG)
+	$(CXX) $(CXX_FLAGS_DLLDEBUG) /Fo"$(INTDIR_DLLDEBUG)\\" /Fd"$(INTDIR_DLLDEBUG)\\" src/parallel_loader.cxx
+
+
 "$(INTDIR_DLLRELEASE)\pipeline.obj": src/pipeline.cxx $(INTDIR_DLLRELEASE)
 	$(CXX) $(CXX_FLAGS_DLLRELEASE) /Fo"$(INTDIR_DLLRELEASE)\\" /Fd"$(INTDIR_DLLRELEASE)\\" src/pipeline.cxx
 
@@ -583,6 +753,20 @@ $(INTDIR_DLLRELEASE)::
 	$(CXX) $(CXX_FLAGS_DLLDEBUG) /Fo"$(INTDIR_DLLDEBUG)\\" /Fd"$(INTDIR_DLLDEBUG)\\" src/result.cxx
 
 
+"$(INTDIR_DLLRELEASE)\result_cache.obj": src/result_cache.cxx $(INTDIR_DLLRELEASE)
+	$(CXX) $(CXX_FLAGS_DLLRELEASE) /Fo"$(INTDIR_DLLRELEASE)\\" /Fd"$(INTDIR_DLLRELEASE)\\" src/result_cache.cxx
+
+"$(INTDIR_DLLDEBUG)\result_cache.obj": src/result_cache.cxx $(INTDIR_DLLDEBUG)
+	$(CXX) $(CXX_FLAGS_DLLDEBUG) /Fo"$(INTDIR_DLLDEBUG)\\" /Fd"$(INTDIR_DLLDEBUG)\\" src/result_cache.cxx
+
+
+"$(INTDIR_DLLRELEASE)\retry_policy.obj": src/retry_policy.cxx $(INTDIR_DLLRELEASE)
+	$(CXX) $(CXX_FLAGS_DLLRELEASE) /Fo"$(INTDIR_DLLRELEASE)\\" /Fd"$(INTDIR_DLLRELEASE)\\" src/retry_policy.cxx
+
+"$(INTDIR_DLLDEBUG)\retry_policy.obj": src/retry_policy.cxx $(INTDIR_DLLDEBUG)
+	$(CXX) $(CXX_FLAGS_DLLDEBUG) /Fo"$(INTDIR_DLLDEBUG)\\" /Fd"$(INTDIR_DLLDEBUG)\\" src/retry_policy.cxx
+
+
 "$(INTDIR_DLLRELEASE)\robusttransaction.obj": src/robusttransaction.cxx $(INTDIR_DLLRELEASE)
 	$(CXX) $(CXX_FLAGS_DLLRELEASE) /Fo"$(INTDIR_DLLRELEASE)\\" /Fd"$(INTDIR_DLLRELEASE)\\" src/robusttransaction.cxx
 
@@ -597,6 +781,20 @@ $(INTDIR_DLLRELEASE)::
 	$(CXX) $(CXX_FLAGS_DLLDEBUG) /Fo"$(INTDIR_DLLDEBUG)\\" /Fd"$(INTDIR_DLLDEBUG)\\" src/row.cxx
 
 
+"$(INTDIR_DLLRELEASE)\row_mapping.obj": src/row_mapping.cxx $(INTDIR_DLLRELEASE)
+	$(CXX) $(CXX_FLAGS_DLLRELEASE) /Fo"$(INTDIR_DLLRELEASE)\\" /Fd"$(INTDIR_DLLRELEASE)\\" src/row_mapping.cxx
+
+"$(INTDIR_DLLDEBUG)\row_mapping.obj": src/row_mapping.cxx $(INTDIR_DLLDEBUG)
+	$(CXX) $(CXX_FLAGS_DLLDEBUG) /Fo"$(INTDIR_DLLDEBUG)\\" /Fd"$(INTDIR_DLLDEBUG)\\" src/row_mapping.cxx
+
+
+"$(INTDIR_DLLRELEASE)\row_scanner.obj": src/row_scanner.cxx $(INTDIR_DLLRELEASE)
+	$(CXX) $(CXX_FLAGS_DLLRELEASE) /Fo"$(INTDIR_DLLRELEASE)\\" /Fd"$(INTDIR_DLLRELEASE)\\" src/row_scanner.cxx
+
+"$(INTDIR_DLLDEBUG)\row_scanner.obj": src/row_scanner.cxx $(INTDIR_DLLDEBUG)
+	$(CXX) $(CXX_FLAGS_DLLDEBUG) /Fo"$(INTDIR_DLLDEBUG)\\" /Fd"$(INTDIR_DLLDEBUG)\\" src/row_scanner.cxx
+
+
 "$(INTDIR_DLLRELEASE)\statement_parameters.obj": src/statement_parameters.cxx $(INTDIR_DLLRELEASE)
 	$(CXX) $(CXX_FLAGS_DLLRELEASE) /Fo"$(INTDIR_DLLRELEASE)\\" /Fd"$(INTDIR_DLLRELEASE)\\" src/statement_parameters.cxx
 
@@ -80,19 +80,45 @@ DLLS=$(INTDIR)\$(LIBPQ)
 !ENDIF
 
 OBJS= \
+  $(INTDIR)\test_adaptive_stride.obj \
+  $(INTDIR)\test_arrow.obj \
+  $(INTDIR)\test_async_query.obj \
+  $(INTDIR)\test_batch_loader.obj \
   $(INTDIR)\test_binarystring.obj \
   $(INTDIR)\test_cancel_query.obj \
+  $(INTDIR)\test_column.obj \
+  $(INTDIR)\test_column_lookup.obj \
+  $(INTDIR)\test_cursor_block_cache.obj \
+  $(INTDIR)\test_cursor_prefetch.obj \
+  $(INTDIR)\test_deferred_begin.obj \
   $(INTDIR)\test_error_verbosity.obj \
   $(INTDIR)\test_errorhandler.obj \
   $(INTDIR)\test_escape.obj \
   $(INTDIR)\test_exceptions.obj \
+  $(INTDIR)\test_exec_and_commit.obj \
+  $(INTDIR)\test_field_view.obj \
   $(INTDIR)\test_float.obj \
+  $(INTDIR)\test_largeobject_64.obj \
+  $(INTDIR)\test_largeobject_memory.obj \
+  $(INTDIR)\test_largeobject_stream.obj \
+  $(INTDIR)\test_mapped_result.obj \
+  $(INTDIR)\test_nonblocking_copy.obj \
   $(INTDIR)\test_notification.obj \
+  $(INTDIR)\test_parallel_exporter.obj \
+  $(INTDIR)\test_parallel_largeobject.obj \
+  $(INTDIR)\test_parallel_loader.obj \
   $(INTDIR)\test_parameterized.obj \
+  $(INTDIR)\test_partial_write_error.obj \
   $(INTDIR)\test_pipeline.obj \
   $(INTDIR)\test_prepared_statement.obj \
   $(INTDIR)\test_read_transaction.obj \
+  $(INTDIR)\test_result_cache.obj \
+  $(INTDIR)\test_result_columns.obj \
   $(INTDIR)\test_result_slicing.obj \
+  $(INTDIR)\test_retry_policy.obj \
+  $(INTDIR)\test_robusttransaction.obj \
+  $(INTDIR)\test_row_mapping.obj \
+  $(INTDIR)\test_row_scanner.obj \
   $(INTDIR)\test_simultaneous_transactions.obj \
   $(INTDIR)\test_sql_cursor.obj \
   $(INTDIR)\test_stateless_cursor.obj \
@@ -100,6 +126,7 @@ OBJS= \
   $(INTDIR)\test_subtransaction.obj \
   $(INTDIR)\test_test_helpers.obj \
   $(INTDIR)\test_thread_safety_model.obj \
+  $(INTDIR)\test_unescape_bytea_hex.obj \
   $(INTDIR)\runner.obj
 
 
@@ -134,10 +161,28 @@ $(INTDIR)\runner.exe: $(OBJS) $(DLLS)
 
 $(INTDIR)\runner.obj:
 	@$(CXX) $(CXX_FLAGS) test/unit/runner.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
+$(INTDIR)\test_adaptive_stride.obj:
+	@$(CXX) $(CXX_FLAGS) test/unit/test_adaptive_stride.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
+$(INTDIR)\test_arrow.obj:
+	@$(CXX) $(CXX_FLAGS) test/unit/test_arrow.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
+$(INTDIR)\test_async_query.obj:
+	@$(CXX) $(CXX_FLAGS) test/unit/test_async_query.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
+$(INTDIR)\test_batch_loader.obj:
+	@$(CXX) $(CXX_FLAGS) test/unit/test_batch_loader.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
 $(INTDIR)\test_binarystring.obj:
 	@$(CXX) $(CXX_FLAGS) test/unit/test_binarystring.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
 $(INTDIR)\test_cancel_query.obj:
 	@$(CXX) $(CXX_FLAGS) test/unit/test_cancel_query.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
+$(INTDIR)\test_column.obj:
+	@$(CXX) $(CXX_FLAGS) test/unit/test_column.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
+$(INTDIR)\test_column_lookup.obj:
+	@$(CXX) $(CXX_FLAGS) test/unit/test_column_lookup.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
+$(INTDIR)\test_cursor_block_cache.obj:
+	@$(CXX) $(CXX_FLAGS) test/unit/test_cursor_block_cache.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
+$(INTDIR)\test_cursor_prefetch.obj:
+	@$(CXX) $(CXX_FLAGS) test/unit/test_cursor_prefetch.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
+$(INTDIR)\test_deferred_begin.obj:
+	@$(CXX) $(CXX_FLAGS) test/unit/test_deferred_begin.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
 $(INTDIR)\test_error_verbosity.obj:
 	@$(CXX) $(CXX_FLAGS) test/unit/test_error_verbosity.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
 $(INTDIR)\test_errorhandler.obj:
@@ -146,20 +191,54 @@ $(INTDIR)\test_escape.obj:
 	@$(CXX) $(CXX_FLAGS) test/unit/test_escape.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
 $(INTDIR)\test_exceptions.obj:
 	@$(CXX) $(CXX_FLAGS) test/unit/test_exceptions.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
+$(INTDIR)\test_exec_and_commit.obj:
+	@$(CXX) $(CXX_FLAGS) test/unit/test_exec_and_commit.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
+$(INTDIR)\test_field_view.obj:
+	@$(CXX) $(CXX_FLAGS) test/unit/test_field_view.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
 $(INTDIR)\test_float.obj:
 	@$(CXX) $(CXX_FLAGS) test/unit/test_float.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
+$(INTDIR)\test_largeobject_64.obj:
+	@$(CXX) $(CXX_FLAGS) test/unit/test_largeobject_64.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
+$(INTDIR)\test_largeobject_memory.obj:
+	@$(CXX) $(CXX_FLAGS) test/unit/test_largeobject_memory.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
+$(INTDIR)\test_largeobject_stream.obj:
+	@$(CXX) $(CXX_FLAGS) test/unit/test_largeobject_stream.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
+$(INTDIR)\test_mapped_result.obj:
+	@$(CXX) $(CXX_FLAGS) test/unit/test_mapped_result.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
+$(INTDIR)\test_nonblocking_copy.obj:
+	@$(CXX) $(CXX_FLAGS) test/unit/test_nonblocking_copy.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
 $(INTDIR)\test_notification.obj:
 	@$(CXX) $(CXX_FLAGS) test/unit/test_notification.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
+$(INTDIR)\test_parallel_exporter.obj:
+	@$(CXX) $(CXX_FLAGS) test/unit/test_parallel_exporter.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
+$(INTDIR)\test_parallel_largeobject.obj:
+	@$(CXX) $(CXX_FLAGS) test/unit/test_parallel_largeobject.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
+$(INTDIR)\test_parallel_loader.obj:
+	@$(CXX) $(CXX_FLAGS) test/unit/test_parallel_loader.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
 $(INTDIR)\test_parameterized.obj:
 	@$(CXX) $(CXX_FLAGS) test/unit/test_parameterized.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
+$(INTDIR)\test_partial_write_error.obj:
+	@$(CXX) $(CXX_FLAGS) test/unit/test_partial_write_error.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
 $(INTDIR)\test_pipeline.obj:
 	@$(CXX) $(CXX_FLAGS) test/unit/test_pipeline.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
 $(INTDIR)\test_prepared_statement.obj:
 	@$(CXX) $(CXX_FLAGS) test/unit/test_prepared_statement.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
 $(INTDIR)\test_read_transaction.obj:
 	@$(CXX) $(CXX_FLAGS) test/unit/test_read_transaction.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
+$(INTDIR)\test_result_cache.obj:
+	@$(CXX) $(CXX_FLAGS) test/unit/test_result_cache.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
+$(INTDIR)\test_result_columns.obj:
+	@$(CXX) $(CXX_FLAGS) test/unit/test_result_columns.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
 $(INTDIR)\test_result_slicing.obj:
 	@$(CXX) $(CXX_FLAGS) test/unit/test_result_slicing.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
+$(INTDIR)\test_retry_policy.obj:
+	@$(CXX) $(CXX_FLAGS) test/unit/test_retry_policy.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
+$(INTDIR)\test_robusttransaction.obj:
+	@$(CXX) $(CXX_FLAGS) test/unit/test_robusttransaction.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
+$(INTDIR)\test_row_mapping.obj:
+	@$(CXX) $(CXX_FLAGS) test/unit/test_row_mapping.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
+$(INTDIR)\test_row_scanner.obj:
+	@$(CXX) $(CXX_FLAGS) test/unit/test_row_scanner.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
 $(INTDIR)\test_simultaneous_transactions.obj:
 	@$(CXX) $(CXX_FLAGS) test/unit/test_simultaneous_transactions.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
 $(INTDIR)\test_sql_cursor.obj:
@@ -174,6 +253,8 @@ $(INTDIR)\test_test_helpers.obj:
 	@$(CXX) $(CXX_FLAGS) test/unit/test_test_helpers.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
 $(INTDIR)\test_thread_safety_model.obj:
 	@$(CXX) $(CXX_FLAGS) test/unit/test_thread_safety_model.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
+$(INTDIR)\test_unescape_bytea_hex.obj:
+	@$(CXX) $(CXX_FLAGS) test/unit/test_unescape_bytea_hex.cxx /Fo"$(INTDIR)\\" /Fd"$(INTDIR)\\"
 
 
 $(INTDIR)\$(LIBPQ):